@@ -0,0 +1,530 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "OSystem.hxx"
+#include "Console.hxx"
+#include "AudioQueue.hxx"
+#include "EmulationTiming.hxx"
+#include "FrameBuffer.hxx"
+#include "Props.hxx"
+#include "System.hxx"
+#include "TIA.hxx"
+#include "TIASurface.hxx"
+#include "TIAConstants.hxx"
+#include "AVCapture.hxx"
+
+namespace {
+  constexpr uInt16 VERSION = 2;
+  // The TIA generates an audio sample every 38 CPU cycles
+  constexpr uInt32 CYCLES_PER_SAMPLE = 38;
+  constexpr uInt32 CYCLES_PER_SCANLINE = CYCLES_PER_SAMPLE * 2;
+  constexpr uInt8 PALETTE_CHUNK = 'P', KEY_FRAME_CHUNK = 'K', DELTA_FRAME_CHUNK = 'D';
+  constexpr uInt32 PALETTE_SIZE = 256 * 3;
+
+  void putLE(std::ostream& out, uInt32 value, int bytes)
+  {
+    for(int i = 0; i < bytes; ++i, value >>= 8)
+      out.put(static_cast<char>(value & 0xff));
+  }
+
+  uInt32 getLE(std::istream& in, int bytes)
+  {
+    uInt32 value = 0;
+    for(int i = 0; i < bytes; ++i)
+      value |= static_cast<uInt32>(static_cast<uInt8>(in.get())) << (i * 8);
+    return value;
+  }
+} // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AVCapture::AVCapture(OSystem& osystem)
+  : myOSystem{osystem}
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AVCapture::~AVCapture()
+{
+  stop();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::toggle()
+{
+  if(!myOSystem.hasConsole())
+    return;
+
+  if(!myIsRunning)
+  {
+    start();
+    if(myIsRunning)
+      myOSystem.frameBuffer().showTextMessage("A/V capture started");
+  }
+  else
+  {
+    stop();
+
+    ostringstream buf;
+    if(myWriteError)
+      buf << "ERROR: A/V capture incomplete, couldn't write files";
+    else
+      buf << "A/V capture stopped, " << myFrames << " frames written";
+    myOSystem.frameBuffer().showTextMessage(buf.str());
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::start()
+{
+  Console& console = myOSystem.console();
+
+  // Use the next unused name in the snapshot directory
+#ifdef IMAGE_SUPPORT
+  const FSNode& dir = myOSystem.snapshotSaveDir();
+#else
+  const FSNode& dir = myOSystem.userDir();
+#endif
+  const string path = dir.getPath() +
+      (myOSystem.settings().getString("snapname") != "int"
+        ? myOSystem.romFile().getNameWithExt("")
+        : console.properties().get(PropType::Cart_Name));
+  string basename = path;
+  for(uInt32 i = 1; FSNode(basename + ".tiav").exists(); ++i)
+    basename = path + "_" + std::to_string(i);
+
+  myVideoFile.open(basename + ".tiav", std::ios_base::binary);
+  myAudioFile.open(basename + ".wav", std::ios_base::binary);
+  if(!myVideoFile.is_open() || !myAudioFile.is_open())
+  {
+    myVideoFile.close();
+    myAudioFile.close();
+    myOSystem.frameBuffer().showTextMessage("ERROR: Couldn't create capture files");
+    return;
+  }
+
+  // Use the rates of the emulated console, independent of the emulation
+  // speed (the TIA generates two samples per scanline)
+  mySampleRate = (console.timing() == ConsoleTiming::ntsc
+    ? 262 * 60 : 312 * 50) * CYCLES_PER_SCANLINE / CYCLES_PER_SAMPLE;
+  myVideoFile.write("TIAV", 4);
+  putLE(myVideoFile, VERSION, 2);
+  putLE(myVideoFile, TIAConstants::H_PIXEL, 2);
+  putLE(myVideoFile, mySampleRate * CYCLES_PER_SAMPLE, 4);
+  putLE(myVideoFile, console.emulationTiming().cyclesPerFrame(), 4);
+
+  // The sizes of the WAV file are updated when the capture stops
+  myChannels = console.audioQueue().isStereo() ? 2 : 1;
+  myAudioBytes = 0;
+  writeWavHeader();
+
+  myLastFrame.clear();
+  myFramesSinceKey = 0;
+  myFrames = 0;
+  myWriteError = false;
+  myStopThread = false;
+  myThread = std::thread([this] { writeThread(); });
+  myIsRunning = true;
+  myStartCycles = console.system().cycles();
+  myFirstFrame = myFirstFragment = true;
+
+  setPalette(myOSystem.frameBuffer().tiaSurface().rgbPalette());
+
+  // From now on, the emulation passes all frames and audio fragments
+  console.tia().setFrameCallback([this](const uInt8* frame, uInt32 lines) {
+    addFrame(frame, lines);
+  });
+  console.audioQueue().setFragmentCallback([this](const Int16* samples, uInt32 size) {
+    addAudio(samples, size);
+  });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::stop()
+{
+  if(!myIsRunning)
+    return;
+
+  if(myOSystem.hasConsole())
+  {
+    myOSystem.console().tia().setFrameCallback(nullptr);
+    myOSystem.console().audioQueue().setFragmentCallback(nullptr);
+  }
+
+  // The writer thread writes all queued data before it stops
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+    myStopThread = true;
+  }
+  myChunkCondition.notify_all();
+  myThread.join();
+
+  writeWavHeader();
+  myWriteError = myWriteError || !myVideoFile.good() || !myAudioFile.good();
+  myVideoFile.close();
+  myAudioFile.close();
+
+  myPool.clear();
+  myLastFrame.clear();
+  myIsRunning = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::setPalette(const PaletteArray& palette)
+{
+  if(!myIsRunning)
+    return;
+
+  Chunk chunk = acquireChunk();
+  chunk.type = Chunk::Type::Palette;
+  chunk.data.resize(PALETTE_SIZE);
+  for(size_t i = 0; i < palette.size(); ++i)
+  {
+    chunk.data[i * 3 + 0] = (palette[i] >> 16) & 0xff;
+    chunk.data[i * 3 + 1] = (palette[i] >> 8) & 0xff;
+    chunk.data[i * 3 + 2] =  palette[i] & 0xff;
+  }
+  queueChunk(std::move(chunk));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::addFrame(const uInt8* frame, uInt32 lines)
+{
+  // The first frame only lasts from the start of the capture
+  uInt32 scanlines = myOSystem.console().tia().scanlinesLastFrame();
+  if(myFirstFrame)
+  {
+    scanlines = static_cast<uInt32>(std::min<uInt64>(scanlines,
+        cyclesSinceStart() / CYCLES_PER_SCANLINE));
+    myFirstFrame = false;
+  }
+
+  Chunk chunk = acquireChunk();
+  chunk.type = Chunk::Type::Frame;
+  chunk.lines = lines;
+  chunk.scanlines = scanlines;
+  chunk.data.assign(frame, frame + static_cast<size_t>(lines) * TIAConstants::H_PIXEL);
+  queueChunk(std::move(chunk));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::addAudio(const Int16* samples, uInt32 size)
+{
+  // Drop the samples of the first fragment which were generated before the
+  // capture started (the fragment is complete with its last sample)
+  uInt32 skip = 0;
+  if(myFirstFragment)
+  {
+    const uInt64 newSamples = cyclesSinceStart() / CYCLES_PER_SAMPLE;
+    const uInt32 samplesPerChannel = size / myChannels;
+    if(newSamples < samplesPerChannel)
+      skip = (samplesPerChannel - static_cast<uInt32>(newSamples)) * myChannels;
+    myFirstFragment = false;
+  }
+
+  Chunk chunk = acquireChunk();
+  chunk.type = Chunk::Type::Audio;
+  chunk.samples.assign(samples + skip, samples + size);
+  queueChunk(std::move(chunk));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 AVCapture::cyclesSinceStart() const
+{
+  // Loading a state may move the cycles back
+  const uInt64 cycles = myOSystem.console().system().cycles();
+  return cycles > myStartCycles ? cycles - myStartCycles : 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AVCapture::Chunk AVCapture::acquireChunk()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  mySpaceCondition.wait(lock, [this] { return myChunks.size() < MAX_QUEUED_CHUNKS; });
+  if(myPool.empty())
+    return {};
+
+  Chunk chunk = std::move(myPool.back());
+  myPool.pop_back();
+  return chunk;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::queueChunk(Chunk&& chunk)
+{
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+    myChunks.push_back(std::move(chunk));
+  }
+  myChunkCondition.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::writeThread()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+  for(;;)
+  {
+    myChunkCondition.wait(lock, [this] { return myStopThread || !myChunks.empty(); });
+    if(myChunks.empty())
+      break;  // stopped, and all data is written
+
+    Chunk chunk = std::move(myChunks.front());
+    myChunks.pop_front();
+    lock.unlock();
+
+    switch(chunk.type)
+    {
+      case Chunk::Type::Palette:
+        myVideoFile.put(static_cast<char>(PALETTE_CHUNK));
+        putLE(myVideoFile, PALETTE_SIZE, 4);
+        myVideoFile.write(reinterpret_cast<const char*>(chunk.data.data()), PALETTE_SIZE);
+        break;
+
+      case Chunk::Type::Frame:
+        writeFrame(chunk);
+        break;
+
+      case Chunk::Type::Audio:
+        writeAudio(chunk);
+        break;
+    }
+
+    lock.lock();
+    if(myPool.size() < MAX_QUEUED_CHUNKS)
+      myPool.push_back(std::move(chunk));
+    mySpaceCondition.notify_all();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::writeFrame(const Chunk& chunk)
+{
+  const size_t size = chunk.data.size();
+
+  // A frame is written as the difference to the previous frame, unless the
+  // size changed or a key frame is due
+  const bool keyFrame = myLastFrame.size() != size ||
+                        myFramesSinceKey >= KEY_FRAME_INTERVAL;
+  if(keyFrame)
+  {
+    encodeRLE(chunk.data.data(), size, myEncoded);
+    myFramesSinceKey = 0;
+  }
+  else
+  {
+    myBytes.resize(size);
+    for(size_t i = 0; i < size; ++i)
+      myBytes[i] = chunk.data[i] ^ myLastFrame[i];
+    encodeRLE(myBytes.data(), size, myEncoded);
+  }
+  myLastFrame.assign(chunk.data.begin(), chunk.data.end());
+  ++myFramesSinceKey;
+  ++myFrames;
+
+  myVideoFile.put(static_cast<char>(keyFrame ? KEY_FRAME_CHUNK : DELTA_FRAME_CHUNK));
+  putLE(myVideoFile, static_cast<uInt32>(4 + myEncoded.size()), 4);
+  putLE(myVideoFile, chunk.lines, 2);
+  putLE(myVideoFile, chunk.scanlines, 2);
+  myVideoFile.write(reinterpret_cast<const char*>(myEncoded.data()),
+                    static_cast<std::streamsize>(myEncoded.size()));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::writeAudio(const Chunk& chunk)
+{
+  // WAV files are little endian
+  myBytes.resize(chunk.samples.size() * 2);
+  for(size_t i = 0; i < chunk.samples.size(); ++i)
+  {
+    const auto sample = static_cast<uInt16>(chunk.samples[i]);
+    myBytes[i * 2 + 0] = sample & 0xff;
+    myBytes[i * 2 + 1] = sample >> 8;
+  }
+  myAudioFile.write(reinterpret_cast<const char*>(myBytes.data()),
+                    static_cast<std::streamsize>(myBytes.size()));
+  myAudioBytes += static_cast<uInt32>(myBytes.size());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::writeWavHeader()
+{
+  myAudioFile.seekp(0);
+  myAudioFile.write("RIFF", 4);
+  putLE(myAudioFile, 36 + myAudioBytes, 4);
+  myAudioFile.write("WAVEfmt ", 8);
+  putLE(myAudioFile, 16, 4);                           // size of format data
+  putLE(myAudioFile, 1, 2);                            // PCM
+  putLE(myAudioFile, myChannels, 2);
+  putLE(myAudioFile, mySampleRate, 4);
+  putLE(myAudioFile, mySampleRate * myChannels * 2, 4);  // bytes per second
+  putLE(myAudioFile, myChannels * 2, 2);               // bytes per sample
+  putLE(myAudioFile, 16, 2);                           // bits per sample
+  myAudioFile.write("data", 4);
+  putLE(myAudioFile, myAudioBytes, 4);
+  myAudioFile.seekp(0, std::ios_base::end);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::encodeRLE(const uInt8* data, size_t size, vector<uInt8>& out)
+{
+  out.clear();
+  for(size_t i = 0; i < size; )
+  {
+    const uInt8 value = data[i];
+    size_t count = 1;
+    while(count < 255 && i + count < size && data[i + count] == value)
+      ++count;
+
+    out.push_back(static_cast<uInt8>(count));
+    out.push_back(value);
+    i += count;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool AVCapture::decodeRLE(const vector<uInt8>& in, size_t offset,
+                          uInt8* data, size_t size)
+{
+  size_t pos = 0;
+  for(size_t i = offset; i + 1 < in.size(); i += 2)
+  {
+    const size_t count = in[i];
+    if(pos + count > size)
+      return false;
+
+    std::fill_n(data + pos, count, in[i + 1]);
+    pos += count;
+  }
+  return pos == size;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AVCapture::exportY4M(const string& filename, const string& y4mFilename)
+{
+  std::ifstream in(filename, std::ios_base::binary);
+  if(!in.is_open())
+    throw runtime_error("ERROR: Couldn't open capture file");
+
+  char magic[4]{};
+  in.read(magic, 4);
+  if(!in || string(magic, 4) != "TIAV" || getLE(in, 2) != VERSION)
+    throw runtime_error("ERROR: Not a valid capture file");
+  const uInt32 width = getLE(in, 2);
+  const uInt32 rateNum = getLE(in, 4);
+  const uInt32 rateDen = getLE(in, 4);
+  if(!in || rateNum == 0 || rateDen == 0)
+    throw runtime_error("ERROR: Not a valid capture file");
+  const std::streampos chunks = in.tellg();
+
+  // Y4M requires a fixed frame size, so find the largest frame first
+  uInt32 height = 0;
+  for(;;)
+  {
+    const int type = in.get();
+    const uInt32 size = getLE(in, 4);
+    if(!in)
+      break;
+    if(type == KEY_FRAME_CHUNK || type == DELTA_FRAME_CHUNK)
+    {
+      height = std::max(height, getLE(in, 2));
+      in.seekg(static_cast<std::streamoff>(size) - 2, std::ios_base::cur);
+    }
+    else
+      in.seekg(size, std::ios_base::cur);
+  }
+  if(width == 0 || height == 0)
+    throw runtime_error("ERROR: Capture file contains no frames");
+
+  std::ofstream out(y4mFilename, std::ios_base::binary);
+  if(!out.is_open())
+    throw runtime_error("ERROR: Couldn't create Y4M file");
+  // The TIA pixels are displayed twice as wide as high
+  out << "YUV4MPEG2 W" << width << " H" << height << " F" << rateNum << ":"
+      << rateDen << " Ip A2:1 C444\n";
+
+  // The palette converted into YUV (BT.601, limited range)
+  std::array<uInt8, 256> y{}, u{}, v{};
+  y.fill(16);  u.fill(128);  v.fill(128);
+
+  // Y4M requires a constant frame rate, so each output frame shows the frame
+  // emulated at its start time, which keeps the video in sync with the audio
+  uInt64 frameEnd = 0, outputTime = 0;  // in CPU cycles
+
+  const size_t planeSize = static_cast<size_t>(width) * height;
+  vector<uInt8> data, frame, previous, yuv(planeSize * 3);
+  in.clear();
+  in.seekg(chunks);
+  for(;;)
+  {
+    const int type = in.get();
+    const uInt32 size = getLE(in, 4);
+    if(!in)
+      break;
+    data.resize(size);
+    in.read(reinterpret_cast<char*>(data.data()), size);
+    if(!in)
+      throw runtime_error("ERROR: Capture file is truncated");
+
+    if(type == PALETTE_CHUNK && size == PALETTE_SIZE)
+    {
+      for(size_t i = 0; i < 256; ++i)
+      {
+        const int r = data[i * 3], g = data[i * 3 + 1], b = data[i * 3 + 2];
+        y[i] = static_cast<uInt8>(16  + ((  66 * r + 129 * g +  25 * b + 128) >> 8));
+        u[i] = static_cast<uInt8>(128 + (( -38 * r -  74 * g + 112 * b + 128) >> 8));
+        v[i] = static_cast<uInt8>(128 + (( 112 * r -  94 * g -  18 * b + 128) >> 8));
+      }
+    }
+    else if((type == KEY_FRAME_CHUNK || type == DELTA_FRAME_CHUNK) && size >= 4)
+    {
+      const uInt32 lines = data[0] | (data[1] << 8);
+      const uInt32 scanlines = data[2] | (data[3] << 8);
+      frame.resize(static_cast<size_t>(width) * lines);
+      if(!decodeRLE(data, 4, frame.data(), frame.size()) ||
+         (type == DELTA_FRAME_CHUNK && previous.size() != frame.size()))
+        throw runtime_error("ERROR: Capture file is corrupt");
+      if(type == DELTA_FRAME_CHUNK)
+        for(size_t i = 0; i < frame.size(); ++i)
+          frame[i] ^= previous[i];
+      previous = frame;
+
+      frameEnd += static_cast<uInt64>(scanlines) * CYCLES_PER_SCANLINE;
+      if(outputTime >= frameEnd)
+        continue;  // dropped
+
+      // Create the Y, U and V planes, padding the frame with black
+      auto plane = yuv.begin();
+      for(const auto* table: {&y, &u, &v})
+      {
+        for(size_t i = 0; i < frame.size(); ++i)
+          plane[i] = (*table)[frame[i]];
+        std::fill(plane + frame.size(), plane + planeSize,
+                  table == &y ? uInt8{16} : uInt8{128});
+        plane += planeSize;
+      }
+      for(; outputTime < frameEnd; outputTime += rateDen)
+      {
+        out << "FRAME\n";
+        out.write(reinterpret_cast<const char*>(yuv.data()),
+                  static_cast<std::streamsize>(yuv.size()));
+      }
+    }
+  }
+  if(!out.good())
+    throw runtime_error("ERROR: Couldn't write Y4M file");
+}
@@ -0,0 +1,209 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef AV_CAPTURE_HXX
+#define AV_CAPTURE_HXX
+
+class OSystem;
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include "FrameBufferConstants.hxx"
+#include "bspf.hxx"
+
+/**
+  This class records the emulation output without any post-processing.
+
+  The palette indices of each frame completed by the TIA and the audio
+  fragments pushed to the audio queue are copied on the emulation thread,
+  and written by a background thread.  The video is stored in a compact
+  format ('.tiav'), consisting of the palette and run-length encoded frames,
+  most of them encoded as the difference to the previous frame.  The audio
+  is stored in a '.wav' file.
+
+  The video file format (all values little endian):
+    header:  "TIAV", version (uInt16), width (uInt16),
+             nominal frame rate numerator and denominator (uInt32 each)
+    chunks:  type (uInt8), size of the data (uInt32), data
+      'P'    the RGB values of the 256 palette entries
+      'K'    key frame: scanlines shown (uInt16), duration in scanlines
+             (uInt16), RLE data of the palette indices
+      'D'    delta frame: like a key frame, but the palette indices are
+             XORed with the previous frame
+    RLE data consists of (count, value) byte pairs.
+
+  All frames are recorded, so a capture is frame-accurate.  Since the TIA
+  generates two audio samples per scanline, the duration of each frame
+  keeps the video in sync with the audio, even if the frames differ from
+  the nominal frame length.  The audio starts with the capture, and so
+  does the duration of the first frame.  Use exportY4M() to convert a
+  video file for further processing.
+*/
+class AVCapture
+{
+  public:
+    explicit AVCapture(OSystem& osystem);
+    ~AVCapture();
+
+    /**
+      Start or stop capturing the output of the current console.
+    */
+    void toggle();
+
+    /**
+      Answer whether the output is currently being captured.
+    */
+    bool isRunning() const { return myIsRunning; }
+
+    /**
+      Stop capturing, after all captured data has been written.
+    */
+    void stop();
+
+    /**
+      Record a change of the TIA palette.
+
+      @param palette  The RGB values of the new palette
+    */
+    void setPalette(const PaletteArray& palette);
+
+    /**
+      Convert a captured video file into a YUV4MPEG2 (Y4M) file.  Frames
+      with less scanlines than the largest frame are padded with black.
+      Since Y4M uses a constant frame rate, frames are repeated or dropped
+      to keep the nominal frame rate in sync with the audio.
+
+      @param filename     The captured video file
+      @param y4mFilename  The Y4M file to create
+
+      @post  On failure, a runtime_error is thrown containing a more
+             detailed error message.
+    */
+    static void exportY4M(const string& filename, const string& y4mFilename);
+
+  private:
+    // The data passed from the emulation to the writer thread
+    struct Chunk
+    {
+      enum class Type: uInt8 { Palette, Frame, Audio };
+
+      Type type{Type::Frame};
+      uInt32 lines{0};
+      uInt32 scanlines{0};  // the duration of a frame
+      vector<uInt8> data;
+      vector<Int16> samples;
+    };
+
+    /**
+      Start capturing into new files, named after the current ROM.
+    */
+    void start();
+
+    /**
+      Copy a completed frame (called on the emulation thread).
+    */
+    void addFrame(const uInt8* frame, uInt32 lines);
+
+    /**
+      Copy an audio fragment (called on the emulation thread).
+    */
+    void addAudio(const Int16* samples, uInt32 size);
+
+    /**
+      Answer the CPU cycles emulated since the capture started.
+    */
+    uInt64 cyclesSinceStart() const;
+
+    /**
+      Get an unused chunk from the pool, waiting while the writer thread
+      is too far behind.
+    */
+    Chunk acquireChunk();
+
+    /**
+      Queue a chunk for the writer thread.
+    */
+    void queueChunk(Chunk&& chunk);
+
+    /**
+      The background thread writing the captured data.
+    */
+    void writeThread();
+
+    void writeFrame(const Chunk& chunk);
+    void writeAudio(const Chunk& chunk);
+    void writeWavHeader();
+
+    /**
+      Run-length encode/decode the given data as (count, value) pairs.
+    */
+    static void encodeRLE(const uInt8* data, size_t size, vector<uInt8>& out);
+    static bool decodeRLE(const vector<uInt8>& in, size_t offset,
+                          uInt8* data, size_t size);
+
+  private:
+    // The maximum number of chunks waiting to be written; the emulation
+    // waits for the writer instead of dropping data
+    static constexpr size_t MAX_QUEUED_CHUNKS = 512;
+    // Every n-th frame is written as a key frame
+    static constexpr uInt32 KEY_FRAME_INTERVAL = 300;
+
+    OSystem& myOSystem;
+
+    bool myIsRunning{false};
+
+    // The following is only used by the emulation thread
+    uInt64 myStartCycles{0};
+    bool myFirstFrame{false};
+    bool myFirstFragment{false};
+
+    // The following is shared with the writer thread
+    std::deque<Chunk> myChunks;
+    vector<Chunk> myPool;
+    std::thread myThread;
+    std::mutex myMutex;
+    std::condition_variable myChunkCondition;
+    std::condition_variable mySpaceCondition;
+    bool myStopThread{false};
+
+    // The following is only used by the writer thread (and after it stopped)
+    std::ofstream myVideoFile;
+    std::ofstream myAudioFile;
+    vector<uInt8> myLastFrame;
+    vector<uInt8> myEncoded;
+    vector<uInt8> myBytes;
+    uInt32 myFramesSinceKey{0};
+    uInt32 myFrames{0};
+    uInt32 myAudioBytes{0};
+    uInt32 mySampleRate{0};
+    uInt16 myChannels{0};
+    bool myWriteError{false};
+
+  private:
+    // Following constructors and assignment operators not supported
+    AVCapture() = delete;
+    AVCapture(const AVCapture&) = delete;
+    AVCapture(AVCapture&&) = delete;
+    AVCapture& operator=(const AVCapture&) = delete;
+    AVCapture& operator=(AVCapture&&) = delete;
+};
+
+#endif
@@ -74,6 +74,9 @@ uInt32 AudioQueue::fragmentSize() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Int16* AudioQueue::enqueue(Int16* fragment)
 {
+  if (fragment && myFragmentCallback)
+    myFragmentCallback(fragment, myFragmentSize * (myIsStereo ? 2 : 1));
+
   const lock_guard<mutex> guard(myMutex);
 
   Int16* newFragment = nullptr;
@@ -142,3 +145,15 @@ void AudioQueue::ignoreOverflows(bool shouldIgnoreOverflows)
 {
   myIgnoreOverflows = shouldIgnoreOverflows;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioQueue::setFragmentCallback(const FragmentCallback& callback)
+{
+  myFragmentCallback = callback;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const AudioQueue::FragmentCallback& AudioQueue::fragmentCallback() const
+{
+  return myFragmentCallback;
+}
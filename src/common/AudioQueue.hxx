@@ -18,6 +18,7 @@
 #ifndef AUDIO_QUEUE_HXX
 #define AUDIO_QUEUE_HXX
 
+#include <functional>
 #include <mutex>
 
 #include "bspf.hxx"
@@ -38,6 +39,8 @@ class AudioQueue
 {
   public:
 
+    using FragmentCallback = std::function<void(const Int16*, uInt32)>;
+
     /**
        Create a new AudioQueue.
 
@@ -96,6 +99,18 @@ class AudioQueue
      */
     void ignoreOverflows(bool shouldIgnoreOverflows);
 
+    /**
+      Set a callback which receives each enqueued fragment and its size (in
+      samples, both channels counted).  The callback is called from the
+      emulation thread.
+     */
+    void setFragmentCallback(const FragmentCallback& callback);
+
+    /**
+      Fragment callback getter.
+     */
+    const FragmentCallback& fragmentCallback() const;
+
   private:
 
     // The size of an individual fragment (in stereo / mono samples)
@@ -132,6 +147,9 @@ class AudioQueue
 
     StaggeredLogger myOverflowLogger{"audio buffer overflow", Logger::Level::INFO};
 
+    // Receives the enqueued fragments, if set
+    FragmentCallback myFragmentCallback;
+
   private:
 
     AudioQueue() = delete;
@@ -184,6 +184,7 @@ void DevSettingsHandler::applySettings(SettingsSet set)
   if(myOSystem.hasConsole())
   {
     myOSystem.console().system().m6502().setReadFromWritePortBreak(myRWPortBreak[set]);
+    myOSystem.console().cartridge().enableRWPDetection(myRWPortBreak[set]);
     myOSystem.console().system().m6502().setWriteToReadPortBreak(myWRPortBreak[set]);
   }
 #endif
@@ -17,13 +17,58 @@
 
 #if defined(ZIP_SUPPORT)
 
+#include <mutex>
 #include <set>
 
 #include "bspf.hxx"
 #include "Bankswitch.hxx"
 #include "FSNodeFactory.hxx"
+#include "ZipHandler.hxx"
 #include "FSNodeZIP.hxx"
 
+namespace {
+  /**
+    A ZipHandler borrowed from a pool of handlers for the lifetime of this
+    object.  Since a ZipHandler is not thread-safe, this allows accessing
+    ZIP files from several threads in parallel.
+  */
+  class PooledZipHandler
+  {
+    public:
+      PooledZipHandler()
+      {
+        const std::lock_guard<std::mutex> lock(ourMutex);
+        if(!ourHandlers.empty())
+        {
+          myHandler = std::move(ourHandlers.back());
+          ourHandlers.pop_back();
+        }
+        else
+          myHandler = make_unique<ZipHandler>();
+      }
+      ~PooledZipHandler()
+      {
+        const std::lock_guard<std::mutex> lock(ourMutex);
+        ourHandlers.push_back(std::move(myHandler));
+      }
+
+      ZipHandler* operator->() const { return myHandler.get(); }
+
+    private:
+      unique_ptr<ZipHandler> myHandler;
+
+      inline static std::mutex ourMutex;
+      inline static vector<unique_ptr<ZipHandler>> ourHandlers;
+
+    private:
+      // Following constructors and assignment operators not supported
+      PooledZipHandler(const PooledZipHandler&) = delete;
+      PooledZipHandler(PooledZipHandler&&) = delete;
+      PooledZipHandler& operator=(const PooledZipHandler&) = delete;
+      PooledZipHandler& operator=(PooledZipHandler&&) = delete;
+  };
+} // namespace
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 FSNodeZIP::FSNodeZIP(string_view p)
 {
@@ -48,10 +93,19 @@ FSNodeZIP::FSNodeZIP(string_view p)
 
 // cerr << " => p: " << p << '\n';
 
+  // Create a concrete FSNode to use
+  // This *must not* be a ZIP file; it must be a real FSNode object that
+  // has direct access to the actual filesystem (aka, a 'System' node)
+  // Behind the scenes, this node is actually a platform-specific object
+  // for whatever system we are running on
+  const AbstractFSNodePtr realNode = FSNodeFactory::create(_zipFile,
+      FSNodeFactory::Type::SYSTEM);
+
   // Open file at least once to initialize the virtual file count
+  const PooledZipHandler zipHandler;
   try
   {
-    myZipHandler->open(_zipFile);
+    zipHandler->open(_zipFile, realNode->getModificationTime());
   }
   catch(const runtime_error&)
   {
@@ -59,7 +113,7 @@ FSNodeZIP::FSNodeZIP(string_view p)
     //       For now, we just indicate that no ROMs were found
     _error = zip_error::NO_ROMS;
   }
-  _numFiles = myZipHandler->romFiles();
+  _numFiles = zipHandler->romFiles();
   if(_numFiles == 0)
   {
     _error = zip_error::NO_ROMS;
@@ -76,9 +130,9 @@ FSNodeZIP::FSNodeZIP(string_view p)
   else if(_numFiles == 1)
   {
     bool found = false;
-    while(myZipHandler->hasNext() && !found)
+    while(zipHandler->hasNext() && !found)
     {
-      const auto& [name, size] = myZipHandler->next();
+      const auto& [name, size] = zipHandler->next();
       if(Bankswitch::isValidRomName(name))
       {
         _virtualPath = name;
@@ -94,13 +148,7 @@ FSNodeZIP::FSNodeZIP(string_view p)
   else if(_numFiles > 1)
     _isDirectory = true;
 
-  // Create a concrete FSNode to use
-  // This *must not* be a ZIP file; it must be a real FSNode object that
-  // has direct access to the actual filesystem (aka, a 'System' node)
-  // Behind the scenes, this node is actually a platform-specific object
-  // for whatever system we are running on
-  _realNode = FSNodeFactory::create(_zipFile,
-      FSNodeFactory::Type::SYSTEM);
+  _realNode = realNode;
 
   setFlags(_zipFile, _virtualPath, _realNode);
 // cerr << "==============================================================\n";
@@ -151,10 +199,14 @@ bool FSNodeZIP::exists() const
     // We need to inspect the actual path, not just the ZIP file itself
     try
     {
-      myZipHandler->open(_zipFile);
-      while(myZipHandler->hasNext())
+      const PooledZipHandler zipHandler;
+      zipHandler->open(_zipFile, getModificationTime());
+      if(zipHandler->find(_virtualPath))
+        return true;
+
+      while(zipHandler->hasNext())
       {
-        const auto& [name, size] = myZipHandler->next();
+        const auto& [name, size] = zipHandler->next();
         if(BSPF::startsWithIgnoreCase(name, _virtualPath))
           return true;
       }
@@ -177,12 +229,13 @@ bool FSNodeZIP::getChildren(AbstractFSList& myList, ListMode mode) const
     return false;
 
   std::set<string> dirs;
-  myZipHandler->open(_zipFile);
-  while(myZipHandler->hasNext())
+  const PooledZipHandler zipHandler;
+  zipHandler->open(_zipFile, getModificationTime());
+  while(zipHandler->hasNext())
   {
     // Only consider entries that start with '_virtualPath'
     // Ignore empty filenames and '__MACOSX' virtual directories
-    const auto& [name, size] = myZipHandler->next();
+    const auto& [name, size] = zipHandler->next();
     if(BSPF::startsWithIgnoreCase(name, "__MACOSX") || name == EmptyString)
       continue;
     if(BSPF::startsWithIgnoreCase(name, _virtualPath))
@@ -220,16 +273,10 @@ size_t FSNodeZIP::read(ByteBuffer& buffer, size_t) const
     case zip_error::NO_ROMS:      throw runtime_error("ZIP file doesn't contain any ROMs");
   }
 
-  myZipHandler->open(_zipFile);
+  const PooledZipHandler zipHandler;
+  zipHandler->open(_zipFile, getModificationTime());
 
-  bool found = false;
-  while(myZipHandler->hasNext() && !found)
-  {
-    const auto& [name, size] = myZipHandler->next();
-    found = name == _virtualPath;
-  }
-
-  return found ? myZipHandler->decompress(buffer) : 0;
+  return zipHandler->find(_virtualPath) ? zipHandler->decompress(buffer) : 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -280,7 +327,4 @@ AbstractFSNodePtr FSNodeZIP::getParent() const
   return make_unique<FSNodeZIP>(STEM_FOR_ZIP(_path));
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-unique_ptr<ZipHandler> FSNodeZIP::myZipHandler = make_unique<ZipHandler>();
-
 #endif  // ZIP_SUPPORT
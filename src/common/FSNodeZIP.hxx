@@ -20,7 +20,6 @@
 #ifndef FS_NODE_ZIP_HXX
 #define FS_NODE_ZIP_HXX
 
-#include "ZipHandler.hxx"
 #include "FSNode.hxx"
 
 /*
@@ -60,6 +59,9 @@ class FSNodeZIP : public AbstractFSNode
     //////////////////////////////////////////////////////////
 
     size_t getSize() const override { return _size; }
+    uInt64 getModificationTime() const override {
+      return _realNode ? _realNode->getModificationTime() : 0;
+    }
     bool getChildren(AbstractFSList& list, ListMode mode) const override;
     AbstractFSNodePtr getParent() const override;
 
@@ -107,9 +109,6 @@ class FSNodeZIP : public AbstractFSNode
     size_t _size{0};
 
     bool _isDirectory{false}, _isFile{false};
-
-    // ZipHandler static reference variable responsible for accessing ZIP files
-    static unique_ptr<ZipHandler> myZipHandler;
 };
 
 #endif
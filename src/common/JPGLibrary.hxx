@@ -20,6 +20,8 @@
 #ifndef JPG_LIBRARY_HXX
 #define JPG_LIBRARY_HXX
 
+#include <mutex>
+
 class OSystem;
 class FBSurface;
 
@@ -49,6 +51,23 @@ class JPGLibrary
     void loadImage(const string& filename, FBSurface& surface,
                    VariantList& metaData);
 
+    /**
+      Read a JPG image from the specified file into a buffer of pixels,
+      already mapped to the framebuffer format.  Unlike loadImage(), this
+      method may be called from any thread.
+
+      @param filename  The filename to load the JPG image
+      @param pixels    The buffer receiving the pixels, row by row
+      @param width     Receives the width of the image
+      @param height    Receives the height of the image
+      @param metaData  The meta data of the JPG image
+
+      @post  On failure, a runtime_error is thrown containing a more
+             detailed error message.
+    */
+    void decodeImage(const string& filename, vector<uInt32>& pixels,
+                     uInt32& width, uInt32& height, VariantList& metaData);
+
   private:
     // Global OSystem object
     OSystem& myOSystem;
@@ -62,6 +81,18 @@ class JPGLibrary
     ReadInfoType myReadInfo;
     static std::vector<char> myFileBuffer;
 
+    // The JPG decoder keeps its state globally, so only one image can be
+    // decoded at a time
+    static std::mutex ourMutex;
+
+    /**
+      Read and decode a JPG image from the specified file into 'ReadInfo'.
+      Must be called with the mutex locked.
+
+      @param filename  The filename to load the JPG image
+    */
+    void readImage(const string& filename);
+
     /**
       Load the JPG data from 'ReadInfo' into the FBSurface.  The surface
       is resized as necessary to accommodate the data.
@@ -70,6 +101,14 @@ class JPGLibrary
     */
     void loadImagetoSurface(FBSurface& surface);
 
+    /**
+      Convert the JPG data from 'ReadInfo' into pixels.
+
+      @param buffer  The pixel buffer to write to
+      @param pitch   The pitch of the pixel buffer (in pixels)
+    */
+    void convertPixels(uInt32* buffer, uInt32 pitch) const;
+
     /**
       Read EXIF meta data chunks from the image.
 
@@ -0,0 +1,146 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#if defined(__unix__) || defined(__APPLE__)
+  #define MAPPED_FILE_SUPPORT
+  #include <cerrno>
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include "MappedFile.hxx"
+
+#ifdef MAPPED_FILE_SUPPORT
+namespace {
+  size_t pageSize()
+  {
+    static const auto size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+  }
+} // namespace
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MappedFile::open(const string& path)
+{
+  close();
+
+#ifdef MAPPED_FILE_SUPPORT
+  myFd = ::open(path.c_str(), O_RDONLY);
+  if(myFd < 0)
+    return false;
+
+  struct stat st{};
+  if(fstat(myFd, &st) != 0 || !S_ISREG(st.st_mode))
+  {
+    close();
+    return false;
+  }
+  mySize = static_cast<size_t>(st.st_size);
+
+  void* data = mySize > 0
+    ? mmap(nullptr, mySize, PROT_READ, MAP_PRIVATE, myFd, 0) : MAP_FAILED;
+  if(data == MAP_FAILED)  // NOLINT (performance-no-int-to-ptr)
+  {
+    close();
+    return false;
+  }
+  myData = static_cast<const uInt8*>(data);
+#endif
+
+  return isValid();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MappedFile::close()
+{
+#ifdef MAPPED_FILE_SUPPORT
+  if(myData)
+    munmap(const_cast<uInt8*>(myData), mySize);
+  if(myFd >= 0)
+    ::close(myFd);
+#endif
+  myFd = -1;
+  myData = nullptr;
+  mySize = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MappedFile::advise(Access access) const
+{
+#ifdef MAPPED_FILE_SUPPORT
+  if(!myData)
+    return;
+
+  int advice = MADV_NORMAL;
+  switch(access)
+  {
+    case Access::Sequential: advice = MADV_SEQUENTIAL; break;
+    case Access::Random:     advice = MADV_RANDOM;     break;
+    default:                 break;
+  }
+  madvise(const_cast<uInt8*>(myData), mySize, advice);
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MappedFile::willNeed(size_t offset, size_t size) const
+{
+#ifdef MAPPED_FILE_SUPPORT
+  if(offset >= mySize)
+    return;
+  size = std::min(size, mySize - offset);
+
+  // madvise requires a page aligned address
+  const size_t start = offset & ~(pageSize() - 1);
+  madvise(const_cast<uInt8*>(myData + start), size + offset - start,
+          MADV_WILLNEED);
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t MappedFile::read(size_t offset, uInt8* buffer, size_t size) const
+{
+  size_t actual = 0;
+
+#ifdef MAPPED_FILE_SUPPORT
+  if(offset >= mySize)
+    return 0;
+  size = std::min(size, mySize - offset);
+
+  while(actual < size)
+  {
+    const ssize_t result = pread(myFd, buffer + actual, size - actual,
+                                 static_cast<off_t>(offset + actual));
+    if(result > 0)
+      actual += static_cast<size_t>(result);
+    else if(result == 0 || errno != EINTR)
+      break;
+  }
+#endif
+
+  return actual;
+}
@@ -0,0 +1,98 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef MAPPED_FILE_HXX
+#define MAPPED_FILE_HXX
+
+#include "bspf.hxx"
+
+/**
+  This class maps a file read-only into memory, so that the OS can be told
+  about the expected accesses, and page in upcoming data ahead of time.
+
+  The mapping is only used for these hints; the data itself is always read
+  with pread().  An I/O error (e.g. on network or removable storage, or for
+  a file truncated by another process) then fails the read, instead of
+  raising SIGBUS when the mapped memory is accessed.  Since the file
+  position isn't used, several threads can read the file in parallel.
+
+  Memory mapping is currently only supported on POSIX systems; elsewhere
+  (or when mapping fails), open() returns false and the caller must fall
+  back to reading the file.
+*/
+class MappedFile
+{
+  public:
+    // Expected access pattern, allows the OS to optimize paging
+    enum class Access: uInt8 {
+      Normal,
+      Sequential,
+      Random
+    };
+
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    /**
+      Open the given file and map it into memory.
+
+      @return  False on any errors, else true
+    */
+    bool open(const string& path);
+
+    /**
+      Unmap and close the currently open file (if any).
+    */
+    void close();
+
+    /**
+      Inform the OS about the expected access pattern of the whole file.
+    */
+    void advise(Access access) const;
+
+    /**
+      Ask the OS to page in the given range asynchronously.
+    */
+    void willNeed(size_t offset, size_t size) const;
+
+    /**
+      Read the given range into the buffer, blocking until it is available.
+
+      @return  The number of bytes read, less than requested at the end of
+               the file or on any errors
+    */
+    size_t read(size_t offset, uInt8* buffer, size_t size) const;
+
+    size_t size() const { return mySize; }
+    bool isValid() const { return myData != nullptr; }
+
+  private:
+    int myFd{-1};
+    const uInt8* myData{nullptr};  // the mapping, only used for hints
+    size_t mySize{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+};
+
+#endif
@@ -32,9 +32,47 @@ PNGLibrary::PNGLibrary(OSystem& osystem)
 {
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+PNGLibrary::~PNGLibrary()
+{
+  // The encoder threads write all queued snapshots before they stop
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+    myStopThreads = true;
+  }
+  myJobCondition.notify_all();
+  for(auto& thread: myThreads)
+    thread.join();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PNGLibrary::loadImage(const string& filename, FBSurface& surface,
                            VariantList& metaData)
+{
+  readImage(filename, ReadInfo, metaData);
+
+  // Load image into the surface, setting the correct dimensions
+  loadImagetoSurface(surface);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::decodeImage(const string& filename, vector<uInt32>& pixels,
+                             uInt32& width, uInt32& height,
+                             VariantList& metaData) const
+{
+  // Use separate storage, the static 'ReadInfo' belongs to the main thread
+  ReadInfoType info;
+  readImage(filename, info, metaData);
+
+  width = info.width;
+  height = info.height;
+  pixels.resize(static_cast<size_t>(width) * height);
+  convertPixels(info, pixels.data(), width);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::readImage(const string& filename, ReadInfoType& info,
+                           VariantList& metaData)
 {
   png_structp png_ptr{nullptr};
   png_infop info_ptr{nullptr};
@@ -104,15 +142,15 @@ void PNGLibrary::loadImage(const string& filename, FBSurface& surface,
   }
 
   // Create/initialize storage area for the current image
-  if(!allocateStorage(iwidth, iheight, hasAlpha))
+  if(!allocateStorage(info, iwidth, iheight, hasAlpha))
     loadImageERROR("Not enough memory to read PNG image");
 
   // The PNG read function expects an array of rows, not a single 1-D array
-  for(uInt32 irow = 0, offset = 0; irow < ReadInfo.height; ++irow, offset += ReadInfo.pitch)
-    ReadInfo.row_pointers[irow] = ReadInfo.buffer.data() + offset;
+  for(uInt32 irow = 0, offset = 0; irow < info.height; ++irow, offset += info.pitch)
+    info.row_pointers[irow] = info.buffer.data() + offset;
 
   // Read the entire image in one go
-  png_read_image(png_ptr, ReadInfo.row_pointers.data());
+  png_read_image(png_ptr, info.row_pointers.data());
 
   // We're finished reading
   png_read_end(png_ptr, info_ptr);
@@ -120,9 +158,6 @@ void PNGLibrary::loadImage(const string& filename, FBSurface& surface,
   // Read the meta data we got
   readMetaData(png_ptr, info_ptr, metaData);
 
-  // Load image into the surface, setting the correct dimensions
-  loadImagetoSurface(surface, hasAlpha);
-
   // Cleanup
   if(png_ptr)
     png_destroy_read_struct(&png_ptr, info_ptr ? &info_ptr : nullptr, nullptr);
@@ -131,10 +166,28 @@ void PNGLibrary::loadImage(const string& filename, FBSurface& surface,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PNGLibrary::saveImage(const string& filename, const VariantList& metaData)
 {
-  std::ofstream out(filename, std::ios_base::binary);
-  if(!out.is_open())
-    throw runtime_error("ERROR: Couldn't create snapshot file");
+  vector<png_byte> buffer;
+  size_t width{0}, height{0};
+
+  readFrameBuffer(buffer, width, height);
+  writeImage(filename, buffer, width, height, metaData);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::saveImage(const string& filename, const FBSurface& surface,
+                           const Common::Rect& rect, const VariantList& metaData)
+{
+  vector<png_byte> buffer;
+  size_t width{0}, height{0};
+
+  readSurface(surface, rect, buffer, width, height);
+  writeImage(filename, buffer, width, height, metaData);
+}
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::readFrameBuffer(vector<png_byte>& buffer, size_t& width,
+                                 size_t& height) const
+{
   const FrameBuffer& fb = myOSystem.frameBuffer();
 
   const Common::Rect& rectUnscaled = fb.imageRect();
@@ -143,31 +196,22 @@ void PNGLibrary::saveImage(const string& filename, const VariantList& metaData)
     fb.scaleX(rectUnscaled.w()), fb.scaleY(rectUnscaled.h())
   );
 
-  const size_t width = rect.w(), height = rect.h();
+  width = rect.w();
+  height = rect.h();
 
   // Get framebuffer pixel data (we get ABGR format)
-  vector<png_byte> buffer(width * height * 4);
+  buffer.resize(width * height * 4);
   fb.readPixels(buffer.data(), width * 4, rect);
-
-  // Set up pointers into "buffer" byte array
-  vector<png_bytep> rows(height);
-  for(size_t k = 0; k < height; ++k)
-    rows[k] = buffer.data() + k * width * 4;
-
-  // And save the image
-  saveImageToDisk(out, rows, width, height, metaData);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void PNGLibrary::saveImage(const string& filename, const FBSurface& surface,
-                           const Common::Rect& rect, const VariantList& metaData)
+void PNGLibrary::readSurface(const FBSurface& surface, const Common::Rect& rect,
+                             vector<png_byte>& buffer, size_t& width,
+                             size_t& height)
 {
-  std::ofstream out(filename, std::ios_base::binary);
-  if(!out.is_open())
-    throw runtime_error("ERROR: Couldn't create snapshot file");
-
   // Do we want the entire surface or just a section?
-  size_t width = rect.w(), height = rect.h();
+  width = rect.w();
+  height = rect.h();
   if(rect.empty())
   {
     width = surface.width();
@@ -175,21 +219,32 @@ void PNGLibrary::saveImage(const string& filename, const FBSurface& surface,
   }
 
   // Get the surface pixel data (we get ABGR format)
-  vector<png_byte> buffer(width * height * 4);
+  buffer.resize(width * height * 4);
   surface.readPixels(buffer.data(), static_cast<uInt32>(width), rect);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::writeImage(const string& filename, const vector<png_byte>& buffer,
+                            size_t width, size_t height,
+                            const VariantList& metaData, Compression compression)
+{
+  std::ofstream out(filename, std::ios_base::binary);
+  if(!out.is_open())
+    throw runtime_error("ERROR: Couldn't create snapshot file");
 
   // Set up pointers into "buffer" byte array
   vector<png_bytep> rows(height);
   for(size_t k = 0; k < height; ++k)
-    rows[k] = buffer.data() + k * width * 4;
+    rows[k] = const_cast<png_bytep>(buffer.data()) + k * width * 4;
 
   // And save the image
-  saveImageToDisk(out, rows, width, height, metaData);
+  saveImageToDisk(out, rows, width, height, metaData, compression);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PNGLibrary::saveImageToDisk(std::ofstream& out, const vector<png_bytep>& rows,
-  size_t width, size_t height, const VariantList& metaData)
+  size_t width, size_t height, const VariantList& metaData,
+  Compression compression)
 {
   png_structp png_ptr{nullptr};
   png_infop info_ptr{nullptr};
@@ -214,6 +269,14 @@ void PNGLibrary::saveImageToDisk(std::ofstream& out, const vector<png_bytep>& ro
   // Set up the output control
   png_set_write_fn(png_ptr, &out, png_write_data, png_io_flush);
 
+  // Continuous snapshots must keep up with the emulation, so use the fastest
+  // zlib level and a single cheap filter instead of trying all of them
+  if(compression == Compression::Fast)
+  {
+    png_set_compression_level(png_ptr, 1);
+    png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
+  }
+
   // Write PNG header info
   png_set_IHDR(png_ptr, info_ptr,
       static_cast<png_uint_32>(width), static_cast<png_uint_32>(height), 8,
@@ -280,8 +343,10 @@ void PNGLibrary::toggleContinuousSnapshots(bool perFrame)
   {
     ostringstream buf;
     buf << "Disabling snapshots, generated "
-      << (mySnapCounter / mySnapInterval)
+      << (mySnapCounter / mySnapInterval - myDroppedSnaps)
       << " files";
+    if(myDroppedSnaps > 0)
+      buf << ", dropped " << myDroppedSnaps;
     myOSystem.frameBuffer().showTextMessage(buf.str());
     setContinuousSnapInterval(0);
   }
@@ -292,6 +357,7 @@ void PNGLibrary::setContinuousSnapInterval(uInt32 interval)
 {
   mySnapInterval = interval;
   mySnapCounter = 0;
+  myDroppedSnaps = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -300,6 +366,15 @@ void PNGLibrary::takeSnapshot(uInt32 number)
   if(!myOSystem.hasConsole())
     return;
 
+  // Continuous snapshots are dropped when the encoder threads cannot keep
+  // up, instead of stalling the emulation
+  const bool continuous = number > 0;
+  if(continuous && !canQueueJob())
+  {
+    ++myDroppedSnaps;
+    return;
+  }
+
   // Figure out the correct snapshot name
   string filename;
   const string sspath = myOSystem.snapshotSaveDir().getPath() +
@@ -308,7 +383,7 @@ void PNGLibrary::takeSnapshot(uInt32 number)
         : myOSystem.console().properties().get(PropType::Cart_Name));
 
   // Check whether we want multiple snapshots created
-  if(number > 0)
+  if(continuous)
   {
     ostringstream buf;
     buf << sspath << "_" << std::hex << std::setw(8) << std::setfill('0')
@@ -318,10 +393,10 @@ void PNGLibrary::takeSnapshot(uInt32 number)
   else if(!myOSystem.settings().getBool("sssingle"))
   {
     // Determine if the file already exists, checking each successive filename
-    // until one doesn't exist
+    // until one doesn't exist (or is about to be written)
     filename = sspath + ".png";
     const FSNode node(filename);
-    if(node.exists())
+    if(node.exists() || isPending(filename))
     {
       ostringstream buf;
       for(uInt32 i = 1; ;++i)
@@ -329,7 +404,7 @@ void PNGLibrary::takeSnapshot(uInt32 number)
         buf.str("");
         buf << sspath << "_" << i << ".png";
         const FSNode next(buf.str());
-        if(!next.exists())
+        if(!next.exists() && !isPending(buf.str()))
           break;
       }
       filename = buf.str();
@@ -352,21 +427,18 @@ void PNGLibrary::takeSnapshot(uInt32 number)
   VarList::push_back(metaData, "ROM MD5", myOSystem.console().properties().get(PropType::Cart_MD5));
   VarList::push_back(metaData, "TV Effects", myOSystem.frameBuffer().tiaSurface().effectsInfo());
 
-  // Now create a PNG snapshot
-  string message = "Snapshot saved";
+  // Now copy the image, it is compressed and written in the background
+  EncodeJob job;
+  job.filename = filename;
+  job.buffer = acquireBuffer();
+  job.metaData = std::move(metaData);
+  job.compression = continuous ? Compression::Fast : Compression::Default;
   if(myOSystem.settings().getBool("ss1x"))
   {
-    try
-    {
-      Common::Rect rect;
-      const FBSurface& surface =
-        myOSystem.frameBuffer().tiaSurface().baseSurface(rect);
-      PNGLibrary::saveImage(filename, surface, rect, metaData);
-    }
-    catch(const runtime_error& e)
-    {
-      message = e.what();
-    }
+    Common::Rect rect;
+    const FBSurface& surface =
+      myOSystem.frameBuffer().tiaSurface().baseSurface(rect);
+    readSurface(surface, rect, job.buffer, job.width, job.height);
   }
   else
   {
@@ -374,42 +446,138 @@ void PNGLibrary::takeSnapshot(uInt32 number)
     myOSystem.frameBuffer().enableMessages(false);
     myOSystem.frameBuffer().tiaSurface().renderForSnapshot();
 
+    readFrameBuffer(job.buffer, job.width, job.height);
+
+    // Re-enable old messages
+    myOSystem.frameBuffer().enableMessages(true);
+  }
+  queueJob(std::move(job));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::reportSnapshots()
+{
+  string message;
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+    if(myResult.empty())
+      return;
+    message = std::move(myResult);
+    myResult.clear();
+  }
+  myOSystem.frameBuffer().showTextMessage(message);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PNGLibrary::canQueueJob()
+{
+  const std::lock_guard<std::mutex> lock(myMutex);
+  return myJobs.size() < MAX_QUEUED_JOBS;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PNGLibrary::isPending(const string& filename)
+{
+  const std::lock_guard<std::mutex> lock(myMutex);
+  return myPendingFiles.find(filename) != myPendingFiles.end();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+vector<png_byte> PNGLibrary::acquireBuffer()
+{
+  const std::lock_guard<std::mutex> lock(myMutex);
+  if(myBuffers.empty())
+    return {};
+
+  vector<png_byte> buffer = std::move(myBuffers.back());
+  myBuffers.pop_back();
+  return buffer;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::queueJob(EncodeJob&& job)
+{
+  {
+    std::unique_lock<std::mutex> lock(myMutex);
+
+    // Wait until there is space in the queue; also make sure that a file
+    // which is written again (see 'sssingle') keeps the newest image
+    mySpaceCondition.wait(lock, [&] {
+      return myJobs.size() < MAX_QUEUED_JOBS &&
+             myPendingFiles.find(job.filename) == myPendingFiles.end();
+    });
+    myPendingFiles.insert(job.filename);
+    myJobs.push_back(std::move(job));
+
+    // Start the threads when they are needed for the first time
+    if(myThreads.empty())
+    {
+      const uInt32 numThreads = BSPF::clamp(std::thread::hardware_concurrency() / 2,
+                                            1U, MAX_THREADS);
+      for(uInt32 i = 0; i < numThreads; ++i)
+        myThreads.emplace_back([this] { encodeThread(); });
+    }
+  }
+  myJobCondition.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::encodeThread()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+  for(;;)
+  {
+    myJobCondition.wait(lock, [this] { return myStopThreads || !myJobs.empty(); });
+    if(myJobs.empty())
+      break;  // stopped, and all snapshots are written
+
+    EncodeJob job = std::move(myJobs.front());
+    myJobs.pop_front();
+    lock.unlock();
+
+    string message = "Snapshot saved";
     try
     {
-      PNGLibrary::saveImage(filename, metaData);
+      writeImage(job.filename, job.buffer, job.width, job.height,
+                 job.metaData, job.compression);
     }
     catch(const runtime_error& e)
     {
       message = e.what();
     }
 
-    // Re-enable old messages
-    myOSystem.frameBuffer().enableMessages(true);
+    lock.lock();
+    myPendingFiles.erase(job.filename);
+    if(myBuffers.size() < MAX_QUEUED_JOBS)
+      myBuffers.push_back(std::move(job.buffer));
+    myResult = message;
+    mySpaceCondition.notify_all();
   }
-  myOSystem.frameBuffer().showTextMessage(message);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool PNGLibrary::allocateStorage(size_t width, size_t height, bool hasAlpha)
+bool PNGLibrary::allocateStorage(ReadInfoType& info, size_t width,
+                                 size_t height, bool hasAlpha)
 {
   // Create space for the entire image (3(4) bytes per pixel in RGB(A) format)
   const size_t req_buffer_size = width * height * (hasAlpha ? 4 : 3);
-  if(req_buffer_size > ReadInfo.buffer.capacity())
-    ReadInfo.buffer.resize(req_buffer_size * 1.5);
+  if(req_buffer_size > info.buffer.capacity())
+    info.buffer.resize(req_buffer_size * 1.5);
 
   const size_t req_row_size = height;
-  if(req_row_size > ReadInfo.row_pointers.capacity())
-    ReadInfo.row_pointers.resize(req_row_size * 1.5);
+  if(req_row_size > info.row_pointers.capacity())
+    info.row_pointers.resize(req_row_size * 1.5);
 
-  ReadInfo.width  = static_cast<png_uint_32>(width);
-  ReadInfo.height = static_cast<png_uint_32>(height);
-  ReadInfo.pitch  = static_cast<png_uint_32>(width * (hasAlpha ? 4 : 3));
+  info.width    = static_cast<png_uint_32>(width);
+  info.height   = static_cast<png_uint_32>(height);
+  info.pitch    = static_cast<png_uint_32>(width * (hasAlpha ? 4 : 3));
+  info.hasAlpha = hasAlpha;
 
   return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void PNGLibrary::loadImagetoSurface(FBSurface& surface, bool hasAlpha)
+void PNGLibrary::loadImagetoSurface(FBSurface& surface)
 {
   // First determine if we need to resize the surface
   const uInt32 iw = ReadInfo.width, ih = ReadInfo.height;
@@ -424,19 +592,26 @@ void PNGLibrary::loadImagetoSurface(FBSurface& surface, bool hasAlpha)
   // Convert RGB triples into pixels and store in the surface
   uInt32 *s_buf{nullptr}, s_pitch{0};
   surface.basePtr(s_buf, s_pitch);
-  const uInt8* i_buf = ReadInfo.buffer.data();
-  const uInt32 i_pitch = ReadInfo.pitch;
+  convertPixels(ReadInfo, s_buf, s_pitch);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::convertPixels(const ReadInfoType& info, uInt32* buffer,
+                               uInt32 pitch) const
+{
+  const uInt8* i_buf = info.buffer.data();
+  const uInt32 i_pitch = info.pitch;
 
   const FrameBuffer& fb = myOSystem.frameBuffer();
-  for(uInt32 irow = 0; irow < ih; ++irow, i_buf += i_pitch, s_buf += s_pitch)
+  for(uInt32 irow = 0; irow < info.height; ++irow, i_buf += i_pitch, buffer += pitch)
   {
     const uInt8* i_ptr = i_buf;
-    uInt32* s_ptr = s_buf;
-    if(hasAlpha)
-      for(uInt32 icol = 0; icol < ReadInfo.width; ++icol, i_ptr += 4)
+    uInt32* s_ptr = buffer;
+    if(info.hasAlpha)
+      for(uInt32 icol = 0; icol < info.width; ++icol, i_ptr += 4)
         *s_ptr++ = fb.mapRGBA(*i_ptr, *(i_ptr+1), *(i_ptr+2), *(i_ptr+3));
     else
-      for(uInt32 icol = 0; icol < ReadInfo.width; ++icol, i_ptr += 3)
+      for(uInt32 icol = 0; icol < info.width; ++icol, i_ptr += 3)
         *s_ptr++ = fb.mapRGB(*i_ptr, *(i_ptr+1), *(i_ptr+2));
   }
 }
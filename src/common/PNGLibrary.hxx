@@ -21,6 +21,11 @@
 #define PNGLIBRARY_HXX
 
 #include <png.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
 
 class OSystem;
 class FBSurface;
@@ -30,12 +35,16 @@ class FBSurface;
   abstracts all the irrelevant details other loading and saving an
   actual image.
 
+  Snapshots are compressed and written by background encoder threads, so
+  that the main thread only has to copy the pixels.
+
   @author  Stephen Anthony
 */
 class PNGLibrary
 {
   public:
     explicit PNGLibrary(OSystem& osystem);
+    ~PNGLibrary();
 
     /**
       Read a PNG image from the specified file into a FBSurface structure,
@@ -52,6 +61,24 @@ class PNGLibrary
     void loadImage(const string& filename, FBSurface& surface,
                    VariantList& metaData);
 
+    /**
+      Read a PNG image from the specified file into a buffer of pixels,
+      already mapped to the framebuffer format.  Unlike loadImage(), this
+      method may be called from any thread.
+
+      @param filename  The filename to load the PNG image
+      @param pixels    The buffer receiving the pixels, row by row
+      @param width     Receives the width of the image
+      @param height    Receives the height of the image
+      @param metaData  The meta data of the PNG image
+
+      @post  On failure, a runtime_error is thrown containing a more
+             detailed error message.
+    */
+    void decodeImage(const string& filename, vector<uInt32>& pixels,
+                     uInt32& width, uInt32& height,
+                     VariantList& metaData) const;
+
     /**
       Save the current FrameBuffer image to a PNG file.  Note that in most
       cases this will be a TIA image, but it could actually be used for
@@ -124,13 +151,54 @@ class PNGLibrary
     */
     void takeSnapshot(uInt32 number = 0);
 
+    /**
+      Show the result of the snapshots written by the encoder threads
+      since the last call.  Called regularly from the main thread.
+    */
+    void reportSnapshots();
+
   private:
+    // The compression used when writing a PNG image; 'Fast' trades file
+    // size for speed, and is used for continuous snapshots
+    enum class Compression { Default, Fast };
+
+    // A snapshot waiting to be compressed and written by an encoder thread
+    struct EncodeJob
+    {
+      string filename;
+      vector<png_byte> buffer;
+      size_t width{0}, height{0};
+      VariantList metaData;
+      Compression compression{Compression::Default};
+    };
+
+    // The maximum number of snapshots waiting to be encoded; when the queue
+    // is full, continuous snapshots are dropped and single snapshots wait
+    static constexpr size_t MAX_QUEUED_JOBS = 8;
+    // The maximum number of encoder threads
+    static constexpr uInt32 MAX_THREADS = 2;
+
     // Global OSystem object
     OSystem& myOSystem;
 
     // Used for continuous snapshot mode
     uInt32 mySnapInterval{0};
     uInt32 mySnapCounter{0};
+    uInt32 myDroppedSnaps{0};
+
+    // The snapshots waiting to be encoded, the files not written yet, and
+    // the pixel buffers available for reuse
+    std::deque<EncodeJob> myJobs;
+    std::unordered_set<string> myPendingFiles;
+    vector<vector<png_byte>> myBuffers;
+    // The result of the most recently written snapshot, if not shown yet
+    string myResult;
+
+    vector<std::thread> myThreads;
+    std::mutex myMutex;
+    std::condition_variable myJobCondition;
+    std::condition_variable mySpaceCondition;
+    bool myStopThreads{false};
 
     // The following data remains between invocations of allocateStorage,
     // and is only changed when absolutely necessary.
@@ -138,34 +206,106 @@ class PNGLibrary
       vector<png_byte> buffer;
       vector<png_bytep> row_pointers;
       png_uint_32 width{0}, height{0}, pitch{0};
+      bool hasAlpha{false};
     };
     static ReadInfoType ReadInfo;
 
+    /**
+      Read a PNG image from the specified file into the given 'ReadInfo'
+      struct.
+
+      @param filename  The filename to load the PNG image
+      @param info      The struct receiving the image data
+      @param metaData  The meta data of the PNG image
+    */
+    static void readImage(const string& filename, ReadInfoType& info,
+                          VariantList& metaData);
+
     /**
       Allocate memory for PNG read operations.  This is used to provide a
       basic memory manager, so that we don't constantly allocate and deallocate
       memory for each image loaded.
 
-      The method fills the 'ReadInfo' struct with valid memory locations
+      The method fills the given 'ReadInfo' struct with valid memory locations
       dependent on the given dimensions.  If memory has been previously
       allocated and it can accommodate the given dimensions, it is used directly.
 
+      @param info    The struct to allocate the memory for
       @param width   The width of the PNG image
       @param height  The height of the PNG image
     */
-    static bool allocateStorage(size_t width, size_t height, bool hasAlpha);
+    static bool allocateStorage(ReadInfoType& info, size_t width, size_t height,
+                                bool hasAlpha);
+
+    /**
+      Copy the current FrameBuffer image into the given buffer (in ABGR
+      format), resizing the buffer as necessary.
+    */
+    void readFrameBuffer(vector<png_byte>& buffer, size_t& width,
+                         size_t& height) const;
+
+    /**
+      Copy the given area of the surface into the given buffer (in ABGR
+      format), resizing the buffer as necessary.
+    */
+    static void readSurface(const FBSurface& surface, const Common::Rect& rect,
+                            vector<png_byte>& buffer, size_t& width,
+                            size_t& height);
+
+    /**
+      Save the image data from the given buffer to a PNG file.
+
+      @param filename     The filename to save the PNG image
+      @param buffer       The image data (in ABGR format)
+      @param width        The width of the PNG image
+      @param height       The height of the PNG image
+      @param metaData     The meta data to add to the PNG image
+      @param compression  The compression profile to use
+    */
+    static void writeImage(const string& filename, const vector<png_byte>& buffer,
+                           size_t width, size_t height,
+                           const VariantList& metaData,
+                           Compression compression = Compression::Default);
 
     /** The actual method which saves a PNG image.
 
-      @param out       The output stream for writing PNG data
-      @param rows      Pointer into PNG RGB data for each row
-      @param width     The width of the PNG image
-      @param height    The height of the PNG image
-      @param metaData  The meta data to add to the PNG image
+      @param out          The output stream for writing PNG data
+      @param rows         Pointer into PNG RGB data for each row
+      @param width        The width of the PNG image
+      @param height       The height of the PNG image
+      @param metaData     The meta data to add to the PNG image
+      @param compression  The compression profile to use
     */
     static void saveImageToDisk(std::ofstream& out, const vector<png_bytep>& rows,
                                 size_t width, size_t height,
-                                const VariantList& metaData);
+                                const VariantList& metaData,
+                                Compression compression);
+
+    /**
+      Answer whether another snapshot can be queued without waiting.
+    */
+    bool canQueueJob();
+
+    /**
+      Answer whether the given file is still waiting to be written.
+    */
+    bool isPending(const string& filename);
+
+    /**
+      Get a buffer for the pixels of a snapshot from the pool.
+    */
+    vector<png_byte> acquireBuffer();
+
+    /**
+      Queue a snapshot for the encoder threads, waiting for space in the
+      queue if necessary.
+    */
+    void queueJob(EncodeJob&& job);
+
+    /**
+      The encoder threads compressing and writing the queued snapshots.
+    */
+    void encodeThread();
 
     /**
       Load the PNG data from 'ReadInfo' into the FBSurface.  The surface
@@ -173,7 +313,17 @@ class PNGLibrary
 
       @param surface  The FBSurface into which to place the PNG data
     */
-    void loadImagetoSurface(FBSurface& surface, bool hasAlpha);
+    void loadImagetoSurface(FBSurface& surface);
+
+    /**
+      Convert the PNG data from the given 'ReadInfo' struct into pixels.
+
+      @param info    The struct containing the PNG data
+      @param buffer  The pixel buffer to write to
+      @param pitch   The pitch of the pixel buffer (in pixels)
+    */
+    void convertPixels(const ReadInfoType& info, uInt32* buffer,
+                       uInt32 pitch) const;
 
     /**
       Write PNG tEXt chunks to the image.
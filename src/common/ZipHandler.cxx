@@ -23,52 +23,39 @@
 #include "ZipHandler.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::open(const string& filename)
+void ZipHandler::open(const string& filename, uInt64 modified)
 {
-  // Close already open file (if any) and add to cache
-  addToCache();
-
-  // Ensure we start with a nullptr result
-  myZip.reset();
-
-  ZipFilePtr ptr = findCached(filename);
-  if(ptr)
+  // Keep using the already open file, unless it has been changed since
+  if(myZip && myZip->isOpen() && myZip->myFilename == filename &&
+     modified != 0 && myZip->myDirectory->modified == modified)
   {
-    // Only a previously used entry will exist in the cache, so we know it's valid
-    myZip = std::move(ptr);
-
-    // Was already initialized; we just need to re-open it
-    if(!myZip->open())
-      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
+    reset();  // Reset iterator to beginning for subsequent use
+    return;
   }
+
+  // Reuse the ZipFile structure (and its buffer) of the previous file
+  ZipFilePtr ptr = std::move(myZip);
+  if(ptr)
+    ptr->close();
   else
   {
-    // Allocate memory for the ZipFile structure
-    try        { ptr = make_unique<ZipFile>(filename); }
+    try        { ptr = make_unique<ZipFile>(); }
     catch(...) { throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY)); }
+  }
 
-    // Open the file and initialize it
-    if(!ptr->open())
-      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-    ptr->initialize();
-
-    myZip = std::move(ptr);
+  // Open the file
+  if(!ptr->open(filename))
+    throw runtime_error(errorMessage(ZipError::FILE_ERROR));
 
-    // Count ROM files (we do it here so it will be cached)
-    try
-    {
-      while(hasNext())
-      {
-        const auto& [name, size] = next();
-        if(Bankswitch::isValidRomName(name))
-          myZip->myRomfiles++;
-      }
-    }
-    catch(...)
-    {
-      myZip->myRomfiles = 0;
-    }
+  // Only parse the central directory if it hasn't been cached, or the file
+  // has been changed since
+  ptr->myDirectory = findCached(filename, modified, ptr->myLength);
+  if(!ptr->myDirectory)
+  {
+    ptr->myDirectory = ptr->readDirectory(modified);
+    addToCache(ptr->myDirectory);
   }
+  myZip = std::move(ptr);
 
   reset();  // Reset iterator to beginning for subsequent use
 }
@@ -78,39 +65,58 @@ void ZipHandler::reset()
 {
   // Reset the position and go from there
   if(myZip)
+  {
     myZip->myCdPos = 0;
+    myZip->myHeader = nullptr;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ZipHandler::hasNext() const
 {
-  return myZip && (myZip->myCdPos < myZip->myEcd.cdSize);
+  return myZip && (myZip->myCdPos < myZip->myDirectory->headers.size() ||
+                   myZip->myDirectory->corrupt);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 std::tuple<string, size_t> ZipHandler::next()
 {
-  if(hasNext())
+  while(hasNext())
   {
-    const ZipHeader* const header = myZip->nextFile();
-    if(!header)
+    const auto& headers = myZip->myDirectory->headers;
+    if(myZip->myCdPos == headers.size())  // the rest is corrupt
       throw runtime_error(errorMessage(ZipError::FILE_CORRUPT));
-    else if(header->uncompressedLength == 0)
-      return next();
-    else
-      return {header->filename, header->uncompressedLength};
+
+    myZip->myHeader = &headers[myZip->myCdPos++];
+    if(myZip->myHeader->uncompressedLength > 0)
+      return {myZip->myHeader->filename, myZip->myHeader->uncompressedLength};
   }
   return {EmptyString, 0};
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ZipHandler::find(const string& filename)
+{
+  if(!myZip)
+    return false;
+
+  const auto& directory = *myZip->myDirectory;
+  const auto iter = directory.index.find(filename);
+  if(iter == directory.index.end())
+    return false;
+
+  myZip->myHeader = &directory.headers[iter->second];
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt64 ZipHandler::decompress(ByteBuffer& image)
 {
-  if(myZip && myZip->myHeader.uncompressedLength > 0)
+  if(myZip && myZip->myHeader && myZip->myHeader->uncompressedLength > 0)
   {
     try
     {
-      const uInt64 length = myZip->myHeader.uncompressedLength;
+      const uInt64 length = myZip->myHeader->uncompressedLength;
       image = make_unique<uInt8[]>(length);
 
       myZip->decompress(image, length);
@@ -148,16 +154,22 @@ string ZipHandler::errorMessage(ZipError err)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-ZipHandler::ZipFilePtr ZipHandler::findCached(const string& filename)
+ZipHandler::ZipDirectoryPtr ZipHandler::findCached(const string& filename,
+    uInt64 modified, uInt64 length)
 {
-  for(auto& cache: myZipCache)
+  const std::lock_guard<std::mutex> lock(ourCacheMutex);
+
+  for(auto& cache: ourDirectoryCache)
   {
-    // If we have a valid entry and it matches our filename,
-    // use it and remove from the cache
-    if(cache && (filename == cache->myFilename))
+    // If we have a valid entry and it matches our filename, use it if the
+    // file is unchanged, else remove it from the cache
+    if(cache && (filename == cache->filename))
     {
-      ZipFilePtr result;
-      std::swap(cache, result);
+      ZipDirectoryPtr result;
+      if(cache->modified == modified && cache->length == length)
+        result = cache;
+      else
+        cache.reset();
       return result;
     }
   }
@@ -165,51 +177,46 @@ ZipHandler::ZipFilePtr ZipHandler::findCached(const string& filename)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::addToCache()
+void ZipHandler::addToCache(const ZipDirectoryPtr& directory)
 {
-  if(myZip == nullptr)
-    return;
-
-  // Close the open file
-  myZip->close();
+  const std::lock_guard<std::mutex> lock(ourCacheMutex);
 
   // Find the first nullptr entry in the cache
   size_t cachenum{0};
-  for(cachenum = 0; cachenum < myZipCache.size(); ++cachenum)
-    if(myZipCache[cachenum] == nullptr)
+  for(cachenum = 0; cachenum < ourDirectoryCache.size(); ++cachenum)
+    if(ourDirectoryCache[cachenum] == nullptr)
       break;
 
   // If no room left in the cache, free the bottommost entry
-  if(cachenum == myZipCache.size())
+  if(cachenum == ourDirectoryCache.size())
   {
     cachenum--;
-    myZipCache[cachenum].reset();
+    ourDirectoryCache[cachenum].reset();
   }
 
   for( ; cachenum > 0; --cachenum)
-    myZipCache[cachenum] = std::move(myZipCache[cachenum - 1]);
-  myZipCache[0] = std::move(myZip);
-
-#if 0
-  cerr << "\nCACHE contents:\n";
-    for(cachenum = 0; cachenum < myZipCache.size(); ++cachenum)
-      if(myZipCache[cachenum] != nullptr)
-        cerr << "  " << cachenum << " : " << myZipCache[cachenum]->filename << '\n';
-  cerr << '\n';
-#endif
+    ourDirectoryCache[cachenum] = std::move(ourDirectoryCache[cachenum - 1]);
+  ourDirectoryCache[0] = directory;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-ZipHandler::ZipFile::ZipFile(const string& filename)
-  : myFilename{filename},
-    myBuffer{make_unique<uInt8[]>(DECOMPRESS_BUFSIZE)}
+ZipHandler::ZipFile::ZipFile()
+  : myBuffer{make_unique<uInt8[]>(DECOMPRESS_BUFSIZE)}
 {
-  std::fill(myBuffer.get(), myBuffer.get() + DECOMPRESS_BUFSIZE, 0);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ZipHandler::ZipFile::open()
+bool ZipHandler::ZipFile::open(const string& filename)
 {
+  myFilename = filename;
+
+  // Prefer mapping the file, which is read without seeking
+  if(myMapping.open(myFilename))
+  {
+    myLength = myMapping.size();
+    return true;
+  }
+
   myStream.open(myFilename, fstream::in | fstream::binary);
   if(!myStream.is_open())
   {
@@ -225,27 +232,77 @@ bool ZipHandler::ZipFile::open()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::initialize()
+ZipHandler::ZipDirectoryPtr ZipHandler::ZipFile::readDirectory(uInt64 modified)
 {
+  auto directory = make_shared<ZipDirectory>();
+  directory->filename = myFilename;
+  directory->modified = modified;
+  directory->length = myLength;
+
   // Read ecd data
-  readEcd();
+  const ZipEcd& ecd = directory->ecd = readEcd();
 
   // Verify that we can work with this zipfile (no disk spanning allowed)
-  if(myEcd.diskNumber != myEcd.cdStartDiskNumber ||
-     myEcd.cdDiskEntries != myEcd.cdTotalEntries)
+  if(ecd.diskNumber != ecd.cdStartDiskNumber ||
+     ecd.cdDiskEntries != ecd.cdTotalEntries)
     throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
 
   // Allocate memory for the central directory
-  try        { myCd = make_unique<uInt8[]>(myEcd.cdSize + 1); }
+  ByteBuffer cd;
+  try        { cd = make_unique<uInt8[]>(ecd.cdSize + 1); }
   catch(...) { throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY)); }
 
   // Read the central directory
   uInt64 read_length = 0;
-  const bool success = readStream(myCd, myEcd.cdStartDiskOffset, myEcd.cdSize, read_length);
+  const bool success = readStream(cd.get(), ecd.cdStartDiskOffset, ecd.cdSize, read_length);
   if(!success)
     throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-  else if(read_length != myEcd.cdSize)
+  else if(read_length != ecd.cdSize)
     throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
+
+  // Parse all file headers, and count ROM files
+  directory->headers.reserve(ecd.cdTotalEntries);
+  for(uInt64 pos = 0; pos < ecd.cdSize; )
+  {
+    // Make sure we have enough data
+    const CentralDirEntryReader reader(cd.get() + pos);
+    if(pos + CentralDirEntryReader::minimumLength() > ecd.cdSize ||
+       !reader.signatureCorrect() || ((pos + reader.totalLength()) > ecd.cdSize))
+    {
+      directory->corrupt = true;
+      break;
+    }
+
+    // Extract file header info
+    ZipHeader header;
+    header.versionCreated     = reader.versionCreated();
+    header.versionNeeded      = reader.versionNeeded();
+    header.bitFlag            = reader.generalFlag();
+    header.compression        = reader.compressionMethod();
+    header.crc                = reader.crc32();
+    header.compressedLength   = reader.compressedSize();
+    header.uncompressedLength = reader.uncompressedSize();
+    header.startDiskNumber    = reader.startDisk();
+    header.localHeaderOffset  = reader.headerOffset();
+    header.filename           = reader.filename();
+
+    // Empty files are never returned
+    if(header.uncompressedLength > 0)
+    {
+      directory->index.emplace(header.filename, directory->headers.size());
+      if(Bankswitch::isValidRomName(header.filename))
+        directory->romFiles++;
+    }
+    directory->headers.push_back(std::move(header));
+
+    // Advance the position
+    pos += reader.totalLength();
+  }
+  // ZIP files with a corrupt central directory contain no ROMs
+  if(directory->corrupt)
+    directory->romFiles = 0;
+
+  return directory;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -253,10 +310,19 @@ void ZipHandler::ZipFile::close()
 {
   if(myStream.is_open())
     myStream.close();
+  myMapping.close();
+  myDirectory.reset();
+  myHeader = nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ZipHandler::ZipFile::isOpen() const
+{
+  return myDirectory && (myMapping.isValid() || myStream.is_open());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::readEcd()
+ZipHandler::ZipEcd ZipHandler::ZipFile::readEcd()
 {
   uInt64 buflen = 1024;
 
@@ -275,7 +341,7 @@ void ZipHandler::ZipFile::readEcd()
       throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY));
 
     // Read in one buffers' worth of data
-    const bool success = readStream(buffer, myLength - buflen, buflen, read_length);
+    const bool success = readStream(buffer.get(), myLength - buflen, buflen, read_length);
     if(!success || read_length != buflen)
       throw runtime_error(errorMessage(ZipError::FILE_ERROR));
 
@@ -293,13 +359,14 @@ void ZipHandler::ZipFile::readEcd()
     {
       // Extract ECD info
       const EcdReader reader(buffer.get() + offset);
-      myEcd.diskNumber        = reader.thisDiskNo();
-      myEcd.cdStartDiskNumber = reader.dirStartDisk();
-      myEcd.cdDiskEntries     = reader.dirDiskEntries();
-      myEcd.cdTotalEntries    = reader.dirTotalEntries();
-      myEcd.cdSize            = reader.dirSize();
-      myEcd.cdStartDiskOffset = reader.dirOffset();
-      return;
+      ZipEcd ecd;
+      ecd.diskNumber        = reader.thisDiskNo();
+      ecd.cdStartDiskNumber = reader.dirStartDisk();
+      ecd.cdDiskEntries     = reader.dirDiskEntries();
+      ecd.cdTotalEntries    = reader.dirTotalEntries();
+      ecd.cdSize            = reader.dirSize();
+      ecd.cdStartDiskOffset = reader.dirOffset();
+      return ecd;
     }
 
     // Didn't find it; expand our search
@@ -312,13 +379,20 @@ void ZipHandler::ZipFile::readEcd()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ZipHandler::ZipFile::readStream(const ByteBuffer& out, uInt64 offset,
+bool ZipHandler::ZipFile::readStream(uInt8* out, uInt64 offset,
                                      uInt64 length, uInt64& actual)
 {
+  if(myMapping.isValid())
+  {
+    actual = myMapping.read(static_cast<size_t>(offset), out,
+                            static_cast<size_t>(length));
+    return true;
+  }
+
   try
   {
     myStream.seekg(offset);
-    myStream.read(reinterpret_cast<char*>(out.get()), length);
+    myStream.read(reinterpret_cast<char*>(out), length);
 
     actual = myStream.gcount();
     return true;
@@ -329,48 +403,22 @@ bool ZipHandler::ZipFile::readStream(const ByteBuffer& out, uInt64 offset,
   }
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const ZipHandler::ZipHeader* ZipHandler::ZipFile::nextFile()
-{
-  // Make sure we have enough data
-  // If we're at or past the end, we're done
-  const CentralDirEntryReader reader(myCd.get() + myCdPos);
-  if(!reader.signatureCorrect() || ((myCdPos + reader.totalLength()) > myEcd.cdSize))
-    return nullptr;
-
-  // Extract file header info
-  myHeader.versionCreated     = reader.versionCreated();
-  myHeader.versionNeeded      = reader.versionNeeded();
-  myHeader.bitFlag            = reader.generalFlag();
-  myHeader.compression        = reader.compressionMethod();
-  myHeader.crc                = reader.crc32();
-  myHeader.compressedLength   = reader.compressedSize();
-  myHeader.uncompressedLength = reader.uncompressedSize();
-  myHeader.startDiskNumber    = reader.startDisk();
-  myHeader.localHeaderOffset  = reader.headerOffset();
-  myHeader.filename           = reader.filename();
-
-  // Advance the position
-  myCdPos += reader.totalLength();
-  return &myHeader;
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ZipHandler::ZipFile::decompress(const ByteBuffer& out, uInt64 length)
 {
   // If we don't have enough buffer, error
-  if(length < myHeader.uncompressedLength)
+  if(length < myHeader->uncompressedLength)
     throw runtime_error(errorMessage(ZipError::BUFFER_TOO_SMALL));
 
   // Make sure the info in the header aligns with what we know
-  if(myHeader.startDiskNumber != myEcd.diskNumber)
+  if(myHeader->startDiskNumber != myDirectory->ecd.diskNumber)
     throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
 
   // Get the compressed data offset
   const uInt64 offset = getCompressedDataOffset();
 
   // Handle compression types
-  switch(myHeader.compression)
+  switch(myHeader->compression)
   {
     case 0:
       decompressDataType0(offset, out, length);
@@ -393,15 +441,15 @@ void ZipHandler::ZipFile::decompress(const ByteBuffer& out, uInt64 length)
 uInt64 ZipHandler::ZipFile::getCompressedDataOffset()
 {
   // Don't support a number of features
-  const GeneralFlagReader flags(myHeader.bitFlag);
-  if(myHeader.startDiskNumber != myEcd.diskNumber ||
-     myHeader.versionNeeded > 63 || flags.patchData() ||
+  const GeneralFlagReader flags(myHeader->bitFlag);
+  if(myHeader->startDiskNumber != myDirectory->ecd.diskNumber ||
+     myHeader->versionNeeded > 63 || flags.patchData() ||
      flags.encrypted() || flags.strongEncryption())
     throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
 
   // Read the fixed-sized part of the local file header
   uInt64 read_length = 0;
-  const bool success = readStream(myBuffer, myHeader.localHeaderOffset, 0x1e, read_length);
+  const bool success = readStream(myBuffer.get(), myHeader->localHeaderOffset, 0x1e, read_length);
   if(!success)
     throw runtime_error(errorMessage(ZipError::FILE_ERROR));
   else if(read_length != LocalFileHeaderReader::minimumLength())
@@ -412,7 +460,7 @@ uInt64 ZipHandler::ZipFile::getCompressedDataOffset()
   if(!reader.signatureCorrect())
     throw runtime_error(errorMessage(ZipError::BAD_SIGNATURE));
 
-  return myHeader.localHeaderOffset + reader.totalLength();
+  return myHeader->localHeaderOffset + reader.totalLength();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -421,10 +469,10 @@ void ZipHandler::ZipFile::decompressDataType0(
 {
   // The data is uncompressed; just read it
   uInt64 read_length = 0;
-  const bool success = readStream(out, offset, myHeader.compressedLength, read_length);
+  const bool success = readStream(out.get(), offset, myHeader->compressedLength, read_length);
   if(!success)
     throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-  else if(read_length != myHeader.compressedLength)
+  else if(read_length != myHeader->compressedLength)
     throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
 }
 
@@ -432,7 +480,7 @@ void ZipHandler::ZipFile::decompressDataType0(
 void ZipHandler::ZipFile::decompressDataType8(
     uInt64 offset, const ByteBuffer& out, uInt64 length)
 {
-  uInt64 input_remaining = myHeader.compressedLength;
+  uInt64 input_remaining = myHeader->compressedLength;
 
   // Reset the stream
   z_stream stream{};
@@ -453,8 +501,8 @@ void ZipHandler::ZipFile::decompressDataType8(
   {
     // Read in the next chunk of data
     uInt64 read_length = 0;
-    const bool success = readStream(myBuffer, offset,
-          std::min(input_remaining, static_cast<uInt64>(sizeof(myBuffer.get()))), read_length);
+    const bool success = readStream(myBuffer.get(), offset,
+        std::min(input_remaining, static_cast<uInt64>(DECOMPRESS_BUFSIZE - 1)), read_length);
     if(!success)
     {
       inflateEnd(&stream);
@@ -499,4 +547,9 @@ void ZipHandler::ZipFile::decompressDataType8(
     throw runtime_error(errorMessage(ZipError::DECOMPRESS_ERROR));
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::mutex ZipHandler::ourCacheMutex;
+std::array<ZipHandler::ZipDirectoryPtr, ZipHandler::CACHE_SIZE>
+  ZipHandler::ourDirectoryCache;
+
 #endif  /* ZIP_SUPPORT */
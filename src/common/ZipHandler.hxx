@@ -20,14 +20,21 @@
 #ifndef ZIP_HANDLER_HXX
 #define ZIP_HANDLER_HXX
 
+#include <mutex>
 #include <tuple>
+#include <unordered_map>
 
 #include "bspf.hxx"
+#include "MappedFile.hxx"
 
 /**
   This class implements a thin wrapper around the zip file management code
   from the MAME project.
 
+  The central directory of each ZIP file is parsed only once, and shared by
+  all handlers.  A handler itself is not thread-safe, but several handlers
+  can access ZIP files in parallel.
+
   @author  Original code by Aaron Giles, ZipHandler wrapper class and heavy
            modifications/refactoring by Stephen Anthony.
 */
@@ -37,20 +44,26 @@ class ZipHandler
     ZipHandler() = default;
 
     // Open ZIP file for processing
+    // The modification time of the file is used to detect changes since its
+    // central directory was cached
     // An exception will be thrown on any errors
-    void open(const string& filename);
+    void open(const string& filename, uInt64 modified = 0);
 
     // The following form an iterator for processing the filenames in the ZIP file
     void reset();          // Reset iterator to first file
     bool hasNext() const;  // Answer whether there are more files present
     std::tuple<string, size_t> next();  // Get information on next file
 
+    // Select the file with the given name (without iterating over all files)
+    // Answers whether the file was found
+    bool find(const string& filename);
+
     // Decompress the currently selected file and return its length
     // An exception will be thrown on any errors
     uInt64 decompress(ByteBuffer& image);
 
     // Answer the number of ROM files (with a valid extension) found
-    uInt16 romFiles() const { return myZip ? myZip->myRomfiles : 0; }
+    uInt16 romFiles() const { return myZip ? myZip->myDirectory->romFiles : 0; }
 
   private:
     // Error types
@@ -96,42 +109,55 @@ class ZipHandler
       uInt64 cdStartDiskOffset{0}; // offset of start of central directory with respect to the starting disk number
     };
 
+    // Contains the parsed central directory of a ZIP file
+    struct ZipDirectory
+    {
+      string  filename;         // ZIP filename
+      uInt64  modified{0};      // modification time of the ZIP file
+      uInt64  length{0};        // length of the ZIP file
+      ZipEcd  ecd;              // end of central directory
+      uInt16  romFiles{0};      // number of ROM files in central directory
+      bool    corrupt{false};   // the central directory is only partially valid
+
+      vector<ZipHeader> headers;  // all files, in order of the ZIP file
+      std::unordered_map<string, size_t> index;  // header index by filename
+    };
+    using ZipDirectoryPtr = shared_ptr<const ZipDirectory>;
+
     // Describes an open ZIP file
     struct ZipFile
     {
-      string  myFilename;     // copy of ZIP filename (for caching)
-      fstream myStream;       // C++ fstream file handle
+      string  myFilename;     // copy of ZIP filename
+      fstream myStream;       // C++ fstream file handle (if not mapped)
+      MappedFile myMapping;   // the mapped ZIP file (if supported)
       uInt64  myLength{0};    // length of zip file
-      uInt16  myRomfiles{0};  // number of ROM files in central directory
 
-      ZipEcd  myEcd;          // end of central directory
-
-      ByteBuffer myCd;        // central directory raw data
-      uInt64    myCdPos{0};   // position in central directory
-      ZipHeader myHeader;     // current file header
+      ZipDirectoryPtr myDirectory;    // the central directory
+      size_t myCdPos{0};              // position in central directory
+      const ZipHeader* myHeader{nullptr};  // current file header
 
       ByteBuffer myBuffer;    // buffer for decompression
 
-      /** Constructor */
-      explicit ZipFile(const string& filename);
+      /** Constructor, allocates the decompression buffer */
+      ZipFile();
 
-      /** Open the file and set up the internal stream buffer*/
-      bool open();
+      /** Open the file, map it or set up the internal stream buffer */
+      bool open(const string& filename);
 
-      /** Read the ZIP contents from the internal stream buffer */
-      void initialize();
+      /** Read and parse the central directory of the ZIP file */
+      ZipDirectoryPtr readDirectory(uInt64 modified);
 
       /** Close previously opened internal stream buffer */
       void close();
 
-      /** Read the ECD data */
-      void readEcd();
+      /** Answer whether a file has been opened, and its directory read */
+      bool isOpen() const;
 
-      /** Read data from stream */
-      bool readStream(const ByteBuffer& out, uInt64 offset, uInt64 length, uInt64& actual);
+      /** Read the ECD data */
+      ZipEcd readEcd();
 
-      /** Return the next entry in the ZIP file */
-      const ZipHeader* nextFile();
+      /** Read data from stream or mapping */
+      bool readStream(uInt8* out, uInt64 offset, uInt64 length, uInt64& actual);
 
       /** Decompress the most recently found file in the ZIP into target buffer */
       void decompress(const ByteBuffer& out, uInt64 length);
@@ -292,18 +318,22 @@ class ZipHandler
     /** Get message for given ZipError enumeration */
     static string errorMessage(ZipError err);
 
-    /** Search cache for given ZIP file */
-    ZipFilePtr findCached(const string& filename);
+    /** Search cache for the central directory of the given ZIP file */
+    static ZipDirectoryPtr findCached(const string& filename, uInt64 modified,
+                                      uInt64 length);
 
-    /** Close a ZIP file and add it to the cache */
-    void addToCache();
+    /** Add the central directory of a ZIP file to the cache */
+    static void addToCache(const ZipDirectoryPtr& directory);
 
   private:
     static constexpr size_t DECOMPRESS_BUFSIZE = 128_KB;
-    static constexpr size_t CACHE_SIZE = 64; // number of open files to cache
+    static constexpr size_t CACHE_SIZE = 64; // number of directories to cache
 
     ZipFilePtr myZip;
-    std::array<ZipFilePtr, CACHE_SIZE> myZipCache;
+
+    // The central directories of recently used ZIP files, shared by all handlers
+    static std::mutex ourCacheMutex;
+    static std::array<ZipDirectoryPtr, CACHE_SIZE> ourDirectoryCache;
 
   private:
     // Following constructors and assignment operators not supported
@@ -27,6 +27,7 @@
 #include "FSNode.hxx"
 #include "OSystem.hxx"
 #include "PNGLibrary.hxx"
+#include "AVCapture.hxx"
 #include "TIASurface.hxx"
 #include "ProfilingRunner.hxx"
 
@@ -117,7 +118,7 @@ void parseCommandLine(int ac, const char* const av[],
         cerr << "Missing argument for '" << key << "'\n";
         continue;
       }
-      if(key == "basedir" || key == "break")
+      if(key == "basedir" || key == "break" || key == "capexport")
         localOpts[key] = av[i];
       else
         globalOpts[key] = av[i];
@@ -282,6 +283,23 @@ int main(int ac, char* av[])
     freeConsole();
     return Cleanup();
   }
+  else if(!localOpts["capexport"].toString().empty())
+  {
+    attachConsole();
+    const string capfile = localOpts["capexport"].toString();
+    const string y4mfile = FSNode(capfile).getPathWithExt(".y4m");
+    try
+    {
+      AVCapture::exportY4M(capfile, y4mfile);
+      Logger::info("Exported '" + capfile + "' to '" + y4mfile + "'");
+    }
+    catch(const runtime_error& e)
+    {
+      Logger::error(e.what());
+    }
+    freeConsole();
+    return Cleanup();
+  }
 
   //// Main loop ////
   // First we check if a ROM is specified on the commandline.  If so, and if
@@ -2,6 +2,7 @@ MODULE := src/common
 
 MODULE_OBJS := \
 	src/common/AudioQueue.o \
+	src/common/AVCapture.o \
 	src/common/AudioSettings.o \
 	src/common/Base.o \
         src/common/Bezel.o \
@@ -16,6 +17,7 @@ MODULE_OBJS := \
 	src/common/JPGLibrary.o \
 	src/common/KeyMap.o \
 	src/common/Logger.o \
+	src/common/MappedFile.o \
 	src/common/main.o \
 	src/common/MouseControl.o \
 	src/common/PaletteHandler.o \
@@ -39,6 +41,8 @@ MODULE_OBJS := \
 	src/common/repository/KeyValueRepositoryJsonFile.o \
 	src/common/repository/KeyValueRepositoryConfigfile.o \
 	src/common/repository/CompositeKVRJsonAdapter.o \
+	src/common/repository/CompositeKeyValueRepositoryCached.o \
+	src/common/repository/KeyValueRepositoryCached.o \
 	src/common/repository/CompositeKeyValueRepository.o
 
 MODULE_DIRS += \
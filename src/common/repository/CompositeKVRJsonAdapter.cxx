@@ -26,10 +26,8 @@ namespace {
         {}
 
         KVRMap load() override {
-          if (!myKvr.has(myKey)) return {};
-
           Variant serialized;
-          myKvr.get(myKey, serialized);
+          if (!myKvr.get(myKey, serialized)) return {};
 
           stringstream in{serialized.toString()};
 
@@ -70,6 +68,18 @@ bool CompositeKVRJsonAdapter::has(string_view key)
   return myKvr.has(key);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CompositeKVRJsonAdapter::load(string_view key, KVRMap& values)
+{
+  Variant serialized;
+  if (!myKvr.get(key, serialized)) return false;
+
+  stringstream in{serialized.toString()};
+  values = KeyValueRepositoryJsonFile::load(in);
+
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CompositeKVRJsonAdapter::remove(string_view key)
 {
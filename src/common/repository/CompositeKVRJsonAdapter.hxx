@@ -31,6 +31,8 @@ class CompositeKVRJsonAdapter : public CompositeKeyValueRepository {
 
     bool has(string_view key) override;
 
+    bool load(string_view key, KVRMap& values) override;
+
     void remove(string_view key) override;
 
   private:
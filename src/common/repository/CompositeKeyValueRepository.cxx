@@ -17,6 +17,16 @@
 
 #include "repository/CompositeKeyValueRepository.hxx"
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CompositeKeyValueRepository::load(string_view key, KVRMap& values)
+{
+  if (!has(key)) return false;
+
+  values = get(key)->load();
+
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CompositeKeyValueRepositoryAtomic::get(string_view key1, string_view key2,
                                             Variant& value)
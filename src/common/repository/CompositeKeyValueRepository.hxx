@@ -36,6 +36,9 @@ class CompositeKeyValueRepository
 
     virtual bool has(string_view key) = 0;
 
+    // Combines has() and get()->load(), returns false if the key is missing
+    virtual bool load(string_view key, KVRMap& values);
+
     virtual void remove(string_view key) = 0;
 
     virtual CompositeKeyValueRepositoryAtomic* atomic() { return nullptr; }
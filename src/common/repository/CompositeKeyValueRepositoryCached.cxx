@@ -0,0 +1,99 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "repository/CompositeKeyValueRepositoryCached.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CompositeKeyValueRepositoryCached::CompositeKeyValueRepositoryCached(
+  shared_ptr<CompositeKeyValueRepositoryAtomic> repository,
+  std::mutex& repositoryMutex
+)
+  : myRepository{std::move(repository)},
+    myRepositoryMutex{repositoryMutex}
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+shared_ptr<KeyValueRepository> CompositeKeyValueRepositoryCached::get(string_view key)
+{
+  return cached(key);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CompositeKeyValueRepositoryCached::has(string_view key)
+{
+  return !cached(key)->load().empty();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompositeKeyValueRepositoryCached::remove(string_view key)
+{
+  shared_ptr<KeyValueRepositoryCached> repository;
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+
+    const auto it = myRepositories.find(key);
+    if (it != myRepositories.end()) {
+      repository = it->second;
+      myRepositories.erase(it);
+    }
+  }
+  // Drop pending changes, they must not be written after the removal
+  if (repository) repository->reset();
+
+  const std::lock_guard<std::mutex> repositoryLock(myRepositoryMutex);
+  myRepository->remove(key);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CompositeKeyValueRepositoryCached::flush()
+{
+  vector<shared_ptr<KeyValueRepositoryCached>> repositories;
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+
+    repositories.reserve(myRepositories.size());
+    for (const auto& [key, repository]: myRepositories)
+      repositories.push_back(repository);
+  }
+
+  bool result = true;
+  for (const auto& repository: repositories)
+    result = repository->flush() && result;
+
+  return result;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+shared_ptr<KeyValueRepositoryCached> CompositeKeyValueRepositoryCached::cached(
+    string_view key)
+{
+  const std::lock_guard<std::mutex> lock(myMutex);
+
+  auto it = myRepositories.find(key);
+  if (it == myRepositories.end()) {
+    shared_ptr<KeyValueRepositoryAtomic> repository;
+    {
+      const std::lock_guard<std::mutex> repositoryLock(myRepositoryMutex);
+      repository = myRepository->getAtomic(key);
+    }
+    it = myRepositories.emplace(key, make_shared<KeyValueRepositoryCached>(
+      std::move(repository), myRepositoryMutex)).first;
+  }
+
+  return it->second;
+}
@@ -0,0 +1,72 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef COMPOSITE_KEY_VALUE_REPOSITORY_CACHED_HXX
+#define COMPOSITE_KEY_VALUE_REPOSITORY_CACHED_HXX
+
+#include <mutex>
+
+#include "repository/CompositeKeyValueRepository.hxx"
+#include "repository/KeyValueRepositoryCached.hxx"
+#include "bspf.hxx"
+
+/**
+  A read-through, write-behind cache in front of another composite
+  repository, which caches each of its repositories separately (see
+  KeyValueRepositoryCached).
+*/
+class CompositeKeyValueRepositoryCached : public CompositeKeyValueRepositoryAtomic
+{
+  public:
+    using CompositeKeyValueRepositoryAtomic::get;
+    using CompositeKeyValueRepositoryAtomic::has;
+    using CompositeKeyValueRepositoryAtomic::remove;
+
+    CompositeKeyValueRepositoryCached(
+      shared_ptr<CompositeKeyValueRepositoryAtomic> repository,
+      std::mutex& repositoryMutex
+    );
+
+    shared_ptr<KeyValueRepository> get(string_view key) override;
+
+    bool has(string_view key) override;
+
+    void remove(string_view key) override;
+
+    // Write all changed keys to the repository
+    bool flush();
+
+  private:
+    shared_ptr<KeyValueRepositoryCached> cached(string_view key);
+
+  private:
+    shared_ptr<CompositeKeyValueRepositoryAtomic> myRepository;
+    std::mutex& myRepositoryMutex;  // NOLINT
+
+    std::map<string, shared_ptr<KeyValueRepositoryCached>, std::less<>> myRepositories;
+
+    std::mutex myMutex;
+
+  private:
+    // Following constructors and assignment operators not supported
+    CompositeKeyValueRepositoryCached(const CompositeKeyValueRepositoryCached&) = delete;
+    CompositeKeyValueRepositoryCached(CompositeKeyValueRepositoryCached&&) = delete;
+    CompositeKeyValueRepositoryCached& operator=(const CompositeKeyValueRepositoryCached&) = delete;
+    CompositeKeyValueRepositoryCached& operator=(CompositeKeyValueRepositoryCached&&) = delete;
+};
+
+#endif // COMPOSITE_KEY_VALUE_REPOSITORY_CACHED_HXX
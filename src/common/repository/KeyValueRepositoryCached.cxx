@@ -0,0 +1,181 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "repository/KeyValueRepositoryCached.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+KeyValueRepositoryCached::KeyValueRepositoryCached(
+  shared_ptr<KeyValueRepositoryAtomic> repository, std::mutex& repositoryMutex
+)
+  : myRepository{std::move(repository)},
+    myRepositoryMutex{repositoryMutex}
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+KeyValueRepositoryCached::~KeyValueRepositoryCached()
+{
+  flush();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+KVRMap KeyValueRepositoryCached::load()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  if (!myIsComplete) {
+    lock.unlock();
+    KVRMap stored;
+    {
+      const std::lock_guard<std::mutex> repositoryLock(myRepositoryMutex);
+      stored = myRepository->load();
+    }
+    lock.lock();
+
+    // Values changed meanwhile take precedence
+    for (auto& [key, value]: stored)
+      myEntries.try_emplace(key, Entry{std::move(value), true});
+    myIsComplete = true;
+  }
+
+  KVRMap values;
+  for (const auto& [key, entry]: myEntries)
+    if (entry.exists) values.emplace(key, entry.value);
+
+  return values;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool KeyValueRepositoryCached::save(const KVRMap& values)
+{
+  const std::lock_guard<std::mutex> lock(myMutex);
+
+  for (const auto& [key, value]: values)
+    update(key, Entry{value, true});
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool KeyValueRepositoryCached::has(string_view key)
+{
+  Variant value;
+
+  return get(key, value);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool KeyValueRepositoryCached::get(string_view key, Variant& value)
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  auto it = myEntries.find(key);
+  if (it == myEntries.end()) {
+    if (myIsComplete) return false;
+
+    lock.unlock();
+    Entry stored;
+    {
+      const std::lock_guard<std::mutex> repositoryLock(myRepositoryMutex);
+      stored.exists = myRepository->get(key, stored.value);
+    }
+    lock.lock();
+
+    // Remember missing keys too; a value changed meanwhile takes precedence
+    it = myEntries.try_emplace(string{key}, std::move(stored)).first;
+  }
+  if (!it->second.exists) return false;
+
+  value = it->second.value;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool KeyValueRepositoryCached::save(string_view key, const Variant& value)
+{
+  const std::lock_guard<std::mutex> lock(myMutex);
+
+  update(key, Entry{value, true});
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KeyValueRepositoryCached::remove(string_view key)
+{
+  const std::lock_guard<std::mutex> lock(myMutex);
+
+  update(key, Entry{});
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool KeyValueRepositoryCached::flush()
+{
+  // Keep the repository locked until the changes are written, so that
+  // concurrent flushes cannot overwrite newer values with older ones
+  const std::lock_guard<std::mutex> repositoryLock(myRepositoryMutex);
+
+  KVRMap changed;
+  vector<string> removed;
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+
+    for (const auto& key: myChangedKeys) {
+      const Entry& entry = myEntries.find(key)->second;
+
+      if (entry.exists) changed.emplace(key, entry.value);
+      else removed.push_back(key);
+    }
+    myChangedKeys.clear();
+  }
+
+  const bool result = changed.empty() || myRepository->save(changed);
+
+  for (const auto& key: removed)
+    myRepository->remove(key);
+
+  return result;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KeyValueRepositoryCached::reset()
+{
+  const std::lock_guard<std::mutex> lock(myMutex);
+
+  myEntries.clear();
+  myChangedKeys.clear();
+  myIsComplete = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KeyValueRepositoryCached::update(string_view key, const Entry& entry)
+{
+  const auto it = myEntries.find(key);
+
+  if (it != myEntries.end()) {
+    // Only write keys which have actually been changed
+    if (it->second.exists == entry.exists && it->second.value == entry.value)
+      return;
+
+    it->second = entry;
+  }
+  else
+    myEntries.emplace(key, entry);
+
+  myChangedKeys.emplace(key);
+}
@@ -0,0 +1,92 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef KEY_VALUE_REPOSITORY_CACHED_HXX
+#define KEY_VALUE_REPOSITORY_CACHED_HXX
+
+#include <mutex>
+#include <set>
+
+#include "repository/KeyValueRepository.hxx"
+#include "bspf.hxx"
+
+/**
+  A read-through, write-behind cache in front of another repository.  Values
+  are read from the repository once, changes are only kept in memory until
+  flush() writes the changed keys to the repository.
+
+  All accesses to the repository are guarded by the given mutex, which may be
+  shared by several caches (e.g. for repositories of the same database).
+*/
+class KeyValueRepositoryCached : public KeyValueRepositoryAtomic
+{
+  public:
+    using KeyValueRepositoryAtomic::save;
+
+    KeyValueRepositoryCached(shared_ptr<KeyValueRepositoryAtomic> repository,
+                             std::mutex& repositoryMutex);
+
+    ~KeyValueRepositoryCached() override;
+
+    KVRMap load() override;
+
+    bool save(const KVRMap& values) override;
+
+    bool has(string_view key) override;
+
+    bool get(string_view key, Variant& value) override;
+
+    bool save(string_view key, const Variant& value) override;
+
+    void remove(string_view key) override;
+
+    // Write all changed keys to the repository
+    bool flush();
+
+    // Forget all cached values and pending changes
+    void reset();
+
+  private:
+    struct Entry {
+      Variant value;
+      bool exists{false};  // false for keys known to be missing (or removed)
+    };
+
+    // Update a cached value, must be called with the mutex locked
+    void update(string_view key, const Entry& entry);
+
+  private:
+    shared_ptr<KeyValueRepositoryAtomic> myRepository;
+    std::mutex& myRepositoryMutex;  // NOLINT
+
+    std::map<string, Entry, std::less<>> myEntries;
+    std::set<string, std::less<>> myChangedKeys;
+
+    // True if all values of the repository have been loaded
+    bool myIsComplete{false};
+
+    std::mutex myMutex;
+
+  private:
+    // Following constructors and assignment operators not supported
+    KeyValueRepositoryCached(const KeyValueRepositoryCached&) = delete;
+    KeyValueRepositoryCached(KeyValueRepositoryCached&&) = delete;
+    KeyValueRepositoryCached& operator=(const KeyValueRepositoryCached&) = delete;
+    KeyValueRepositoryCached& operator=(KeyValueRepositoryCached&&) = delete;
+};
+
+#endif // KEY_VALUE_REPOSITORY_CACHED_HXX
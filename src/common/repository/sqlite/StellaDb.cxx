@@ -22,6 +22,8 @@
 #include "repository/CompositeKVRJsonAdapter.hxx"
 #include "repository/KeyValueRepositoryConfigfile.hxx"
 #include "repository/KeyValueRepositoryPropertyFile.hxx"
+#include "repository/KeyValueRepositoryCached.hxx"
+#include "repository/CompositeKeyValueRepositoryCached.hxx"
 #include "KeyValueRepositorySqlite.hxx"
 #include "CompositeKeyValueRepositorySqlite.hxx"
 #include "SqliteStatement.hxx"
@@ -44,6 +46,21 @@ StellaDb::StellaDb(const string& databaseDirectory, const string& databaseName)
 {
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StellaDb::~StellaDb()
+{
+  if (myFlushThread.joinable()) {
+    {
+      const std::lock_guard<std::mutex> lock(myFlushMutex);
+      myStopFlushThread = true;
+    }
+    myFlushCondition.notify_all();
+    myFlushThread.join();
+  }
+
+  flush();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void StellaDb::initialize()
 {
@@ -51,25 +68,29 @@ void StellaDb::initialize()
     myDb = make_unique<SqliteDatabase>(myDatabaseDirectory, myDatabaseName);
     myDb->initialize();
 
-    auto settingsRepository = make_unique<KeyValueRepositorySqlite>(*myDb, "settings", "setting", "value");
-    settingsRepository->initialize();
-    mySettingsRepository = std::move(settingsRepository);
+    mySettingsRepository = cachedRepository("settings", "setting", "value");
+    myPropertyRepositoryHost = cachedRepository("properties", "md5", "properties");
 
-    auto propertyRepositoryHost = make_unique<KeyValueRepositorySqlite>(*myDb, "properties", "md5", "properties");
-    propertyRepositoryHost->initialize();
-    myPropertyRepositoryHost = std::move(propertyRepositoryHost);
-
-    auto highscoreRepository = make_unique<CompositeKeyValueRepositorySqlite>(*myDb, "highscores", "md5", "variation", "highscore_data");
+    auto highscoreRepository = make_shared<CompositeKeyValueRepositorySqlite>(*myDb, "highscores", "md5", "variation", "highscore_data");
     highscoreRepository->initialize();
-    myHighscoreRepository = std::move(highscoreRepository);
+    auto highscoreCache = make_unique<CompositeKeyValueRepositoryCached>(std::move(highscoreRepository), myDbMutex);
+    myHighscoreCache = highscoreCache.get();
+    myHighscoreRepository = std::move(highscoreCache);
+
+    myAutodetectRepositoryHost = cachedRepository("autodetect", "md5", "results");
+    myRomIndexRepositoryHost = cachedRepository("romindex", "path", "info");
 
     myPropertyRepository = make_unique<CompositeKVRJsonAdapter>(*myPropertyRepositoryHost);
+    myAutodetectRepository = make_unique<CompositeKVRJsonAdapter>(*myAutodetectRepositoryHost);
+    myRomIndexRepository = make_unique<CompositeKVRJsonAdapter>(*myRomIndexRepositoryHost);
 
     if (myDb->getUserVersion() == 0) {
       initializeDb();
     } else {
       migrate();
     }
+
+    myFlushThread = std::thread([this] { flushThread(); });
   }
   catch (const SqliteError& err) {
     Logger::error("sqlite DB " + databaseFileName() + " failed to initialize: " + err.what());
@@ -77,12 +98,41 @@ void StellaDb::initialize()
     mySettingsRepository = make_unique<KeyValueRepositoryNoop>();
     myPropertyRepository = make_unique<CompositeKeyValueRepositoryNoop>();
     myHighscoreRepository = make_unique<CompositeKeyValueRepositoryNoop>();
+    myAutodetectRepository = make_unique<CompositeKeyValueRepositoryNoop>();
+    myRomIndexRepository = make_unique<CompositeKeyValueRepositoryNoop>();
+
+    myCaches.clear();
+    myHighscoreCache = nullptr;
 
     myDb.reset();
     myPropertyRepositoryHost.reset();
+    myAutodetectRepositoryHost.reset();
+    myRomIndexRepositoryHost.reset();
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaDb::setFlushInterval(uInt32 interval)
+{
+  {
+    const std::lock_guard<std::mutex> lock(myFlushMutex);
+    myFlushInterval = interval;
+  }
+  myFlushCondition.notify_all();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StellaDb::flush()
+{
+  bool success = true;
+  for (auto* cache: myCaches)
+    success = cache->flush() && success;
+
+  if (myHighscoreCache) success = myHighscoreCache->flush() && success;
+
+  return success;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string StellaDb::databaseFileName() const
 {
@@ -106,7 +156,10 @@ void StellaDb::initializeDb()
   if (legacyPropertyFile.exists() && legacyPropertyFile.isFile())
     importOldPropset(legacyPropertyFile);
 
-  myDb->setUserVersion(CURRENT_VERSION);
+  // The imported data is only cached so far; unless it has been written,
+  // the import must be repeated next time
+  if (flush())
+    myDb->setUserVersion(CURRENT_VERSION);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -215,3 +268,44 @@ void StellaDb::migrate()
     }
   }
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+unique_ptr<KeyValueRepositoryAtomic> StellaDb::cachedRepository(
+  string_view tableName, string_view colKey, string_view colValue)
+{
+  auto repository = make_shared<KeyValueRepositorySqlite>(*myDb, tableName, colKey, colValue);
+  repository->initialize();
+
+  auto cache = make_unique<KeyValueRepositoryCached>(std::move(repository), myDbMutex);
+  myCaches.push_back(cache.get());
+
+  return cache;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaDb::flushThread()
+{
+  std::unique_lock<std::mutex> lock(myFlushMutex);
+
+  while (true) {
+    const uInt32 interval = myFlushInterval;
+    const auto changed = [this, interval] {
+      return myStopFlushThread || myFlushInterval != interval;
+    };
+
+    if (interval)
+      myFlushCondition.wait_for(lock, std::chrono::milliseconds(interval), changed);
+    else
+      myFlushCondition.wait(lock, changed);
+
+    // The remaining changes are written by the destructor
+    if (myStopFlushThread) return;
+    // Wait again with the new interval
+    if (myFlushInterval != interval) continue;
+
+    // Don't block setting the interval while writing
+    lock.unlock();
+    flush();
+    lock.lock();
+  }
+}
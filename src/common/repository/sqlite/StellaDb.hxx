@@ -18,19 +18,44 @@
 #ifndef STELLA_DB_HXX
 #define STELLA_DB_HXX
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "bspf.hxx"
 #include "SqliteDatabase.hxx"
 #include "repository/KeyValueRepository.hxx"
 #include "repository/CompositeKeyValueRepository.hxx"
 #include "FSNode.hxx"
 
+class KeyValueRepositoryCached;
+class CompositeKeyValueRepositoryCached;
+
 class StellaDb
 {
   public:
     StellaDb(const string& databaseDirectory, const string& databaseName);
 
+    ~StellaDb();
+
     void initialize();
 
+    /**
+      Changes to the repositories are cached and written to the database by a
+      background thread.  Set the interval of these writes (0 = write only on
+      explicit flushes and when the database is closed).
+
+      @param interval  The interval in milliseconds
+    */
+    void setFlushInterval(uInt32 interval);
+
+    /**
+      Write all cached changes to the database.
+
+      @return  False if any of the changes could not be written, else true
+    */
+    bool flush();
+
     KeyValueRepositoryAtomic& settingsRepository() const {
       return *mySettingsRepository;
     }
@@ -40,6 +65,12 @@ class StellaDb
     CompositeKeyValueRepositoryAtomic& highscoreRepository() const {
       return *myHighscoreRepository;
     }
+    CompositeKeyValueRepository& autodetectRepository() const {
+      return *myAutodetectRepository;
+    }
+    CompositeKeyValueRepository& romIndexRepository() const {
+      return *myRomIndexRepository;
+    }
 
     string databaseFileName() const;
 
@@ -54,15 +85,40 @@ class StellaDb
 
     void migrate();
 
+    unique_ptr<KeyValueRepositoryAtomic> cachedRepository(
+      string_view tableName, string_view colKey, string_view colValue);
+
+    void flushThread();
+
   private:
+    static constexpr uInt32 DEFAULT_FLUSH_INTERVAL = 2000;
+
     string myDatabaseDirectory;
     string myDatabaseName;
 
     shared_ptr<SqliteDatabase> myDb;
+
+    // Guards all accesses to the database
+    std::mutex myDbMutex;
+
     unique_ptr<KeyValueRepositoryAtomic> mySettingsRepository;
     unique_ptr<KeyValueRepositoryAtomic> myPropertyRepositoryHost;
     unique_ptr<CompositeKeyValueRepository> myPropertyRepository;
     unique_ptr<CompositeKeyValueRepositoryAtomic> myHighscoreRepository;
+    unique_ptr<KeyValueRepositoryAtomic> myAutodetectRepositoryHost;
+    unique_ptr<CompositeKeyValueRepository> myAutodetectRepository;
+    unique_ptr<KeyValueRepositoryAtomic> myRomIndexRepositoryHost;
+    unique_ptr<CompositeKeyValueRepository> myRomIndexRepository;
+
+    // The caches in front of the database repositories (owned by the members above)
+    vector<KeyValueRepositoryCached*> myCaches;
+    CompositeKeyValueRepositoryCached* myHighscoreCache{nullptr};
+
+    std::thread myFlushThread;
+    std::mutex myFlushMutex;
+    std::condition_variable myFlushCondition;
+    uInt32 myFlushInterval{DEFAULT_FLUSH_INTERVAL};
+    bool myStopFlushThread{false};
 };
 
 #endif // STELLA_DB_HXX
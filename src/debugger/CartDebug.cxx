@@ -27,6 +27,7 @@
 #include "Settings.hxx"
 #include "Version.hxx"
 #include "Cart.hxx"
+#include "CartARM.hxx"
 #include "CartDebug.hxx"
 #include "CartDebugWidget.hxx"
 #include "CartRamWidget.hxx"
@@ -1450,6 +1451,63 @@ string CartDebug::saveAccessFile(string path)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string CartDebug::armProfile(string_view command)
+{
+  if(!myConsole.cartridge().isARM())
+    return DebuggerParser::red("no ARM cart");
+
+  auto& cart = static_cast<CartridgeARM&>(myConsole.cartridge());
+
+  if(command == "on" || command == "off")
+  {
+    cart.enableProfiling(command == "on");
+    return string("ARM profiling ") + (cart.profiling() ? "enabled" : "disabled");
+  }
+  if(command == "reset")
+  {
+    cart.resetProfile();
+    return "ARM profile reset";
+  }
+  if(!command.empty())
+    return DebuggerParser::red("invalid argument, use on, off, reset, save or ?");
+
+  ostringstream buf;
+  buf << "ARM profiling " << (cart.profiling() ? "enabled" : "disabled") << '\n';
+  cart.writeProfileSummary(buf);
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string CartDebug::saveArmProfile(string path)
+{
+  if(!myConsole.cartridge().isARM())
+    return DebuggerParser::red("no ARM cart");
+
+  stringstream out;
+  static_cast<CartridgeARM&>(myConsole.cartridge()).writeCollapsedProfile(out);
+
+  try
+  {
+    if(path.empty())
+      path = myOSystem.userDir().getPath()
+        + myConsole.properties().get(PropType::Cart_Name) + ".folded";
+    else
+      // Append default extension when missing
+      if(path.find_last_of('.') == string::npos)
+        path += ".folded";
+
+    const FSNode node(path);
+
+    node.write(out);
+    return "saved ARM profile as " + node.getShortPath();
+  }
+  catch(...)
+  {
+    return DebuggerParser::red("failed to save ARM profile file");
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string CartDebug::listConfig(int bank)
 {
@@ -244,6 +244,14 @@ class CartDebug : public DebuggerSystem
     */
     string saveAccessFile(string path = EmptyString);
 
+    /**
+      Control the ARM code profiler of ARM carts ("on", "off", "reset", or
+      empty for a summary of the profile) and save the profile as collapsed
+      stacks file
+    */
+    string armProfile(string_view command);
+    string saveArmProfile(string path = EmptyString);
+
     /**
       Show Distella directives (both set by the user and determined by Distella)
       for the given bank (or all banks, if no bank is specified).
@@ -752,6 +752,10 @@ void Debugger::setStartState()
   // Lock the bus each time the debugger is entered, so we don't disturb anything
   lockSystem();
 
+  // Track all accesses from now on, since the disassembly depends on them
+  if(mySystem.accessTracking() == System::AccessTracking::off)
+    mySystem.setAccessTracking(System::AccessTracking::full);
+
   // Save initial state and add it to the rewind list (except when in currently rewinding)
   const RewindManager& r = myOSystem.state().rewindManager();
   // avoid invalidating future states when entering the debugger e.g. during rewind
@@ -839,6 +839,54 @@ void DebuggerParser::executeA()
   debugger.cpuDebug().setA(static_cast<uInt8>(args[0]));
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "accessTracking"
+void DebuggerParser::executeAccessTracking()
+{
+  static constexpr std::array<string_view, 3> LEVELS = { "off", "flags", "full" };
+  System& system = debugger.mySystem;
+
+  if(argCount)
+  {
+    const auto it = std::find(LEVELS.begin(), LEVELS.end(), argStrings[0]);
+    if(it == LEVELS.end())
+    {
+      outputCommandError("invalid tracking level", myCommand);
+      return;
+    }
+    system.setAccessTracking(
+        static_cast<System::AccessTracking>(std::distance(LEVELS.begin(), it)));
+  }
+  commandResult << "access tracking: "
+                << LEVELS[static_cast<int>(system.accessTracking())];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "armProfile"
+void DebuggerParser::executeArmProfile()
+{
+  if(argCount && argStrings[0] == "?")
+  {
+    DebuggerDialog* dlg = debugger.myDialog;
+
+    BrowserDialog::show(dlg, "Save ARM Profile as",
+                        dlg->instance().userDir().getPath() + cartName() + ".folded",
+                        BrowserDialog::Mode::FileSave,
+                        [this, dlg](bool OK, const FSNode& node)
+    {
+      if(OK)
+        dlg->prompt().print(debugger.cartDebug().saveArmProfile(node.getPath()) + '\n');
+      dlg->prompt().printPrompt();
+    });
+    // avoid printing a new prompt
+    commandResult.str("_NO_PROMPT");
+  }
+  else if(argCount && argStrings[0] == "save")
+    commandResult << debugger.cartDebug().saveArmProfile();
+  else
+    commandResult << debugger.cartDebug().armProfile(argCount ? argStrings[0] : "");
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "aud"
 void DebuggerParser::executeAud()
@@ -2772,6 +2820,31 @@ DebuggerParser::CommandArray DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeA)
   },
 
+  {
+    "accessTracking",
+    "Set access tracking level [off, flags or full]",
+    "Shows the current level without argument\n"
+    "Example: accessTracking flags\n"
+    "NOTE: the disassembly misses all accesses done while tracking was off,\n"
+    "  flags don't count accesses (see saveAccess)",
+    false,
+    false,
+    { Parameters::ARG_LABEL, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeAccessTracking)
+  },
+
+  {
+    "armProfile",
+    "Control ARM code profiler [on, off, reset, save or ?]",
+    "Shows a summary of the profile without argument\n"
+    "Example: armProfile on, armProfile save, armProfile ?\n"
+    "NOTE: saves collapsed stacks (for flame graphs) to user dir by default",
+    false,
+    false,
+    { Parameters::ARG_LABEL, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeArmProfile)
+  },
+
   {
     "aud",
     "Mark 'AUD' range in disassembly",
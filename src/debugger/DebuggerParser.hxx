@@ -101,7 +101,7 @@ class DebuggerParser
       std::array<Parameters, 10> parms;
       std::function<void (DebuggerParser*)> executor;
     };
-    using CommandArray = std::array<Command, 111>;
+    using CommandArray = std::array<Command, 113>;
     static CommandArray commands;
 
     struct Trap
@@ -152,6 +152,8 @@ class DebuggerParser
 
     // List of available command methods
     void executeA();
+    void executeAccessTracking();
+    void executeArmProfile();
     void executeAud();
     void executeAutoSave();
     void executeBase();
@@ -289,5 +289,5 @@ void CartridgeARMWidget::handleArmCycles()
 
   myCart.incCycles(devSettings && enable);
   myCart.cycleFactor(factor);
-  myCart.enableCycleCount(devSettings);
+  myCart.enableCycleCount(devSettings || myCart.profiling());
 }
@@ -0,0 +1,152 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include "repository/CompositeKeyValueRepositoryNoop.hxx"
+
+#include "AutodetectCache.hxx"
+
+namespace {
+  // Must be increased whenever any of the detection code changes its
+  // results, which invalidates all existing entries
+  constexpr Int32 DETECTION_VERSION = 1;
+
+  constexpr string_view portKey(Controller::Jack port)
+  {
+    return port == Controller::Jack::Left ? "left" : "right";
+  }
+} // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AutodetectCache::AutodetectCache()
+  : myRepository{make_shared<CompositeKeyValueRepositoryNoop>()}
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AutodetectCache::setRepository(shared_ptr<CompositeKeyValueRepository> repository)
+{
+  myRepository = std::move(repository);
+  myMd5.clear();
+  myEntry.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Bankswitch::Type AutodetectCache::bankswitchType(string_view md5, size_t size)
+{
+  const KVRMap& values = entry(md5);
+  const auto type = values.find("bankswitch");
+  const auto romSize = values.find("size");
+
+  if(type == values.end() || romSize == values.end() ||
+     romSize->second != Variant(static_cast<uInt32>(size)))
+    return Bankswitch::Type::_AUTO;
+
+  return Bankswitch::nameToType(type->second.toString());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AutodetectCache::setBankswitchType(string_view md5, size_t size,
+                                        Bankswitch::Type type)
+{
+  entry(md5)["size"] = static_cast<uInt32>(size);
+  save(md5, "bankswitch", Bankswitch::typeToName(type));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string AutodetectCache::frameLayout(string_view md5, string_view bsType,
+                                    bool detectPal60, bool detectNtsc50)
+{
+  const KVRMap& values = entry(md5);
+  const auto format = values.find("layout");
+  const auto bs = values.find("layoutbs");
+  const auto pal60 = values.find("detectpal60");
+  const auto ntsc50 = values.find("detectntsc50");
+
+  if(format == values.end() || bs == values.end() ||
+     pal60 == values.end() || ntsc50 == values.end() ||
+     bs->second.toString() != bsType ||
+     pal60->second.toBool() != detectPal60 || ntsc50->second.toBool() != detectNtsc50)
+    return EmptyString;
+
+  return format->second.toString();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AutodetectCache::setFrameLayout(string_view md5, string_view bsType,
+                                     string_view format,
+                                     bool detectPal60, bool detectNtsc50)
+{
+  KVRMap& values = entry(md5);
+  values["layoutbs"] = bsType;
+  values["detectpal60"] = detectPal60;
+  values["detectntsc50"] = detectNtsc50;
+  save(md5, "layout", format);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Controller::Type AutodetectCache::controllerType(string_view md5,
+                                                 Controller::Jack port)
+{
+  const KVRMap& values = entry(md5);
+  const auto type = values.find(portKey(port));
+
+  return type != values.end()
+    ? Controller::getType(type->second.toString())
+    : Controller::Type::Unknown;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AutodetectCache::setControllerType(string_view md5, Controller::Jack port,
+                                        Controller::Type type)
+{
+  save(md5, portKey(port), Controller::getPropName(type));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AutodetectCache::remove(string_view md5)
+{
+  myRepository->remove(md5);
+  if(myMd5 == md5)
+    myEntry.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+KVRMap& AutodetectCache::entry(string_view md5)
+{
+  if(myMd5 != md5)
+  {
+    myMd5 = md5;
+    if(!myRepository->load(md5, myEntry))
+      myEntry.clear();
+
+    const auto version = myEntry.find("version");
+    if(version == myEntry.end() || version->second.toInt() != DETECTION_VERSION)
+      myEntry.clear();
+  }
+  return myEntry;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AutodetectCache::save(string_view md5, string_view key, const Variant& value)
+{
+  KVRMap& values = entry(md5);
+
+  values["version"] = DETECTION_VERSION;
+  values[string{key}] = value;
+  myRepository->get(md5)->save(values);
+}
@@ -0,0 +1,106 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef AUTODETECT_CACHE_HXX
+#define AUTODETECT_CACHE_HXX
+
+#include "bspf.hxx"
+#include "Bankswitch.hxx"
+#include "Control.hxx"
+#include "repository/CompositeKeyValueRepository.hxx"
+
+/**
+  This class remembers the results of the various autodetections done when
+  a ROM is loaded (bankswitch type, frame layout and controller types),
+  accessible by ROM md5.  On later launches of the same ROM, the cached
+  results are used instead of probing the ROM again.
+
+  Each entry is tagged with the version of the detection code, and the
+  frame layout also with the bankswitch type and the detection settings it
+  was created with.
+  Entries which don't match are ignored, and replaced by the results of
+  the next autodetection.  The 'rominfo' option always bypasses the cache.
+*/
+class AutodetectCache
+{
+  public:
+    AutodetectCache();
+
+    void setRepository(shared_ptr<CompositeKeyValueRepository> repository);
+
+    /**
+      Get/set the cached bankswitch type of the given ROM.
+
+      @return  The cached type, or _AUTO if none was found
+    */
+    Bankswitch::Type bankswitchType(string_view md5, size_t size);
+    void setBankswitchType(string_view md5, size_t size, Bankswitch::Type type);
+
+    /**
+      Get/set the cached frame layout (display format) of the given ROM,
+      when run with the given bankswitch type.
+
+      @return  The cached format, or an empty string if none was found
+    */
+    string frameLayout(string_view md5, string_view bsType,
+                       bool detectPal60, bool detectNtsc50);
+    void setFrameLayout(string_view md5, string_view bsType, string_view format,
+                        bool detectPal60, bool detectNtsc50);
+
+    /**
+      Get/set the cached controller type of the given ROM and port.
+
+      @return  The cached type, or Unknown if none was found
+    */
+    Controller::Type controllerType(string_view md5, Controller::Jack port);
+    void setControllerType(string_view md5, Controller::Jack port,
+                           Controller::Type type);
+
+    /**
+      Remove all cached results of the given ROM.
+    */
+    void remove(string_view md5);
+
+  private:
+    /**
+      Load the entry of the given ROM, unless it is already loaded.
+      Entries of other detection code versions are dropped.
+    */
+    KVRMap& entry(string_view md5);
+
+    /**
+      Store a value into the current entry and save it.
+    */
+    void save(string_view md5, string_view key, const Variant& value);
+
+  private:
+    shared_ptr<CompositeKeyValueRepository> myRepository;
+
+    // The most recently accessed entry
+    string myMd5;
+    KVRMap myEntry;
+
+  private:
+    // Following constructors and assignment operators not supported
+    AutodetectCache(const AutodetectCache&) = delete;
+    AutodetectCache(AutodetectCache&&) = delete;
+    AutodetectCache& operator=(const AutodetectCache&) = delete;
+    AutodetectCache& operator=(AutodetectCache&&) = delete;
+};
+
+#endif
@@ -37,8 +37,11 @@ Cartridge::Cartridge(const Settings& settings, string_view md5)
   for(uInt32 i = 0; i < 256; ++i)
     myRWPRandomValues[i] = rand.next();
 
-  const bool devSettings = mySettings.getBool("dev.settings");
-  myRandomHotspots = devSettings ? mySettings.getBool("dev.randomhs") : false;
+  const auto emulation = mySettings.emulation();
+  myRandomHotspots = emulation->randomHotspots;
+#ifdef DEBUGGER_SUPPORT
+  myRWPDetection = emulation->readFromWritePortBreak;
+#endif
   myRamReadAccesses.reserve(5);
 }
 
@@ -243,11 +246,11 @@ uInt16 Cartridge::initializeStartBank(uInt16 defaultBank)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Cartridge::randomInitialRAM() const
 {
-  return mySettings.getBool(mySettings.getBool("dev.settings") ? "dev.ramrandom" : "plr.ramrandom");
+  return mySettings.emulation()->ramRandom;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Cartridge::randomStartBank() const
 {
-  return mySettings.getBool(mySettings.getBool("dev.settings") ? "dev.bankrandom" : "plr.bankrandom");
+  return mySettings.emulation()->bankRandom;
 }
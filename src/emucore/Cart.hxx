@@ -92,6 +92,15 @@ class Cartridge : public Device
 
     void enableRandomHotspots(bool enable) { myRandomHotspots = enable; }
 
+    /**
+      Enable/disable the detection of reads from write ports (RWP).  When
+      disabled, carts may map the write ports of their RAM directly, instead
+      of handling each write in poke().
+
+      @param enable  Whether RWP detection is required
+    */
+    virtual void enableRWPDetection(bool enable) { myRWPDetection = enable; }
+
     /**
       Get the default startup bank for a cart.  This is the bank where
       the system will look at address 0xFFFC to determine where to
@@ -142,6 +151,14 @@ class Cartridge : public Device
     */
     virtual bool isPlusROM() const { return false; }
 
+    /**
+      Answer whether this cart contains an ARM coprocessor (and is thus
+      derived from CartridgeARM).
+
+      @return  Whether this is an ARM based cart
+    */
+    virtual bool isARM() const { return false; }
+
     /**
       Set the callback for displaying messages
     */
@@ -442,6 +459,10 @@ class Cartridge : public Device
     // If myRandomHotspots is true, peeks to hotspots return semi-random values.
     bool myRandomHotspots{false};
 
+    // If myRWPDetection is true, RAM writes must be handled by poke(), so that
+    // reads from write ports can be detected
+    bool myRWPDetection{false};
+
   private:
     // The startup bank to use (where to look for the reset vector address)
     uInt16 myStartBank{0};
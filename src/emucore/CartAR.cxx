@@ -72,6 +72,8 @@ void CartridgeAR::reset()
 
   myDataHoldRegister = 0;
   myNumberOfDistinctAccesses = 0;
+  myDistinctAccesses = 0;
+  myLastAccessAddress = 0;
   myWritePending = false;
 
   // Set bank configuration upon reset so ROM is selected and powered up
@@ -83,6 +85,9 @@ void CartridgeAR::install(System& system)
 {
   mySystem = &system;
 
+  // The write timing depends on all CPU accesses, not only the ones to the cart
+  mySystem->m6502().setBusObserver(this);
+
   // Map all of the accesses to call peek and poke (we don't yet indicate RAM areas)
   const System::PageAccess access(this, System::PageAccessType::READ);
   for(uInt16 addr = 0x1000; addr < 0x2000; addr += System::PAGE_SIZE)
@@ -111,10 +116,22 @@ uInt8 CartridgeAR::peek(uInt16 addr)
     return myImage[(addr & 0x07FF) + myImageOffset[1]];
   }
 
+  // Is the "dummy" SC BIOS entry for multi-loads being accessed? In fast
+  // mode the BIOS skips clearing page 7 of RAM bank 0, so do it directly
+  if(myFastLoad && ((addr & 0x1FFF) == 0x1800) && (myImageOffset[1] == RAM_SIZE))
+  {
+    // Leave the cart in the same state as the BIOS clearing loop does
+    bankConfiguration(0b00110);
+    std::fill_n(myImage.begin() + 0x0700, 0x100, 0);
+    mySystem->setDirtyPage(0x1700);
+    myDataHoldRegister = 0;
+    myWritePending = false;
+  }
+
   // Cancel any pending write if more than 5 distinct accesses have occurred
   // TODO: Modify to handle when the distinct counter wraps around...
   if(myWritePending &&
-      (mySystem->m6502().distinctAccesses() > myNumberOfDistinctAccesses + 5))
+      (myDistinctAccesses > myNumberOfDistinctAccesses + 5))
   {
     myWritePending = false;
   }
@@ -123,7 +140,7 @@ uInt8 CartridgeAR::peek(uInt16 addr)
   if(!(addr & 0x0F00) && (!myWriteEnabled || !myWritePending))
   {
     myDataHoldRegister = static_cast<uInt8>(addr);  // FIXME - check cast here
-    myNumberOfDistinctAccesses = mySystem->m6502().distinctAccesses();
+    myNumberOfDistinctAccesses = myDistinctAccesses;
     myWritePending = true;
   }
   // Is the bank configuration hotspot being accessed?
@@ -135,7 +152,7 @@ uInt8 CartridgeAR::peek(uInt16 addr)
   }
   // Handle poke if writing enabled
   else if(myWriteEnabled && myWritePending &&
-      (mySystem->m6502().distinctAccesses() == (myNumberOfDistinctAccesses + 5)))
+      (myDistinctAccesses == (myNumberOfDistinctAccesses + 5)))
   {
     if((addr & 0x0800) == 0)
     {
@@ -161,7 +178,7 @@ bool CartridgeAR::poke(uInt16 addr, uInt8)
   // Cancel any pending write if more than 5 distinct accesses have occurred
   // TODO: Modify to handle when the distinct counter wraps around...
   if(myWritePending &&
-      (mySystem->m6502().distinctAccesses() > myNumberOfDistinctAccesses + 5))
+      (myDistinctAccesses > myNumberOfDistinctAccesses + 5))
   {
     myWritePending = false;
   }
@@ -170,7 +187,7 @@ bool CartridgeAR::poke(uInt16 addr, uInt8)
   if(!(addr & 0x0F00) && (!myWriteEnabled || !myWritePending))
   {
     myDataHoldRegister = static_cast<uInt8>(addr);  // FIXME - check cast here
-    myNumberOfDistinctAccesses = mySystem->m6502().distinctAccesses();
+    myNumberOfDistinctAccesses = myDistinctAccesses;
     myWritePending = true;
   }
   // Is the bank configuration hotspot being accessed?
@@ -182,7 +199,7 @@ bool CartridgeAR::poke(uInt16 addr, uInt8)
   }
   // Handle poke if writing enabled
   else if(myWriteEnabled && myWritePending &&
-      (mySystem->m6502().distinctAccesses() == (myNumberOfDistinctAccesses + 5)))
+      (myDistinctAccesses == (myNumberOfDistinctAccesses + 5)))
   {
     if((addr & 0x0800) == 0)
     {
@@ -266,7 +283,13 @@ void CartridgeAR::initializeROM()
   // The scrom.asm code checks a value at offset 109 as follows:
   //   0xFF -> do a complete jump over the SC BIOS progress bars code
   //   0x00 -> show SC BIOS progress bars as normal
-  ourDummyROMCode[109] = mySettings.getBool("fastscbios") ? 0xFF : 0x00;
+  myFastLoad = mySettings.emulation()->fastSCBios;
+  ourDummyROMCode[109] = myFastLoad ? 0xFF : 0x00;
+
+  // The multi-load entry jumps to the RAM clearing code at offset 24 (0xF818)
+  // or directly to the load code at 0xF850, if the clearing is done by
+  // the emulator (see 'peek')
+  ourDummyROMCode[5] = myFastLoad ? 0x50 : 0x18;
 
   // The accumulator should contain a random value after exiting the
   // SC BIOS code - a value placed in offset 281 will be stored in A
@@ -421,6 +444,10 @@ bool CartridgeAR::save(Serializer& out) const
     // Indicates number of distinct accesses when data hold register was set
     out.putInt(myNumberOfDistinctAccesses);
 
+    // Indicates the number of the CPU's accesses to distinct addresses
+    out.putInt(myDistinctAccesses);
+    out.putShort(myLastAccessAddress);
+
     // Indicates if a write is pending or not
     out.putBool(myWritePending);
   }
@@ -466,6 +493,10 @@ bool CartridgeAR::load(Serializer& in)
     // Indicates number of distinct accesses when data hold register was set
     myNumberOfDistinctAccesses = in.getInt();
 
+    // Indicates the number of the CPU's accesses to distinct addresses
+    myDistinctAccesses = in.getInt();
+    myLastAccessAddress = in.getShort();
+
     // Indicates if a write is pending or not
     myWritePending = in.getBool();
   }
@@ -22,6 +22,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "M6502.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "CartARWidget.hxx"
 #endif
@@ -39,7 +40,7 @@ class System;
 
   @author  Bradford W. Mott
 */
-class CartridgeAR : public Cartridge
+class CartridgeAR : public Cartridge, public M6502::BusObserver
 {
   friend class CartridgeARWidget;
 
@@ -192,6 +193,15 @@ class CartridgeAR : public Cartridge
     // Sets up a "dummy" BIOS ROM in the ROM bank of the cartridge
     void initializeROM();
 
+    // Count the CPU's accesses to distinct addresses (used for write timing)
+    void busAccess(uInt16 address) override {
+      if(address != myLastAccessAddress)
+      {
+        ++myDistinctAccesses;
+        myLastAccessAddress = address;
+      }
+    }
+
   private:
     // Indicates the offset within the image for the corresponding bank
     std::array<uInt32, 2> myImageOffset;
@@ -223,6 +233,15 @@ class CartridgeAR : public Cartridge
     // Indicates number of distinct accesses when data hold register was set
     uInt32 myNumberOfDistinctAccesses{0};
 
+    // Indicates the number of the CPU's accesses to distinct addresses
+    uInt32 myDistinctAccesses{0};
+
+    // Indicates the last address which was accessed by the CPU
+    uInt16 myLastAccessAddress{0};
+
+    // Indicates if the SC BIOS should skip clearing RAM for multi-loads
+    bool myFastLoad{false};
+
     // Indicates if a write is pending or not
     bool myWritePending{false};
 
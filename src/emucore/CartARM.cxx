@@ -35,20 +35,23 @@ void CartridgeARM::reset()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeARM::setInitialState()
 {
-  const bool devSettings = mySettings.getBool("dev.settings");
+  const auto settings = mySettings.emulation();
+  const bool devSettings = settings->devSettings;
 
   if(devSettings)
   {
-    myIncCycles = mySettings.getBool("dev.thumb.inccycles");
-    myThumbEmulator->setChipType(static_cast<Thumbulator::ChipType>(mySettings.getInt("dev.thumb.chiptype")));
-    myThumbEmulator->setMamMode(static_cast<Thumbulator::MamModeType>(mySettings.getInt("dev.thumb.mammode")));
+    myIncCycles = settings->thumbIncCycles;
+    myThumbEmulator->setChipType(static_cast<Thumbulator::ChipType>(settings->thumbChipType));
+    myThumbEmulator->setMamMode(static_cast<Thumbulator::MamModeType>(settings->thumbMamMode));
   }
   else
   {
     myIncCycles = false;
     myThumbEmulator->setChipType();
   }
-  enableCycleCount(devSettings);
+  enableCycleCount(devSettings || profiling());
+  // Developers get the fully interpreted ARM code
+  enableHLE(!devSettings);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -82,6 +85,30 @@ void CartridgeARM::updateCycles(int cycles)
 #endif
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeARM::enableProfiling(bool enable)
+{
+  myThumbEmulator->enableProfiling(enable);
+  enableCycleCount(enable || mySettings.emulation()->devSettings);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CartridgeARM::startArmRecording(const string& filename)
+{
+  myThumbRecorder = make_unique<ThumbRecorder>();
+  if(myThumbRecorder->startRecording(filename, *myThumbEmulator))
+    return true;
+
+  myThumbRecorder.reset();
+  return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeARM::stopArmRecording()
+{
+  myThumbRecorder.reset();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeARM::incCycles(bool enable)
 {
@@ -19,6 +19,7 @@
 #define CARTRIDGE_ARM_HXX
 
 #include "Thumbulator.hxx"
+#include "ThumbRecorder.hxx"
 #include "PlusROM.hxx"
 #include "Cart.hxx"
 
@@ -40,6 +41,39 @@ class CartridgeARM : public Cartridge
     */
     void reset() override;
 
+    /**
+      Answer whether this cart contains an ARM coprocessor.
+    */
+    bool isARM() const override { return true; }
+
+    /**
+      Enable or disable profiling the ARM code.  Since the profile is based
+      on ARM cycles, these are counted while profiling.
+    */
+    void enableProfiling(bool enable);
+    bool profiling() const { return myThumbEmulator->profiling(); }
+    void resetProfile() const { myThumbEmulator->resetProfile(); }
+
+    /**
+      Write the ARM code profile as collapsed stacks (for flame graph tools)
+      or as a short summary.
+    */
+    void writeCollapsedProfile(ostream& out) const {
+      myThumbEmulator->writeCollapsedProfile(out);
+    }
+    void writeProfileSummary(ostream& out) const {
+      myThumbEmulator->writeProfileSummary(out);
+    }
+
+    /**
+      Start or stop recording all runs of the ARM code, for replaying them
+      with the 'thumbbench' tool (see ThumbRecorder).
+
+      @return  False on any errors, else true
+    */
+    bool startArmRecording(const string& filename);
+    void stopArmRecording();
+
   protected:
     /**
       Notification method invoked by the system when the console type
@@ -72,6 +106,7 @@ class CartridgeARM : public Cartridge
     virtual void setInitialState();
 
     void enableCycleCount(bool enable) const { myThumbEmulator->enableCycleCount(enable); }
+    void enableHLE(bool enable) const { myThumbEmulator->enableHLE(enable); }
     // Get number of memory accesses of last and last but one ARM runs.
     void updateCycles(int cycles);
   #ifdef DEBUGGER_SUPPORT
@@ -105,6 +140,9 @@ class CartridgeARM : public Cartridge
     // Pointer to the Thumb ARM emulator object
     unique_ptr<Thumbulator> myThumbEmulator;
 
+    // Records the runs of the ARM emulator, if enabled
+    unique_ptr<ThumbRecorder> myThumbRecorder;
+
     // Handle PlusROM functionality, if available
     unique_ptr<PlusROM> myPlusROM;
 
@@ -26,17 +26,7 @@ CartridgeBF::CartridgeBF(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartridgeBF::checkSwitchBank(uInt16 address, uInt8)
+void CartridgeBF::setupHotspots()
 {
-  // Due to the way addressing is set up, we will only get here if the
-  // address is in the hotspot range ($1F80 - $1FFF)
-  address &= ROM_MASK;
-
-  // Switch banks if necessary
-  if((address >= 0x0F80) && (address <= 0x0FBF))
-  {
-    bank(address - 0x0F80);
-    return true;
-  }
-  return false;
+  addHotspots(0x1F80, 64, 0);
 }
@@ -60,7 +60,7 @@ CartridgeBUS::CartridgeBUS(const ByteBuffer& image, size_t size,
   // Pointer to BUS driver in RAM
   myDriverImage = myRAM.data();
 
-  const bool devSettings = settings.getBool("dev.settings");
+  const auto emulation = settings.emulation();
 
   if (myBUSSubtype == BUSSubtype::BUS0)
   {
@@ -81,9 +81,8 @@ CartridgeBUS::CartridgeBUS(const ByteBuffer& image, size_t size,
       0x00000C00,
       0x00000C08,
       0x40001FFC,
-      devSettings ? settings.getBool("dev.thumb.trapfatal") : false,
-      devSettings ? static_cast<double>(
-          settings.getFloat("dev.thumb.cyclefactor")) : 1.0,
+      emulation->thumbTrapFatal,
+      emulation->thumbCycleFactor,
       Thumbulator::ConfigureFor::BUS,
       this);
   }
@@ -106,9 +105,8 @@ CartridgeBUS::CartridgeBUS(const ByteBuffer& image, size_t size,
       0x00000800,
       0x00000808,
       0x40001FFC,
-      devSettings ? settings.getBool("dev.thumb.trapfatal") : false,
-      devSettings ? static_cast<double>(
-          settings.getFloat("dev.thumb.cyclefactor")) : 1.0,
+      emulation->thumbTrapFatal,
+      emulation->thumbCycleFactor,
       Thumbulator::ConfigureFor::BUS,
       this);
   }
@@ -99,15 +99,14 @@ CartridgeCDF::CartridgeCDF(const ByteBuffer& image, size_t size,
   }
 
   // Create Thumbulator ARM emulator
-  const bool devSettings = settings.getBool("dev.settings");
+  const auto emulation = settings.emulation();
   myThumbEmulator = make_unique<Thumbulator>(
     reinterpret_cast<uInt16*>(myImage.get()),
     reinterpret_cast<uInt16*>(myRAM.data()),
     static_cast<uInt32>(mySize),
     cBase, cStart, cStack,
-    devSettings ? settings.getBool("dev.thumb.trapfatal") : false,
-    devSettings ? static_cast<double>(
-      settings.getFloat("dev.thumb.cyclefactor")) : 1.0,
+    emulation->thumbTrapFatal,
+    emulation->thumbCycleFactor,
     thumulatorConfiguration(myCDFSubtype),
     this);
 
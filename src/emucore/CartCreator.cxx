@@ -64,6 +64,7 @@
 #include "CartWD.hxx"
 #include "CartX07.hxx"
 #include "MD5.hxx"
+#include "AutodetectCache.hxx"
 #include "Settings.hxx"
 
 #include "CartDetector.hxx"
@@ -72,7 +73,7 @@
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 unique_ptr<Cartridge> CartCreator::create(const FSNode& file,
     const ByteBuffer& image, size_t size, string& md5,
-    string_view dtype, Settings& settings)
+    string_view dtype, Settings& settings, AutodetectCache* cache)
 {
   unique_ptr<Cartridge> cartridge;
   Bankswitch::Type type = Bankswitch::nameToType(dtype),
@@ -92,7 +93,15 @@ unique_ptr<Cartridge> CartCreator::create(const FSNode& file,
   // If we ask for extended info, always do an autodetect
   if(type == Bankswitch::Type::_AUTO || settings.getBool("rominfo"))
   {
-    detectedType = CartDetector::autodetectType(image, size);
+    // Use the type detected at a previous launch, if available
+    detectedType = cache && !settings.getBool("rominfo")
+      ? cache->bankswitchType(md5, size) : Bankswitch::Type::_AUTO;
+    if(detectedType == Bankswitch::Type::_AUTO)
+    {
+      detectedType = CartDetector::autodetectType(image, size);
+      if(cache)
+        cache->setBankswitchType(md5, size, detectedType);
+    }
     if(type != Bankswitch::Type::_AUTO && type != detectedType)
       cerr << "Auto-detection not consistent: "
            << Bankswitch::typeToName(type) << ", "
@@ -18,6 +18,7 @@
 #ifndef CARTRIDGE_CREATOR_HXX
 #define CARTRIDGE_CREATOR_HXX
 
+class AutodetectCache;
 class Cartridge;
 class Settings;
 
@@ -42,11 +43,13 @@ class CartCreator
       @param md5      The md5sum for the given ROM image (can be updated)
       @param dtype    The detected bankswitch type of the ROM image
       @param settings The settings container
+      @param cache    The cache for autodetected types (optional)
       @return   Pointer to the new cartridge object allocated on the heap
     */
     static unique_ptr<Cartridge> create(const FSNode& file,
                  const ByteBuffer& image, size_t size, string& md5,
-                 string_view dtype, Settings& settings);
+                 string_view dtype, Settings& settings,
+                 AutodetectCache* cache = nullptr);
 
   private:
     /**
@@ -26,15 +26,7 @@ CartridgeDF::CartridgeDF(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartridgeDF::checkSwitchBank(uInt16 address, uInt8)
+void CartridgeDF::setupHotspots()
 {
-  address &= ROM_MASK;
-
-  // Switch banks if necessary
-  if((address >= 0x0FC0) && (address <= 0x0FDF))
-  {
-    bank(address - 0x0FC0);
-    return true;
-  }
-  return false;
+  addHotspots(0x1FC0, 32, 0);
 }
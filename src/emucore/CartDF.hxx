@@ -72,7 +72,7 @@ class CartridgeDF : public CartridgeEnhanced
   #endif
 
   private:
-    bool checkSwitchBank(uInt16 address, uInt8) override;
+    void setupHotspots() override;
 
     uInt16 hotspot() const override { return 0x1FC0; }
 
@@ -17,7 +17,6 @@
 
 #include "Settings.hxx"
 #include "System.hxx"
-#include "AudioSettings.hxx"
 #include "CartDPC.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -35,7 +34,7 @@ void CartridgeDPC::reset()
 
   myAudioCycles = 0;
   myFractionalClocks = 0.0;
-  myDpcPitch = mySettings.getInt(AudioSettings::SETTING_DPC_PITCH);
+  myDpcPitch = mySettings.emulation()->dpcPitch;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
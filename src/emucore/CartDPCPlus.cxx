@@ -48,7 +48,7 @@ CartridgeDPCPlus::CartridgeDPCPlus(const ByteBuffer& image, size_t size,
   myFrequencyImage = myDisplayImage + 4_KB;
 
   // Create Thumbulator ARM emulator
-  const bool devSettings = settings.getBool("dev.settings");
+  const auto emulation = settings.emulation();
   myThumbEmulator = make_unique<Thumbulator>
       (reinterpret_cast<uInt16*>(myImage.get()),
        reinterpret_cast<uInt16*>(myDPCRAM.data()),
@@ -56,9 +56,8 @@ CartridgeDPCPlus::CartridgeDPCPlus(const ByteBuffer& image, size_t size,
       0x00000C00,
       0x00000C08,
       0x40001FFC,
-       devSettings ? settings.getBool("dev.thumb.trapfatal") : false,
-       devSettings ? static_cast<double>(
-          settings.getFloat("dev.thumb.cyclefactor")) : 1.0,
+       emulation->thumbTrapFatal,
+       emulation->thumbCycleFactor,
        Thumbulator::ConfigureFor::DPCplus,
        this);
 
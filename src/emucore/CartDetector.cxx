@@ -21,15 +21,297 @@
 #include "CartDetector.hxx"
 #include "CartMVC.hxx"
 
+namespace {
+  // All byte signatures searched for by the detection heuristics. They are
+  // combined into one Aho-Corasick automaton at compile time, which finds
+  // all of them in a single pass over the image.
+  enum Sig : uInt8 {
+    STA_1FF9, STA_FFF9,                                               // F8
+    ARM_LOADER_1, ARM_LOADER_2,                                       // ARM
+    ORA_03E0, LDA_03E0,                                               // 03E0
+    LDA_0800, LDA_0840, BIT_0800, NOP_0800_JMP, NOP_0FFF_JMP,         // 0840
+    BIT_0FC0, STA_0FC0, LDA_0FC0, BIT_EFC0,                           // 0FA0
+    STA_3E, STA_3F,                                                   // 3E, 3F
+    ID_3EX, ID_TJ3E, ID_BUS, ID_CDF, ID_PLUSCDFJ, ID_LENIN,
+    STA_F3FF_X, STA_F400_Y,                                           // CV
+    ID_DPCP,                                                          // DPC+
+    STA_1FE0, STA_5FE0, STA_FFE9, NOP_1FE0, LDA_1FE0,                 // E0
+    LDA_FFE9, LDA_FFED, LDA_BFF3,
+    LDA_FFE2, LDA_FFE5, LDA_1FE5, LDA_1FE7, NOP_1FE7,                 // E7
+    STA_FFE7, STA_1FE7,
+    LDA_FFE4, LDA_FFE6,                                               // E78K
+    NOP_FFE0, LDA_FFE0,                                               // EF
+    FC_SWITCH_1, FC_SWITCH_2, FC_SWITCH_3,                            // FC
+    FE_JSR_1, FE_JSR_2, FE_JSR_3, FE_JSR_4, FE_JSR_5,                 // FE
+    LDA_0CB8,                                                         // GL
+    ID_MDMC,                                                          // MDM
+    LDA_0800_X,                                                       // SB
+    TVBOY_RESET,                                                      // TV Boy
+    STA_0240, LDA_0240, LDA_021F_X, BIT_02C0, STA_02C0, LDA_02C0,     // UA
+    LDA_39_JMP,                                                       // WD
+    LDA_080D, LDA_081D, LDA_082D, NOP_080D, NOP_081D, NOP_082D,       // X07
+    NUM_SIGS
+  };
+
+  struct Signature
+  {
+    uInt8 size{0};
+    uInt8 bytes[8]{0};
+  };
+
+  // Note: the order must match the Sig enum above
+  constexpr Signature SIGNATURES[] = {
+    { 3, { 0x8D, 0xF9, 0x1F } },  // STA $1FF9
+    { 3, { 0x8D, 0xF9, 0xFF } },  // STA $FFF9
+    { 4, { 0xA0, 0xC1, 0x1F, 0xE0 } },  // ARM 'loader' patterns
+    { 4, { 0x00, 0x80, 0x02, 0xE0 } },
+    { 4, { 0x0D, 0xE0, 0x03, 0x0D } },  // ORA $3E0, ORA (Popeye)
+    { 4, { 0xAD, 0xE0, 0x03, 0xAD } },  // LDA $3E0, ORA (Montezuma's Revenge)
+    { 3, { 0xAD, 0x00, 0x08 } },  // LDA $0800
+    { 3, { 0xAD, 0x40, 0x08 } },  // LDA $0840
+    { 3, { 0x2C, 0x00, 0x08 } },  // BIT $0800
+    { 4, { 0x0C, 0x00, 0x08, 0x4C } },  // NOP $0800; JMP ...
+    { 4, { 0x0C, 0xFF, 0x0F, 0x4C } },  // NOP $0FFF; JMP ...
+    { 3, { 0x2C, 0xC0, 0x0F } },  // BIT $FC0  (H.E.R.O., Kung-Fu Master)
+    { 3, { 0x8D, 0xC0, 0x0F } },  // STA $FC0  (Pole Position, Subterranea)
+    { 3, { 0xAD, 0xC0, 0x0F } },  // LDA $FC0  (Front Line, Zaxxon)
+    { 3, { 0x2C, 0xC0, 0xEF } },  // BIT $EFC0 (Motocross)
+    { 2, { 0x85, 0x3E } },  // STA $3E
+    { 2, { 0x85, 0x3F } },  // STA $3F
+    { 3, { '3', 'E', 'X' } },
+    { 4, { 'T', 'J', '3', 'E' } },
+    { 3, { 'B', 'U', 'S' } },
+    { 3, { 'C', 'D', 'F' } },
+    { 8, { 'P', 'L', 'U', 'S', 'C', 'D', 'F', 'J' } },
+    { 5, { 'L', 'E', 'N', 'I', 'N' } },
+    { 3, { 0x9D, 0xFF, 0xF3 } },  // STA $F3FF,X  MagiCard
+    { 3, { 0x99, 0x00, 0xF4 } },  // STA $F400,Y  Video Life
+    { 4, { 'D', 'P', 'C', '+' } },
+    { 3, { 0x8D, 0xE0, 0x1F } },  // STA $1FE0
+    { 3, { 0x8D, 0xE0, 0x5F } },  // STA $5FE0
+    { 3, { 0x8D, 0xE9, 0xFF } },  // STA $FFE9
+    { 3, { 0x0C, 0xE0, 0x1F } },  // NOP $1FE0
+    { 3, { 0xAD, 0xE0, 0x1F } },  // LDA $1FE0
+    { 3, { 0xAD, 0xE9, 0xFF } },  // LDA $FFE9
+    { 3, { 0xAD, 0xED, 0xFF } },  // LDA $FFED
+    { 3, { 0xAD, 0xF3, 0xBF } },  // LDA $BFF3
+    { 3, { 0xAD, 0xE2, 0xFF } },  // LDA $FFE2
+    { 3, { 0xAD, 0xE5, 0xFF } },  // LDA $FFE5
+    { 3, { 0xAD, 0xE5, 0x1F } },  // LDA $1FE5
+    { 3, { 0xAD, 0xE7, 0x1F } },  // LDA $1FE7
+    { 3, { 0x0C, 0xE7, 0x1F } },  // NOP $1FE7
+    { 3, { 0x8D, 0xE7, 0xFF } },  // STA $FFE7
+    { 3, { 0x8D, 0xE7, 0x1F } },  // STA $1FE7
+    { 3, { 0xAD, 0xE4, 0xFF } },  // LDA $FFE4
+    { 3, { 0xAD, 0xE6, 0xFF } },  // LDA $FFE6
+    { 3, { 0x0C, 0xE0, 0xFF } },  // NOP $FFE0
+    { 3, { 0xAD, 0xE0, 0xFF } },  // LDA $FFE0
+    { 6, { 0x8d, 0xf8, 0x1f, 0x4a, 0x4a, 0x8d } }, // STA $1FF8, LSR, LSR, STA... Power Play Arcade Menus, 3-D Ghost Attack
+    { 6, { 0x8d, 0xf8, 0xff, 0x8d, 0xfc, 0xff } }, // STA $FFF8, STA $FFFC        Surf's Up (4K)
+    { 6, { 0x8c, 0xf9, 0xff, 0xad, 0xfc, 0xff } }, // STY $FFF9, LDA $FFFC        3-D Havoc
+    { 5, { 0x20, 0x00, 0xD0, 0xC6, 0xC5 } },  // JSR $D000; DEC $C5  Decathlon
+    { 5, { 0x20, 0xC3, 0xF8, 0xA5, 0x82 } },  // JSR $F8C3; LDA $82  Robot Tank
+    { 5, { 0xD0, 0xFB, 0x20, 0x73, 0xFE } },  // BNE $FB; JSR $FE73  Space Shuttle (NTSC/PAL)
+    { 5, { 0xD0, 0xFB, 0x20, 0x68, 0xFE } },  // BNE $FB; JSR $FE73  Space Shuttle (SECAM)
+    { 5, { 0x20, 0x00, 0xF0, 0x84, 0xD6 } },  // JSR $F000; $84, $D6 Thwocker
+    { 3, { 0xad, 0xb8, 0x0c } },  // LDA $0CB8
+    { 4, { 'M', 'D', 'M', 'C' } },
+    { 3, { 0xBD, 0x00, 0x08 } },  // LDA $0800,x
+    { 5, { 0x91, 0x82, 0x6c, 0xfc, 0xff } },  // STA ($82),Y; JMP ($FFFC)
+    { 3, { 0x8D, 0x40, 0x02 } },  // STA $240 (Funky Fish, Pleiades)
+    { 3, { 0xAD, 0x40, 0x02 } },  // LDA $240 (???)
+    { 3, { 0xBD, 0x1F, 0x02 } },  // LDA $21F,X (Gingerbread Man)
+    { 3, { 0x2C, 0xC0, 0x02 } },  // BIT $2C0 (Time Pilot)
+    { 3, { 0x8D, 0xC0, 0x02 } },  // STA $2C0 (Fathom, Vanguard)
+    { 3, { 0xAD, 0xC0, 0x02 } },  // LDA $2C0 (Mickey)
+    { 3, { 0xA5, 0x39, 0x4C } },  // LDA $39, JMP
+    { 3, { 0xAD, 0x0D, 0x08 } },  // LDA $080D
+    { 3, { 0xAD, 0x1D, 0x08 } },  // LDA $081D
+    { 3, { 0xAD, 0x2D, 0x08 } },  // LDA $082D
+    { 3, { 0x0C, 0x0D, 0x08 } },  // NOP $080D
+    { 3, { 0x0C, 0x1D, 0x08 } },  // NOP $081D
+    { 3, { 0x0C, 0x2D, 0x08 } }   // NOP $082D
+  };
+  static_assert(std::size(SIGNATURES) == NUM_SIGS, "Signatures don't match Sig enum");
+
+  constexpr size_t countSignatureBytes()
+  {
+    size_t count = 0;
+    for(const auto& sig: SIGNATURES)
+      count += sig.size;
+    return count;
+  }
+
+  constexpr size_t countDistinctBytes()
+  {
+    bool used[256]{false};
+    size_t count = 0;
+    for(const auto& sig: SIGNATURES)
+      for(uInt8 i = 0; i < sig.size; ++i)
+        if(!used[sig.bytes[i]])
+        {
+          used[sig.bytes[i]] = true;
+          ++count;
+        }
+    return count;
+  }
+
+  // Each byte of a signature gets its own class, all other bytes share class 0
+  constexpr size_t MAX_STATES  = countSignatureBytes() + 1;
+  constexpr size_t NUM_CLASSES = countDistinctBytes() + 1;
+  static_assert(MAX_STATES <= 0x10000, "Too many signature bytes");
+  static_assert(NUM_CLASSES <= 256, "Too many distinct signature bytes");
+
+  struct Automaton
+  {
+    std::array<uInt8, 256> byteClass{};
+    // Transitions, completed with the failure transitions (i.e. a DFA)
+    std::array<std::array<uInt16, NUM_CLASSES>, MAX_STATES> next{};
+    // The signature ending in a state, or NUM_SIGS
+    std::array<uInt8, MAX_STATES> match{};
+    // The first state with a match along the failure links (including
+    // the state itself), or 0
+    std::array<uInt16, MAX_STATES> output{};
+    // The next state with a match along the failure links, or 0
+    std::array<uInt16, MAX_STATES> matchLink{};
+  };
+
+  constexpr Automaton buildAutomaton()
+  {
+    Automaton a;
+    std::array<uInt16, MAX_STATES> fail{};
+    std::array<uInt16, MAX_STATES> queue{};
+    size_t classes = 1, states = 1;
+
+    for(auto& m: a.match)
+      m = NUM_SIGS;
+
+    // Build the trie of all signatures
+    for(uInt8 s = 0; s < NUM_SIGS; ++s)
+    {
+      uInt16 state = 0;
+      for(uInt8 i = 0; i < SIGNATURES[s].size; ++i)
+      {
+        const uInt8 byte = SIGNATURES[s].bytes[i];
+        if(a.byteClass[byte] == 0)
+          a.byteClass[byte] = static_cast<uInt8>(classes++);
+
+        uInt16& next = a.next[state][a.byteClass[byte]];
+        if(next == 0)
+          next = static_cast<uInt16>(states++);
+        state = next;
+      }
+      a.match[state] = s;
+    }
+
+    // Add failure transitions in breadth-first order
+    size_t head = 0, tail = 0;
+    for(size_t c = 0; c < classes; ++c)
+    {
+      const uInt16 next = a.next[0][c];
+      if(next != 0)
+      {
+        a.output[next] = a.match[next] != NUM_SIGS ? next : 0;
+        queue[tail++] = next;
+      }
+    }
+
+    while(head < tail)
+    {
+      const uInt16 state = queue[head++];
+      for(size_t c = 0; c < classes; ++c)
+      {
+        const uInt16 next = a.next[state][c];
+        if(next != 0)
+        {
+          fail[next] = a.next[fail[state]][c];
+          a.matchLink[next] = a.output[fail[next]];
+          a.output[next] = a.match[next] != NUM_SIGS ? next : a.matchLink[next];
+          queue[tail++] = next;
+        }
+        else
+          a.next[state][c] = a.next[fail[state]][c];
+      }
+    }
+    return a;
+  }
+
+  constexpr Automaton AUTOMATON = buildAutomaton();
+} // namespace
+
+/**
+  The hits of all signatures in an image, found in a single pass.
+
+  The results are identical to searching each signature separately with
+  CartDetector::searchForBytes(), i.e. hits are counted non-overlapping
+  (with at least one byte in between), and a signature ending in the last
+  byte of the image is not found.
+*/
+class CartDetector::SignatureScan
+{
+  public:
+    SignatureScan(const uInt8* image, size_t size)
+    {
+      std::array<size_t, NUM_SIGS> nextStart{};
+      uInt16 state = 0;
+
+      for(size_t i = 0; i + 1 < size; ++i)
+      {
+        state = AUTOMATON.next[state][AUTOMATON.byteClass[image[i]]];
+
+        for(uInt16 s = AUTOMATON.output[state]; s != 0; s = AUTOMATON.matchLink[s])
+        {
+          const uInt8 sig = AUTOMATON.match[s];
+          const size_t start = i + 1 - SIGNATURES[sig].size;
+          if(start >= nextStart[sig])
+          {
+            if(myHits[sig]++ == 0)
+              myFirst[sig] = start;
+            nextStart[sig] = start + SIGNATURES[sig].size + 1;
+          }
+        }
+      }
+    }
+
+    /**
+      Answer whether the signature was found at least 'minhits' times
+    */
+    bool found(Sig sig, uInt32 minhits = 1) const {
+      return myHits[sig] >= minhits;
+    }
+
+    /**
+      Answer whether any of the signatures was found
+    */
+    bool foundAny(std::initializer_list<Sig> sigs) const {
+      return std::any_of(sigs.begin(), sigs.end(),
+                         [&](Sig sig) { return found(sig); });
+    }
+
+    /**
+      Answer whether the signature was found within the first 'size' bytes
+    */
+    bool foundWithin(Sig sig, size_t size) const {
+      return found(sig) && myFirst[sig] + SIGNATURES[sig].size < size;
+    }
+
+  private:
+    std::array<uInt32, NUM_SIGS> myHits{};
+    std::array<size_t, NUM_SIGS> myFirst{};
+};
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t size)
 {
+  // Search for all signatures at once
+  const SignatureScan scan(image.get(), size);
+
   // Guess type based on size
   Bankswitch::Type type = Bankswitch::Type::_AUTO;
 
   if((size % 8448) == 0 || size == 6_KB)
   {
-    if(size == 6_KB && isProbablyGL(image, size))
+    if(size == 6_KB && isProbablyGL(scan))
       type = Bankswitch::Type::_GL;
     else
       type = Bankswitch::Type::_AR;
@@ -37,17 +319,17 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t si
   else if((size <= 2_KB) ||
           (size == 4_KB && std::memcmp(image.get(), image.get() + 2_KB, 2_KB) == 0))
   {
-    type = isProbablyCV(image, size) ? Bankswitch::Type::_CV : Bankswitch::Type::_2K;
+    type = isProbablyCV(scan) ? Bankswitch::Type::_CV : Bankswitch::Type::_2K;
   }
   else if(size == 4_KB)
   {
-    if(isProbablyCV(image, size))
+    if(isProbablyCV(scan))
       type = Bankswitch::Type::_CV;
     else if(isProbably4KSC(image, size))
       type = Bankswitch::Type::_4KSC;
-    else if (isProbablyFC(image, size))
+    else if (isProbablyFC(scan))
       type = Bankswitch::Type::_FC;
-    else if (isProbablyGL(image, size))
+    else if (isProbablyGL(scan))
       type = Bankswitch::Type::_GL;
     else
       type = Bankswitch::Type::_4K;
@@ -55,40 +337,36 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t si
   else if(size == 8_KB)
   {
     // First check for *potential* F8
-    static constexpr uInt8 signature[2][3] = {
-      { 0x8D, 0xF9, 0x1F },  // STA $1FF9
-      { 0x8D, 0xF9, 0xFF }   // STA $FFF9
-    };
-    const bool f8 = searchForBytes(image, size, signature[0], 3, 2) ||
-                    searchForBytes(image, size, signature[1], 3, 2);
+    const bool f8 = scan.found(Sig::STA_1FF9, 2) ||  // STA $1FF9
+                    scan.found(Sig::STA_FFF9, 2);    // STA $FFF9
 
     if(isProbablySC(image, size))
       type = Bankswitch::Type::_F8SC;
     else if(std::memcmp(image.get(), image.get() + 4_KB, 4_KB) == 0)
       type = Bankswitch::Type::_4K;
-    else if(isProbablyE0(image, size))
+    else if(isProbablyE0(scan))
       type = Bankswitch::Type::_E0;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(scan))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(scan))
       type = Bankswitch::Type::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(scan))
       type = Bankswitch::Type::_3F;
-    else if(isProbablyUA(image, size))
+    else if(isProbablyUA(scan))
       type = Bankswitch::Type::_UA;
-    else if(isProbably0FA0(image, size))
+    else if(isProbably0FA0(scan))
       type = Bankswitch::Type::_0FA0;
-    else if(isProbablyFE(image, size) && !f8)
+    else if(isProbablyFE(scan) && !f8)
       type = Bankswitch::Type::_FE;
-    else if(isProbably0840(image, size))
+    else if(isProbably0840(scan))
       type = Bankswitch::Type::_0840;
-    else if(isProbablyE78K(image, size))
+    else if(isProbablyE78K(scan))
       type = Bankswitch::Type::_E7;
-    else if (isProbablyWD(image,size))
+    else if (isProbablyWD(scan))
       type = Bankswitch::Type::_WD;
-    else if (isProbablyFC(image, size))
+    else if (isProbablyFC(scan))
       type = Bankswitch::Type::_FC;
-    else if(isProbably03E0(image, size))
+    else if(isProbably03E0(scan))
       type = Bankswitch::Type::_03E0;
     else
       type = Bankswitch::Type::_F8;
@@ -103,7 +381,7 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t si
   }
   else if(size == 12_KB)
   {
-    if(isProbablyE7(image, size))
+    if(isProbablyE7(scan))
       type = Bankswitch::Type::_E7;
     else
       type = Bankswitch::Type::_FA;
@@ -112,16 +390,16 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t si
   {
     if(isProbablySC(image, size))
       type = Bankswitch::Type::_F6SC;
-    else if(isProbablyE7(image, size))
+    else if(isProbablyE7(scan))
       type = Bankswitch::Type::_E7;
-    else if (isProbablyFC(image, size))
+    else if (isProbablyFC(scan))
       type = Bankswitch::Type::_FC;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(scan))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(scan))
       type = Bankswitch::Type::_3E;
   /* no known 16K 3F ROMS
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(scan))
       type = Bankswitch::Type::_3F;
   */
     else
@@ -133,121 +411,121 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t si
   }
   else if(size == 29_KB)
   {
-    if(isProbablyARM(image, size))
+    if(isProbablyARM(scan))
       type = Bankswitch::Type::_FA2;
-    else /*if(isProbablyDPCplus(image, size))*/
+    else /*if(isProbablyDPCplus(scan))*/
       type = Bankswitch::Type::_DPCP;
   }
   else if(size == 32_KB)
   {
-    if (isProbablyCTY(image, size))
+    if (isProbablyCTY(scan))
       type = Bankswitch::Type::_CTY;
-    else if(isProbablyCDF(image, size))
+    else if(isProbablyCDF(scan))
       type = Bankswitch::Type::_CDF;
-    else if(isProbablyDPCplus(image, size))
+    else if(isProbablyDPCplus(scan))
       type = Bankswitch::Type::_DPCP;
     else if(isProbablySC(image, size))
       type = Bankswitch::Type::_F4SC;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(scan))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(scan))
       type = Bankswitch::Type::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(scan))
       type = Bankswitch::Type::_3F;
-    else if (isProbablyBUS(image, size))
+    else if (isProbablyBUS(scan))
       type = Bankswitch::Type::_BUS;
     else if(isProbablyFA2(image, size))
       type = Bankswitch::Type::_FA2;
-    else if (isProbablyFC(image, size))
+    else if (isProbablyFC(scan))
       type = Bankswitch::Type::_FC;
     else
       type = Bankswitch::Type::_F4;
   }
   else if(size == 60_KB)
   {
-    if(isProbablyCTY(image, size))
+    if(isProbablyCTY(scan))
       type = Bankswitch::Type::_CTY;
     else
       type = Bankswitch::Type::_F4;
   }
   else if(size == 64_KB)
   {
-    if (isProbablyCDF(image, size))
+    if (isProbablyCDF(scan))
       type = Bankswitch::Type::_CDF;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(scan))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(scan))
       type = Bankswitch::Type::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(scan))
       type = Bankswitch::Type::_3F;
     else if(isProbably4A50(image, size))
       type = Bankswitch::Type::_4A50;
-    else if(isProbablyEF(image, size, type))
+    else if(isProbablyEF(image, size, scan, type))
       ; // type has been set directly in the function
-    else if(isProbablyX07(image, size))
+    else if(isProbablyX07(scan))
       type = Bankswitch::Type::_X07;
     else
       type = Bankswitch::Type::_F0;
   }
   else if(size == 128_KB)
   {
-    if (isProbablyCDF(image, size))
+    if (isProbablyCDF(scan))
       type = Bankswitch::Type::_CDF;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(scan))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(scan))
       type = Bankswitch::Type::_3E;
     else if(isProbablyDF(image, size, type))
       ; // type has been set directly in the function
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(scan))
       type = Bankswitch::Type::_3F;
     else if(isProbably4A50(image, size))
       type = Bankswitch::Type::_4A50;
-    else /*if(isProbablySB(image, size))*/
+    else /*if(isProbablySB(scan))*/
       type = Bankswitch::Type::_SB;
   }
   else if(size == 256_KB)
   {
-    if (isProbablyCDF(image, size))
+    if (isProbablyCDF(scan))
       type = Bankswitch::Type::_CDF;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(scan))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(scan))
       type = Bankswitch::Type::_3E;
     else if(isProbablyBF(image, size, type))
       ; // type has been set directly in the function
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(scan))
       type = Bankswitch::Type::_3F;
-    else /*if(isProbablySB(image, size))*/
+    else /*if(isProbablySB(scan))*/
       type = Bankswitch::Type::_SB;
   }
   else if(size == 512_KB)
   {
-    if(isProbablyTVBoy(image, size))
+    if(isProbablyTVBoy(scan))
       type = Bankswitch::Type::_TVBOY;
-    else if (isProbablyCDF(image, size))
+    else if (isProbablyCDF(scan))
       type = Bankswitch::Type::_CDF;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(scan))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(scan))
       type = Bankswitch::Type::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(scan))
       type = Bankswitch::Type::_3F;
   }
   else  // what else can we do?
   {
-    if(isProbably3EX(image, size))
+    if(isProbably3EX(scan))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(scan))
       type = Bankswitch::Type::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(scan))
       type = Bankswitch::Type::_3F;
   }
 
   // Variable sized ROM formats are independent of image size and come last
-  if(isProbably3EPlus(image, size))
+  if(isProbably3EPlus(scan))
     type = Bankswitch::Type::_3EP;
-  else if(isProbablyMDM(image, size))
+  else if(isProbablyMDM(scan))
     type = Bankswitch::Type::_MDM;
   else if(isProbablyMVC(image, size))
     type = Bankswitch::Type::_MVC;
@@ -308,120 +586,91 @@ bool CartDetector::isProbablySC(const ByteBuffer& image, size_t size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyARM(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyARM(const SignatureScan& scan)
 {
   // ARM code contains the following 'loader' patterns in the first 1K
   // Thanks to Thomas Jentzsch of AtariAge for this advice
-  static constexpr uInt8 signature[2][4] = {
-    { 0xA0, 0xC1, 0x1F, 0xE0 },
-    { 0x00, 0x80, 0x02, 0xE0 }
-  };
-  if(searchForBytes(image, std::min<size_t>(size, 1_KB), signature[0], 4))
-    return true;
-  else
-    return searchForBytes(image, std::min<size_t>(size, 1_KB), signature[1], 4);
+  return scan.foundWithin(Sig::ARM_LOADER_1, 1_KB) ||
+         scan.foundWithin(Sig::ARM_LOADER_2, 1_KB);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably03E0(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably03E0(const SignatureScan& scan)
 {
   // 03E0 cart bankswitching for Brazilian Parker Bros ROMs, switches segment
   // 0 into bank 0 by accessing address 0x3E0 using 'LDA $3E0' or 'ORA $3E0'.
-  static constexpr uInt8 signature[2][4] = {
-    { 0x0D, 0xE0, 0x03, 0x0D },  // ORA $3E0, ORA (Popeye)
-    { 0xAD, 0xE0, 0x03, 0xAD }   // LDA $3E0, ORA (Montezuma's Revenge)
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 4))
-      return true;
-
-  return false;
+  return scan.foundAny({
+    Sig::ORA_03E0,  // ORA $3E0, ORA (Popeye)
+    Sig::LDA_03E0   // LDA $3E0, ORA (Montezuma's Revenge)
+  });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably0840(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably0840(const SignatureScan& scan)
 {
   // 0840 cart bankswitching is triggered by accessing addresses 0x0800
   // or 0x0840 at least twice
-  static constexpr uInt8 signature1[3][3] = {
-    { 0xAD, 0x00, 0x08 },  // LDA $0800
-    { 0xAD, 0x40, 0x08 },  // LDA $0840
-    { 0x2C, 0x00, 0x08 }   // BIT $0800
-  };
-  for(const auto* const sig: signature1)
-    if(searchForBytes(image, size, sig, 3, 2))
-      return true;
-
-  static constexpr uInt8 signature2[2][4] = {
-    { 0x0C, 0x00, 0x08, 0x4C },  // NOP $0800; JMP ...
-    { 0x0C, 0xFF, 0x0F, 0x4C }   // NOP $0FFF; JMP ...
-  };
-  for(const auto* const sig: signature2)
-    if(searchForBytes(image, size, sig, 4, 2))
+  for(const Sig sig: {
+    Sig::LDA_0800,      // LDA $0800
+    Sig::LDA_0840,      // LDA $0840
+    Sig::BIT_0800,      // BIT $0800
+    Sig::NOP_0800_JMP,  // NOP $0800; JMP ...
+    Sig::NOP_0FFF_JMP   // NOP $0FFF; JMP ...
+  })
+    if(scan.found(sig, 2))
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably0FA0(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably0FA0(const SignatureScan& scan)
 {
   // Other Brazilian (Fotomania) ROM's bankswitching switches to bank 1 by
   // accessing address 0xFC0 using 'BIT $FC0', 'BIT $FC0' or 'STA $FC0'
   // Also a game (Motocross) using 'BIT $EFC0' has been found
-  static constexpr uInt8 signature[4][3] = {
-    { 0x2C, 0xC0, 0x0F },  // BIT $FC0  (H.E.R.O., Kung-Fu Master)
-    { 0x8D, 0xC0, 0x0F },  // STA $FC0  (Pole Position, Subterranea)
-    { 0xAD, 0xC0, 0x0F },  // LDA $FC0  (Front Line, Zaxxon)
-    { 0x2C, 0xC0, 0xEF }   // BIT $EFC0 (Motocross)
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 3))
-      return true;
-
-  return false;
+  return scan.foundAny({
+    Sig::BIT_0FC0,  // BIT $FC0  (H.E.R.O., Kung-Fu Master)
+    Sig::STA_0FC0,  // STA $FC0  (Pole Position, Subterranea)
+    Sig::LDA_0FC0,  // LDA $FC0  (Front Line, Zaxxon)
+    Sig::BIT_EFC0   // BIT $EFC0 (Motocross)
+  });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3E(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably3E(const SignatureScan& scan)
 {
   // 3E cart RAM bankswitching is triggered by storing the bank number
   // in address 3E using 'STA $3E', ROM bankswitching is triggered by
   // storing the bank number in address 3F using 'STA $3F'.
   // We expect the latter will be present at least 2 times, since there
   // are at least two banks
-
-  static constexpr uInt8 signature1[] = { 0x85, 0x3E };  // STA $3E
-  static constexpr uInt8 signature2[] = { 0x85, 0x3F };  // STA $3F
-  return searchForBytes(image, size, signature1, 2)
-    && searchForBytes(image, size, signature2, 2, 2);
+  return scan.found(Sig::STA_3E)      // STA $3E
+    && scan.found(Sig::STA_3F, 2);    // STA $3F
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3EX(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably3EX(const SignatureScan& scan)
 {
   // 3EX cart have at least 2 occurrences of the string "3EX"
-  static constexpr uInt8 _3EX[] = { '3', 'E', 'X' };
-  return searchForBytes(image, size, _3EX, 3, 2);
+  return scan.found(Sig::ID_3EX, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3EPlus(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably3EPlus(const SignatureScan& scan)
 {
   // 3E+ cart is identified key 'TJ3E' in the ROM
-  static constexpr uInt8 tj3e[] = { 'T', 'J', '3', 'E' };
-  return searchForBytes(image, size, tj3e, 4);
+  return scan.found(Sig::ID_TJ3E);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3F(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably3F(const SignatureScan& scan)
 {
   // 3F cart bankswitching is triggered by storing the bank number
   // in address 3F using 'STA $3F'
   // We expect it will be present at least 2 times, since there are
   // at least two banks
-  static constexpr uInt8 signature[] = { 0x85, 0x3F };  // STA $3F
-  return searchForBytes(image, size, signature, 2, 2);
+  return scan.found(Sig::STA_3F, 2);  // STA $3F
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -478,47 +727,38 @@ bool CartDetector::isProbablyBF(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyBUS(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyBUS(const SignatureScan& scan)
 {
   // BUS ARM code has 2 occurrences of the string BUS
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
-  static constexpr uInt8 bus[] = { 'B', 'U', 'S' };
-  return searchForBytes(image, size, bus, 3, 2);
+  return scan.found(Sig::ID_BUS, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCDF(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyCDF(const SignatureScan& scan)
 {
   // CDF ARM code has 3 occurrences of the string CDF
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
-  static constexpr uInt8 cdf[] = { 'C', 'D', 'F' };
-  static constexpr uInt8 cdfjplus[] = { 'P', 'L', 'U', 'S', 'C', 'D', 'F', 'J' };
-  return (searchForBytes(image, size, cdf, 3, 3) ||
-          searchForBytes(image, size, cdfjplus, 8, 1));
+  return scan.found(Sig::ID_CDF, 3) || scan.found(Sig::ID_PLUSCDFJ);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCTY(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyCTY(const SignatureScan& scan)
 {
-  static constexpr uInt8 lenin[] = { 'L', 'E', 'N', 'I', 'N' };
-  return searchForBytes(image, size, lenin, 5);
+  return scan.found(Sig::ID_LENIN);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCV(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyCV(const SignatureScan& scan)
 {
   // CV RAM access occurs at addresses $f3ff and $f400
   // These signatures are attributed to the MESS project
-  static constexpr uInt8 signature[2][3] = {
-    { 0x9D, 0xFF, 0xF3 },  // STA $F3FF,X  MagiCard
-    { 0x99, 0x00, 0xF4 }   // STA $F400,Y  Video Life
-  };
-  if(searchForBytes(image, size, signature[0], 3))
-    return true;
-  else
-    return searchForBytes(image, size, signature[1], 3);
+  return scan.foundAny({
+    Sig::STA_F3FF_X,  // STA $F3FF,X  MagiCard
+    Sig::STA_F400_Y   // STA $F400,Y  Video Life
+  });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -545,17 +785,16 @@ bool CartDetector::isProbablyDF(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyDPCplus(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyDPCplus(const SignatureScan& scan)
 {
   // DPC+ ARM code has 2 occurrences of the string DPC+
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
-  static constexpr uInt8 dpcp[] = { 'D', 'P', 'C', '+' };
-  return searchForBytes(image, size, dpcp, 4, 2);
+  return scan.found(Sig::ID_DPCP, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE0(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyE0(const SignatureScan& scan)
 {
   // E0 cart bankswitching is triggered by accessing addresses
   // $FE0 to $FF9 using absolute non-indexed addressing
@@ -563,25 +802,20 @@ bool CartDetector::isProbablyE0(const ByteBuffer& image, size_t size)
   // search for only certain known signatures
   // Thanks to "stella@casperkitty.com" for this advice
   // These signatures are attributed to the MESS project
-  static constexpr uInt8 signature[8][3] = {
-    { 0x8D, 0xE0, 0x1F },  // STA $1FE0
-    { 0x8D, 0xE0, 0x5F },  // STA $5FE0
-    { 0x8D, 0xE9, 0xFF },  // STA $FFE9
-    { 0x0C, 0xE0, 0x1F },  // NOP $1FE0
-    { 0xAD, 0xE0, 0x1F },  // LDA $1FE0
-    { 0xAD, 0xE9, 0xFF },  // LDA $FFE9
-    { 0xAD, 0xED, 0xFF },  // LDA $FFED
-    { 0xAD, 0xF3, 0xBF }   // LDA $BFF3
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 3))
-      return true;
-
-  return false;
+  return scan.foundAny({
+    Sig::STA_1FE0,  // STA $1FE0
+    Sig::STA_5FE0,  // STA $5FE0
+    Sig::STA_FFE9,  // STA $FFE9
+    Sig::NOP_1FE0,  // NOP $1FE0
+    Sig::LDA_1FE0,  // LDA $1FE0
+    Sig::LDA_FFE9,  // LDA $FFE9
+    Sig::LDA_FFED,  // LDA $FFED
+    Sig::LDA_BFF3   // LDA $BFF3
+  });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE7(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyE7(const SignatureScan& scan)
 {
   // E7 cart bankswitching is triggered by accessing addresses
   // $FE0 to $FE6 using absolute non-indexed addressing
@@ -589,44 +823,34 @@ bool CartDetector::isProbablyE7(const ByteBuffer& image, size_t size)
   // search for only certain known signatures
   // Thanks to "stella@casperkitty.com" for this advice
   // These signatures are attributed to the MESS project
-  static constexpr uInt8 signature[7][3] = {
-    { 0xAD, 0xE2, 0xFF },  // LDA $FFE2
-    { 0xAD, 0xE5, 0xFF },  // LDA $FFE5
-    { 0xAD, 0xE5, 0x1F },  // LDA $1FE5
-    { 0xAD, 0xE7, 0x1F },  // LDA $1FE7
-    { 0x0C, 0xE7, 0x1F },  // NOP $1FE7
-    { 0x8D, 0xE7, 0xFF },  // STA $FFE7
-    { 0x8D, 0xE7, 0x1F }   // STA $1FE7
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 3))
-      return true;
-
-  return false;
+  return scan.foundAny({
+    Sig::LDA_FFE2,  // LDA $FFE2
+    Sig::LDA_FFE5,  // LDA $FFE5
+    Sig::LDA_1FE5,  // LDA $1FE5
+    Sig::LDA_1FE7,  // LDA $1FE7
+    Sig::NOP_1FE7,  // NOP $1FE7
+    Sig::STA_FFE7,  // STA $FFE7
+    Sig::STA_1FE7   // STA $1FE7
+  });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE78K(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyE78K(const SignatureScan& scan)
 {
   // E78K cart bankswitching is triggered by accessing addresses
   // $FE4 to $FE6 using absolute non-indexed addressing
   // To eliminate false positives (and speed up processing), we
   // search for only certain known signatures
-  static constexpr uInt8 signature[3][3] = {
-    { 0xAD, 0xE4, 0xFF },  // LDA $FFE4
-    { 0xAD, 0xE5, 0xFF },  // LDA $FFE5
-    { 0xAD, 0xE6, 0xFF },  // LDA $FFE6
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 3))
-      return true;
-
-  return false;
+  return scan.foundAny({
+    Sig::LDA_FFE4,  // LDA $FFE4
+    Sig::LDA_FFE5,  // LDA $FFE5
+    Sig::LDA_FFE6   // LDA $FFE6
+  });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartDetector::isProbablyEF(const ByteBuffer& image, size_t size,
-                                Bankswitch::Type& type)
+                                const SignatureScan& scan, Bankswitch::Type& type)
 {
   // Newer EF carts store strings 'EFEF' and 'EFSC' starting at address $FFF8
   // This signature is attributed to "RevEng" of AtariAge
@@ -646,21 +870,12 @@ bool CartDetector::isProbablyEF(const ByteBuffer& image, size_t size,
   // Otherwise, EF cart bankswitching switches banks by accessing addresses
   // 0xFE0 to 0xFEF, usually with either a NOP or LDA
   // It's likely that the code will switch to bank 0, so that's what is tested
-  bool isEF = false;
-  static constexpr uInt8 signature[4][3] = {
-    { 0x0C, 0xE0, 0xFF },  // NOP $FFE0
-    { 0xAD, 0xE0, 0xFF },  // LDA $FFE0
-    { 0x0C, 0xE0, 0x1F },  // NOP $1FE0
-    { 0xAD, 0xE0, 0x1F }   // LDA $1FE0
-  };
-  for(const auto* const sig: signature)
-  {
-    if(searchForBytes(image, size, sig, 3))
-    {
-      isEF = true;
-      break;
-    }
-  }
+  const bool isEF = scan.foundAny({
+    Sig::NOP_FFE0,  // NOP $FFE0
+    Sig::LDA_FFE0,  // LDA $FFE0
+    Sig::NOP_1FE0,  // NOP $1FE0
+    Sig::LDA_1FE0   // LDA $1FE0
+  });
 
   // Now that we know that the ROM is EF, we need to check if it's
   // the SC variant
@@ -689,55 +904,42 @@ bool CartDetector::isProbablyFA2(const ByteBuffer& image, size_t)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyFC(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyFC(const SignatureScan& scan)
 {
   // FC bankswitching uses consecutive writes to 3 hotspots
-  static constexpr uInt8 signature[3][6] = {
-    { 0x8d, 0xf8, 0x1f, 0x4a, 0x4a, 0x8d }, // STA $1FF8, LSR, LSR, STA... Power Play Arcade Menus, 3-D Ghost Attack
-    { 0x8d, 0xf8, 0xff, 0x8d, 0xfc, 0xff }, // STA $FFF8, STA $FFFC        Surf's Up (4K)
-    { 0x8c, 0xf9, 0xff, 0xad, 0xfc, 0xff }  // STY $FFF9, LDA $FFFC        3-D Havoc
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 6))
-      return true;
-
-  return false;
+  return scan.foundAny({
+    Sig::FC_SWITCH_1,  // STA $1FF8, LSR, LSR, STA... Power Play Arcade Menus, 3-D Ghost Attack
+    Sig::FC_SWITCH_2,  // STA $FFF8, STA $FFFC        Surf's Up (4K)
+    Sig::FC_SWITCH_3   // STY $FFF9, LDA $FFFC        3-D Havoc
+  });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyFE(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyFE(const SignatureScan& scan)
 {
   // FE bankswitching is very weird, but always seems to include a
   // 'JSR $xxxx'
   // These signatures are (mostly) attributed to the MESS project
-  static constexpr uInt8 signature[5][5] = {
-    { 0x20, 0x00, 0xD0, 0xC6, 0xC5 },  // JSR $D000; DEC $C5  Decathlon
-    { 0x20, 0xC3, 0xF8, 0xA5, 0x82 },  // JSR $F8C3; LDA $82  Robot Tank
-    { 0xD0, 0xFB, 0x20, 0x73, 0xFE },  // BNE $FB; JSR $FE73  Space Shuttle (NTSC/PAL)
-    { 0xD0, 0xFB, 0x20, 0x68, 0xFE },  // BNE $FB; JSR $FE73  Space Shuttle (SECAM)
-    { 0x20, 0x00, 0xF0, 0x84, 0xD6 }   // JSR $F000; $84, $D6 Thwocker
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 5))
-      return true;
-
-  return false;
+  return scan.foundAny({
+    Sig::FE_JSR_1,  // JSR $D000; DEC $C5  Decathlon
+    Sig::FE_JSR_2,  // JSR $F8C3; LDA $82  Robot Tank
+    Sig::FE_JSR_3,  // BNE $FB; JSR $FE73  Space Shuttle (NTSC/PAL)
+    Sig::FE_JSR_4,  // BNE $FB; JSR $FE73  Space Shuttle (SECAM)
+    Sig::FE_JSR_5   // JSR $F000; $84, $D6 Thwocker
+  });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyGL(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyGL(const SignatureScan& scan)
 {
-  static constexpr uInt8 signature[] = { 0xad, 0xb8, 0x0c };  // LDA $0CB8
-
-  return searchForBytes(image, size, signature, 3);
+  return scan.found(Sig::LDA_0CB8);  // LDA $0CB8
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyMDM(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyMDM(const SignatureScan& scan)
 {
   // MDM cart is identified key 'MDMC' in the first 8K of ROM
-  static constexpr uInt8 mdmc[] = { 'M', 'D', 'M', 'C' };
-  return searchForBytes(image, std::min<size_t>(size, 8_KB), mdmc, 4);
+  return scan.foundWithin(Sig::ID_MDMC, 8_KB);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -773,76 +975,58 @@ size_t CartDetector::isProbablyMVC(const FSNode& rom)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablySB(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablySB(const SignatureScan& scan)
 {
   // SB cart bankswitching switches banks by accessing address 0x0800
-  static constexpr uInt8 signature[2][3] = {
-    { 0xBD, 0x00, 0x08 },  // LDA $0800,x
-    { 0xAD, 0x00, 0x08 }   // LDA $0800
-  };
-  if(searchForBytes(image, size, signature[0], 3))
-    return true;
-  else
-    return searchForBytes(image, size, signature[1], 3);
+  return scan.foundAny({
+    Sig::LDA_0800_X,  // LDA $0800,x
+    Sig::LDA_0800     // LDA $0800
+  });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyTVBoy(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyTVBoy(const SignatureScan& scan)
 {
   // TV Boy cart bankswitching switches banks by accessing addresses 0x1800..$187F
-  static constexpr uInt8 signature[5] = { 0x91, 0x82, 0x6c, 0xfc, 0xff };  // STA ($82),Y; JMP ($FFFC)
-  return searchForBytes(image, size, signature, 5);
+  return scan.found(Sig::TVBOY_RESET);  // STA ($82),Y; JMP ($FFFC)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyUA(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyUA(const SignatureScan& scan)
 {
   // UA cart bankswitching switches to bank 1 by accessing address 0x240
   // using 'STA $240' or 'LDA $240'.
   // Brazilian (Digivison) cart bankswitching switches to bank 1 by accessing address 0x2C0
   // using 'BIT $2C0', 'STA $2C0' or 'LDA $2C0'
-  static constexpr uInt8 signature[6][3] = {
-    { 0x8D, 0x40, 0x02 },  // STA $240 (Funky Fish, Pleiades)
-    { 0xAD, 0x40, 0x02 },  // LDA $240 (???)
-    { 0xBD, 0x1F, 0x02 },  // LDA $21F,X (Gingerbread Man)
-    { 0x2C, 0xC0, 0x02 },  // BIT $2C0 (Time Pilot)
-    { 0x8D, 0xC0, 0x02 },  // STA $2C0 (Fathom, Vanguard)
-    { 0xAD, 0xC0, 0x02 },  // LDA $2C0 (Mickey)
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 3))
-      return true;
-
-  return false;
+  return scan.foundAny({
+    Sig::STA_0240,    // STA $240 (Funky Fish, Pleiades)
+    Sig::LDA_0240,    // LDA $240 (???)
+    Sig::LDA_021F_X,  // LDA $21F,X (Gingerbread Man)
+    Sig::BIT_02C0,    // BIT $2C0 (Time Pilot)
+    Sig::STA_02C0,    // STA $2C0 (Fathom, Vanguard)
+    Sig::LDA_02C0     // LDA $2C0 (Mickey)
+  });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyWD(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyWD(const SignatureScan& scan)
 {
   // WD cart bankswitching switches banks by accessing address 0x30..0x3f
-  static constexpr uInt8 signature[1][3] = {
-    { 0xA5, 0x39, 0x4C }  // LDA $39, JMP
-  };
-  return searchForBytes(image, size, signature[0], 3);
+  return scan.found(Sig::LDA_39_JMP);  // LDA $39, JMP
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyX07(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyX07(const SignatureScan& scan)
 {
   // X07 bankswitching switches to bank 0, 1, 2, etc by accessing address 0x08xd
-  static constexpr uInt8 signature[6][3] = {
-    { 0xAD, 0x0D, 0x08 },  // LDA $080D
-    { 0xAD, 0x1D, 0x08 },  // LDA $081D
-    { 0xAD, 0x2D, 0x08 },  // LDA $082D
-    { 0x0C, 0x0D, 0x08 },  // NOP $080D
-    { 0x0C, 0x1D, 0x08 },  // NOP $081D
-    { 0x0C, 0x2D, 0x08 }   // NOP $082D
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 3))
-      return true;
-
-  return false;
+  return scan.foundAny({
+    Sig::LDA_080D,  // LDA $080D
+    Sig::LDA_081D,  // LDA $081D
+    Sig::LDA_082D,  // LDA $082D
+    Sig::NOP_080D,  // NOP $080D
+    Sig::NOP_081D,  // NOP $081D
+    Sig::NOP_082D   // NOP $082D
+  });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
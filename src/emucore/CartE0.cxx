@@ -47,26 +47,10 @@ void CartridgeE0::reset()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartridgeE0::checkSwitchBank(uInt16 address, uInt8)
+void CartridgeE0::setupHotspots()
 {
-  address &= ROM_MASK;
-
-  // Switch banks if necessary
-  if((address >= 0x0FE0) && (address <= 0x0FE7))
-  {
-    bank(address & 0x0007, 0);
-    return true;
-  }
-  else if((address >= 0x0FE8) && (address <= 0x0FEF))
-  {
-    bank(address & 0x0007, 1);
-    return true;
-  }
-  else if((address >= 0x0FF0) && (address <= 0x0FF7))
-  {
-    bank(address & 0x0007, 2);
-    return true;
-  }
-
-  return false;
+  // Each of the three lower segments has its own eight hotspots
+  addHotspots(0x1FE0, 8, 0, 0);
+  addHotspots(0x1FE8, 8, 0, 1);
+  addHotspots(0x1FF0, 8, 0, 2);
 }
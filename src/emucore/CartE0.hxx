@@ -85,10 +85,13 @@ class CartridgeE0 : public CartridgeEnhanced
   #endif
 
   private:
-    bool checkSwitchBank(uInt16 address, uInt8) override;
+    void setupHotspots() override;
 
     uInt16 hotspot() const override { return 0x1FE0; }
 
+    // Each of the three lower segments has its own 8 hotspots
+    uInt64 hotspotTraps() const override { return trapRange(hotspot(), 3 * 8); }
+
   private:
     // log(ROM bank segment size) / log(2)
     static constexpr uInt16 BANK_SHIFT = 10; // = 1K = 0x0400
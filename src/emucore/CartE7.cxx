@@ -80,8 +80,9 @@ void CartridgeE7::setAccess(uInt16 addrFrom, uInt16 size,
   {
     if(type == System::PageAccessType::READ)
       access.directPeekBase = &directData[directOffset + (addr & addrMask)];
-    else if(type == System::PageAccessType::WRITE)  // all RAM writes mapped to ::poke()
-      access.directPokeBase = nullptr;
+    else if(type == System::PageAccessType::WRITE)  // RAM writes mapped to ::poke() for RWP checks
+      access.directPokeBase = myRWPDetection ? nullptr
+                                             : &directData[directOffset + (addr & addrMask)];
     access.romAccessBase = &myRomAccessBase[codeOffset + (addr & addrMask)];
     access.romPeekCounter = &myRomAccessCounter[codeOffset + (addr & addrMask)];
     access.romPokeCounter = &myRomAccessCounter[codeOffset + (addr & addrMask) + myAccessSize];
@@ -279,6 +280,22 @@ bool CartridgeE7::bank(uInt16 bank, uInt16)
   return myBankChanged = true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeE7::enableRWPDetection(bool enable)
+{
+  Cartridge::enableRWPDetection(enable);
+
+  if(mySystem == nullptr)
+    return;
+
+  // Remap the write ports of the currently selected RAM
+  setAccess(0x1800, 0x100, 0x0400 + (myCurrentRAM << 8), myRAM.data(),
+            romSize() + BANK_SIZE / 2, System::PageAccessType::WRITE);
+  if(myCurrentBank[0] == myRAMBank)
+    setAccess(0x1000, BANK_SIZE / 2, 0, myRAM.data(), romSize(),
+              System::PageAccessType::WRITE);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt16 CartridgeE7::getBank(uInt16 address) const
 {
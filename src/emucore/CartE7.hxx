@@ -104,6 +104,14 @@ class CartridgeE7 : public Cartridge
     */
     bool bank(uInt16 bank, uInt16 segment = 0) override;
 
+    /**
+      Enable/disable the detection of reads from write ports (RWP), and
+      remap the RAM write ports accordingly.
+
+      @param enable  Whether RWP detection is required
+    */
+    void enableRWPDetection(bool enable) override;
+
     /**
       Get the current bank.
 
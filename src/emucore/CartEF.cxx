@@ -26,15 +26,7 @@ CartridgeEF::CartridgeEF(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartridgeEF::checkSwitchBank(uInt16 address, uInt8)
+void CartridgeEF::setupHotspots()
 {
-  address &= ROM_MASK;
-
-  // Switch banks if necessary
-  if((address >= 0x0FE0) && (address <= 0x0FEF))
-  {
-    bank(address - 0x0FE0);
-    return true;
-  }
-  return false;
+  addHotspots(0x1FE0, 16, 0);
 }
@@ -47,9 +47,9 @@ CartridgeEnhanced::CartridgeEnhanced(const ByteBuffer& image, size_t size,
 
   mySize = bsSize;
 
-  // Initialize ROM with all 0's, to fill areas that the ROM may not cover
+  // Initialize ROM with all 0's (done by make_unique), to fill areas that
+  // the ROM may not cover
   myImage = make_unique<uInt8[]>(mySize);
-  std::fill_n(myImage.get(), mySize, 0);
 
   // Directly copy the ROM image into the buffer
   // Only copy up to the amount of data the ROM provides; extra unused
@@ -93,18 +93,24 @@ void CartridgeEnhanced::install(System& system)
 
   mySystem = &system;
 
+  // Create the hotspot table
+  myHotspots.clear();
+  setupHotspots();
+
   if(myRomOffset > 0)
   {
     // Setup page access for extended RAM; banked RAM will be setup in bank()
     System::PageAccess access(this, System::PageAccessType::READ);
 
     // Set the page accessing method for the RAM writing pages
-    // Note: Writes are mapped to poke() (NOT using directPokeBase) to check for read from write port (RWP)
+    // Note: Writes are only mapped to poke() (NOT using directPokeBase) when
+    //       checking for read from write port (RWP)
     access.type = System::PageAccessType::WRITE;
     for(size_t addr = ROM_OFFSET + myWriteOffset; addr < ROM_OFFSET + myWriteOffset + myRamSize; addr += System::PAGE_SIZE)
     {
       const uInt16 offset = addr & myRamMask;
 
+      access.directPokeBase = myRWPDetection ? nullptr : &myRAM[offset];
       access.romAccessBase = &myRomAccessBase[myWriteOffset + offset];
       access.romPeekCounter = &myRomAccessCounter[myWriteOffset + offset];
       access.romPokeCounter = &myRomAccessCounter[myWriteOffset + offset + myAccessSize];
@@ -113,6 +119,7 @@ void CartridgeEnhanced::install(System& system)
 
     // Set the page accessing method for the RAM reading pages
     access.type = System::PageAccessType::READ;
+    access.directPokeBase = nullptr;
     for(size_t addr = ROM_OFFSET + myReadOffset; addr < ROM_OFFSET + myReadOffset + myRamSize; addr += System::PAGE_SIZE)
     {
       const size_t offset = addr & myRamMask;
@@ -125,6 +132,8 @@ void CartridgeEnhanced::install(System& system)
     }
   }
 
+  createBankPages();
+
   // Install pages for the startup bank (TODO: currently only in first bank segment)
   bank(startBank(), 0);
   if(mySize >= 4_KB && myBankSegs > 1)
@@ -161,7 +170,7 @@ uInt8 CartridgeEnhanced::peek(uInt16 address)
 
   // hotspots in TIA range are reacting to pokes only
   if(hotspot() >= 0x80)
-    if(checkSwitchBank(address & ADDR_MASK, 0) && myRandomHotspots)
+    if(switchBank(address, 0) && myRandomHotspots)
       return myRWPRandomValues[address & 0xFF];
 
   if(isRamBank(address))
@@ -194,7 +203,7 @@ bool CartridgeEnhanced::poke(uInt16 address, uInt8 value)
     return true;
 
   // Switch banks if necessary
-  if (checkSwitchBank(address & ADDR_MASK, value))
+  if (switchBank(address, value))
     return false;
 
   if(myRamSize > 0)
@@ -232,6 +241,95 @@ bool CartridgeEnhanced::poke(uInt16 address, uInt8 value)
   return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeEnhanced::createBankPages()
+{
+  // The page access methods of a bank don't depend on the segment it is
+  // mapped into, since segments are aligned to the bank size
+
+  // ROM banks; for ROMs < 4_KB, the whole address space will be mapped
+  myRomPages = (mySize < 4_KB ? 4_KB : myBankSize) >> System::PAGE_SHIFT;
+  myRomBankPages.assign(static_cast<size_t>(romBankCount()) * myRomPages,
+                        System::PageAccess(this, System::PageAccessType::READ));
+
+  for(uInt16 romBank = 0; romBank < romBankCount(); ++romBank)
+  {
+    const uInt32 bankOffset = romBank << myBankShift;
+
+    for(uInt16 page = 0; page < myRomPages; ++page)
+    {
+      System::PageAccess& access = myRomBankPages[romBank * myRomPages + page];
+      const uInt32 offset = bankOffset + ((page << System::PAGE_SHIFT) & myBankMask);
+
+      if(myDirectPeek)
+        access.directPeekBase = &myImage[offset];
+      access.romAccessBase = &myRomAccessBase[offset];
+      access.romPeekCounter = &myRomAccessCounter[offset];
+      access.romPokeCounter = &myRomAccessCounter[offset + myAccessSize];
+    }
+  }
+
+  // RAM banks, with separate write and read port pages
+  myRamPages = myRamBankCount > 0
+    ? (myBankSize >> (myBankShift - myRamBankShift)) >> System::PAGE_SHIFT : 0;
+  myRamBankPages.resize(static_cast<size_t>(myRamBankCount) * myRamPages * 2);
+
+  for(uInt16 ramBank = 0; ramBank < myRamBankCount; ++ramBank)
+  {
+    // The RAM banks follow the ROM banks and are half the size of a ROM bank
+    const uInt32 bankOffset = static_cast<uInt32>(mySize) + (ramBank << myRamBankShift);
+    System::PageAccess* access = &myRamBankPages[ramBank * myRamPages * 2];
+
+    for(uInt16 port = 0; port < 2; ++port)
+    {
+      // Note: Writes are only mapped to poke() (NOT using directPokeBase) when
+      //       checking for read from write port (RWP)
+      const bool write = port == 0;
+      const uInt16 fromAddr = (ROM_OFFSET + (write ? myWriteOffset : myReadOffset))
+        & ~System::PAGE_MASK;
+
+      for(uInt16 page = 0; page < myRamPages; ++page, ++access)
+      {
+        const uInt32 offset = bankOffset +
+          ((fromAddr + (page << System::PAGE_SHIFT)) & myRamMask);
+
+        *access = System::PageAccess(this, write ? System::PageAccessType::WRITE
+                                                 : System::PageAccessType::READ);
+        if(!write)
+          access->directPeekBase = &myRAM[offset - mySize];
+        else if(!myRWPDetection)
+          access->directPokeBase = &myRAM[offset - mySize];
+        access->romAccessBase = &myRomAccessBase[offset];
+        access->romPeekCounter = &myRomAccessCounter[offset];
+        access->romPokeCounter = &myRomAccessCounter[offset + myAccessSize];
+      }
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeEnhanced::addHotspots(uInt16 address, uInt16 count, uInt16 bank,
+                                    uInt16 segment)
+{
+  address &= ROM_MASK;
+
+  // Grow the table so that it covers all hotspots
+  if(myHotspots.empty())
+    myHotspotStart = address;
+  else if(address < myHotspotStart)
+  {
+    myHotspots.insert(myHotspots.begin(), myHotspotStart - address, Hotspot());
+    myHotspotStart = address;
+  }
+  const size_t end = address - myHotspotStart + count;
+  if(myHotspots.size() < end)
+    myHotspots.resize(end);
+
+  for(uInt16 i = 0; i < count; ++i)
+    myHotspots[address - myHotspotStart + i] =
+      Hotspot{static_cast<uInt16>(bank + i), segment};
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartridgeEnhanced::bank(uInt16 bank, uInt16 segment)
 {
@@ -244,79 +342,95 @@ bool CartridgeEnhanced::bank(uInt16 bank, uInt16 segment)
     // Setup ROM bank
     const uInt16 romBank = bank % romBankCount();
     // Remember what bank is in this segment
-    const uInt32 bankOffset = myCurrentSegOffset[segment] = romBank << myBankShift;
-    const uInt16 hotspot = this->hotspot();
-    const uInt16 hotSpotAddr = (hotspot & 0x1000) ? (hotspot & ~System::PAGE_MASK) : 0xFFFF;
-    const uInt16 plusROMAddr = (myPlusROM->isValid()) ? (0x1FF0 & ~System::PAGE_MASK) : 0xFFFF;
+    myCurrentSegOffset[segment] = romBank << myBankShift;
 
     // Skip extra RAM; if existing it is only mapped into first segment
-    const uInt16 fromAddr = (ROM_OFFSET + segmentOffset + (segment == 0 ? myRomOffset : 0)) & ~System::PAGE_MASK;
-    // for ROMs < 4_KB, the whole address space will be mapped.
-    const uInt16 toAddr   = (ROM_OFFSET + segmentOffset + (mySize < 4_KB ? 4_KB : myBankSize)) & ~System::PAGE_MASK;
+    const uInt16 skipPages = segment == 0 ? myRomOffset >> System::PAGE_SHIFT : 0;
+    const uInt16 fromAddr = ROM_OFFSET + segmentOffset + (skipPages << System::PAGE_SHIFT);
+    const uInt16 toAddr   = ROM_OFFSET + segmentOffset + (myRomPages << System::PAGE_SHIFT);
 
-    System::PageAccess access(this, System::PageAccessType::READ);
     // Setup the page access methods for the current bank
-    for(uInt16 addr = fromAddr; addr < toAddr; addr += System::PAGE_SIZE)
-    {
-      const uInt32 offset = bankOffset + (addr & myBankMask);
+    mySystem->setPageAccess(fromAddr, &myRomBankPages[romBank * myRomPages + skipPages],
+                            myRomPages - skipPages);
 
-      if(myDirectPeek && addr != hotSpotAddr && addr != plusROMAddr)
-        access.directPeekBase = &myImage[offset];
-      else
-        access.directPeekBase = nullptr;
-      access.romAccessBase = &myRomAccessBase[offset];
-      access.romPeekCounter = &myRomAccessCounter[offset];
-      access.romPokeCounter = &myRomAccessCounter[offset + myAccessSize];
-      mySystem->setPageAccess(addr, access);
+    if(myDirectPeek)
+    {
+      // Hotspot addresses must not be accessed directly
+      const uInt16 hotspot = this->hotspot();
+      const uInt16 hotSpotAddr = (hotspot & 0x1000) ? (hotspot & ~System::PAGE_MASK) : 0xFFFF;
+      const uInt16 plusROMAddr = (myPlusROM->isValid()) ? (0x1FF0 & ~System::PAGE_MASK) : 0xFFFF;
+
+      for(const uInt16 addr: {hotSpotAddr, plusROMAddr})
+        if(addr >= fromAddr && addr < toAddr)
+        {
+          System::PageAccess access = mySystem->getPageAccess(addr);
+
+          if(addr == hotSpotAddr)
+            access.peekTraps |= hotspotTraps();
+          if(addr == plusROMAddr)
+            access.peekTraps |= trapRange(0x1FF0, 4);
+          mySystem->setPageAccess(addr, access);
+        }
     }
   }
   else
   {
     // Setup RAM bank
     const uInt16 ramBank = (bank - romBankCount()) % myRamBankCount;
-    // The RAM banks follow the ROM banks and are half the size of a ROM bank
-    const uInt32 bankOffset = static_cast<uInt32>(mySize) +
-      (ramBank << myRamBankShift);
 
     // Remember what bank is in this segment
     myCurrentSegOffset[segment] = static_cast<uInt32>(mySize) +
       (ramBank << myBankShift);
 
-    // Set the page accessing method for the RAM writing pages
-    // Note: Writes are mapped to poke() (NOT using directPokeBase) to check for read from write port (RWP)
-    uInt16 fromAddr = (ROM_OFFSET + segmentOffset + myWriteOffset) & ~System::PAGE_MASK;
-    uInt16 toAddr   = (ROM_OFFSET + segmentOffset + myWriteOffset
-      + (myBankSize >> (myBankShift - myRamBankShift))) & ~System::PAGE_MASK;
-    System::PageAccess access(this, System::PageAccessType::WRITE);
+    installRamBankPages(ramBank, segmentOffset);
+  }
+  return myBankChanged = true;
+}
 
-    for(uInt16 addr = fromAddr; addr < toAddr; addr += System::PAGE_SIZE)
-    {
-      const uInt32 offset = bankOffset + (addr & myRamMask);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeEnhanced::installRamBankPages(uInt16 ramBank, uInt16 segmentOffset)
+{
+  // Set the page accessing methods for the RAM writing and reading pages
+  const System::PageAccess* access = &myRamBankPages[ramBank * myRamPages * 2];
 
-      access.romAccessBase = &myRomAccessBase[offset];
-      access.romPeekCounter = &myRomAccessCounter[offset];
-      access.romPokeCounter = &myRomAccessCounter[offset + myAccessSize];
-      mySystem->setPageAccess(addr, access);
-    }
+  mySystem->setPageAccess(ROM_OFFSET + segmentOffset + myWriteOffset,
+                          access, myRamPages);
+  mySystem->setPageAccess(ROM_OFFSET + segmentOffset + myReadOffset,
+                          access + myRamPages, myRamPages);
+}
 
-    // Set the page accessing method for the RAM reading pages
-    fromAddr = (ROM_OFFSET + segmentOffset + myReadOffset) & ~System::PAGE_MASK;
-    toAddr   = (ROM_OFFSET + segmentOffset + myReadOffset
-      + (myBankSize >> (myBankShift - myRamBankShift))) & ~System::PAGE_MASK;
-    access.type = System::PageAccessType::READ;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeEnhanced::enableRWPDetection(bool enable)
+{
+  const bool changed = enable != myRWPDetection;
 
-    for(uInt16 addr = fromAddr; addr < toAddr; addr += System::PAGE_SIZE)
+  Cartridge::enableRWPDetection(enable);
+
+  // Nothing to remap if there are no separate RAM write ports (yet)
+  if(!changed || mySystem == nullptr || myRamSize == 0 || myWriteOffset == myReadOffset)
+    return;
+
+  if(myRomOffset > 0)
+  {
+    // Extended RAM
+    for(size_t addr = ROM_OFFSET + myWriteOffset; addr < ROM_OFFSET + myWriteOffset + myRamSize; addr += System::PAGE_SIZE)
     {
-      const uInt32 offset = bankOffset + (addr & myRamMask);
+      System::PageAccess access = mySystem->getPageAccess(static_cast<uInt16>(addr));
 
-      access.directPeekBase = &myRAM[offset - mySize];
-      access.romAccessBase = &myRomAccessBase[offset];
-      access.romPeekCounter = &myRomAccessCounter[offset];
-      access.romPokeCounter = &myRomAccessCounter[offset + myAccessSize];
-      mySystem->setPageAccess(addr, access);
+      access.directPokeBase = enable ? nullptr : &myRAM[addr & myRamMask];
+      mySystem->setPageAccess(static_cast<uInt16>(addr), access);
     }
   }
-  return myBankChanged = true;
+  else
+  {
+    // Banked RAM, update the precomputed pages and the currently mapped banks
+    createBankPages();
+    for(uInt16 segment = 0; segment < myBankSegs; ++segment)
+      if(myCurrentSegOffset[segment] >= mySize)
+        installRamBankPages(
+          static_cast<uInt16>((myCurrentSegOffset[segment] - mySize) >> myBankShift),
+          segment << myBankShift);
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
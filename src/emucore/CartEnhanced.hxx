@@ -18,10 +18,9 @@
 #ifndef CARTRIDGEENHANCED_HXX
 #define CARTRIDGEENHANCED_HXX
 
-class System;
-
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "System.hxx"
 #include "PlusROM.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "CartEnhancedWidget.hxx"
@@ -75,6 +74,14 @@ class CartridgeEnhanced : public Cartridge
     */
     bool bank(uInt16 bank, uInt16 segment = 0) override;
 
+    /**
+      Enable/disable the detection of reads from write ports (RWP), and
+      remap the RAM write ports accordingly.
+
+      @param enable  Whether RWP detection is required
+    */
+    void enableRWPDetection(bool enable) override;
+
     /**
       Get the current bank.
 
@@ -186,6 +193,17 @@ class CartridgeEnhanced : public Cartridge
     virtual uInt16 hotspot() const { return 0; }
     // TODO: handle cases where there the hotspots cover multiple pages
 
+    /**
+      Get the addresses in the hotspot's page which must not be accessed
+      directly.  By default, these are the hotspot and the following
+      addresses, one for each ROM bank.
+
+      @return  The trapped page offsets as bitmask (see System::PageAccess)
+    */
+    virtual uInt64 hotspotTraps() const {
+      return trapRange(hotspot(), romBankCount());
+    }
+
     /**
       Answer whether this is a PlusROM cart.  Note that until the
       initialize method has been called, this will always return false.
@@ -270,6 +288,32 @@ class CartridgeEnhanced : public Cartridge
     // Handle PlusROM functionality, if available
     unique_ptr<PlusROM> myPlusROM;
 
+  private:
+    // The page access methods of all ROM banks, precomputed when installing,
+    // so that switching banks only copies them into the system
+    std::vector<System::PageAccess> myRomBankPages;
+
+    // The page access methods of all RAM banks (write port pages followed
+    // by read port pages for each bank)
+    std::vector<System::PageAccess> myRamBankPages;
+
+    // The number of pages mapped for a ROM bank and for a RAM bank port
+    uInt16 myRomPages{0};
+    uInt16 myRamPages{0};
+
+    // Marks addresses inside the hotspot range which are no hotspots
+    static constexpr uInt16 NO_HOTSPOT = 0xFFFF;
+
+    // The bank and segment switched to by each address in the hotspot range
+    struct Hotspot {
+      uInt16 bank{NO_HOTSPOT};
+      uInt16 segment{0};
+    };
+    std::vector<Hotspot> myHotspots;
+
+    // The first address of the hotspot range (in ROM address space)
+    uInt16 myHotspotStart{0};
+
   protected:
     // The mask for 6507 address space
     static constexpr uInt16 ADDR_MASK = 0x1FFF;
@@ -305,7 +349,41 @@ class CartridgeEnhanced : public Cartridge
 
       @return  True if a bank switch happened.
     */
-    virtual bool checkSwitchBank(uInt16 address, uInt8 value) = 0;
+    virtual bool checkSwitchBank(uInt16, uInt8) { return false; }
+
+    /**
+      Declare the hotspots of the cartridge by calling 'addHotspots'.
+      Carts which declare their hotspots this way are switched by a single
+      table lookup, 'checkSwitchBank' is not called for them anymore.
+    */
+    virtual void setupHotspots() { }
+
+    /**
+      Add a range of consecutive hotspots, each switching the given segment
+      to the bank following the one of the previous hotspot.
+
+      @param address  The address of the first hotspot
+      @param count    The number of hotspots
+      @param bank     The bank switched to by the first hotspot
+      @param segment  The segment the banks are switched into
+    */
+    void addHotspots(uInt16 address, uInt16 count, uInt16 bank, uInt16 segment = 0);
+
+    /**
+      Get the bitmask for trapping a range of addresses within a page
+      (limited to the end of the page).
+
+      @param address  The first address of the range
+      @param count    The number of addresses
+
+      @return  The trapped page offsets as bitmask (see System::PageAccess)
+    */
+    static constexpr uInt64 trapRange(uInt16 address, uInt16 count) {
+      const uInt16 offset = address & System::PAGE_MASK;
+      const uInt16 size = std::min<uInt16>(count, System::PAGE_SIZE - offset);
+
+      return (size < 64 ? (uInt64{1} << size) - 1 : ~uInt64{0}) << offset;
+    }
 
     /**
       Calculate the number of segments supported by the cartridge.
@@ -313,6 +391,40 @@ class CartridgeEnhanced : public Cartridge
     virtual uInt16 calcNumSegments() const;
 
   private:
+    /**
+      Precompute the page access methods of all ROM and RAM banks.
+    */
+    void createBankPages();
+
+    /**
+      Check the declared hotspots (or 'checkSwitchBank' if there are none)
+      and switch bank if triggered.
+
+      @param address  The address to check
+      @param value    The optional value used to determine the bank switched to
+
+      @return  True if a hotspot was accessed
+    */
+    bool switchBank(uInt16 address, uInt8 value) {
+      if(myHotspots.empty())
+        return checkSwitchBank(address & ADDR_MASK, value);
+
+      const uInt16 offset = static_cast<uInt16>((address & ROM_MASK) - myHotspotStart);
+      if(offset >= myHotspots.size() || myHotspots[offset].bank == NO_HOTSPOT)
+        return false;
+
+      bank(myHotspots[offset].bank, myHotspots[offset].segment);
+      return true;
+    }
+
+    /**
+      Install the precomputed pages of a RAM bank in the system.
+
+      @param ramBank        The RAM bank to install
+      @param segmentOffset  The offset of the segment in ROM address space
+    */
+    void installRamBankPages(uInt16 ramBank, uInt16 segmentOffset);
+
     /**
       Get the ROM's startup bank.
 
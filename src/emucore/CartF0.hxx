@@ -73,6 +73,9 @@ class CartridgeF0 : public CartridgeEnhanced
 
     uInt16 hotspot() const override { return 0x1FF0; }
 
+    // A single hotspot cycles through all banks
+    uInt64 hotspotTraps() const override { return trapRange(hotspot(), 1); }
+
     uInt16 getStartBank() const override { return 15; }
 
   private:
@@ -26,14 +26,7 @@ CartridgeF4::CartridgeF4(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartridgeF4::checkSwitchBank(uInt16 address, uInt8)
+void CartridgeF4::setupHotspots()
 {
-  // Switch banks if necessary
-  // Note: addresses could be calculated from hotspot and bank count
-  if((address >= 0x1FF4) && (address <= 0x1FFB))
-  {
-    bank(address - 0x1FF4);
-    return true;
-  }
-  return false;
+  addHotspots(0x1FF4, 8, 0);
 }
@@ -68,7 +68,7 @@ class CartridgeF4 : public CartridgeEnhanced
   #endif
 
   private:
-    bool checkSwitchBank(uInt16 address, uInt8) override;
+    void setupHotspots() override;
 
     uInt16 hotspot() const override { return 0x1FF4; }
 
@@ -26,14 +26,7 @@ CartridgeF6::CartridgeF6(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartridgeF6::checkSwitchBank(uInt16 address, uInt8)
+void CartridgeF6::setupHotspots()
 {
-  // Switch banks if necessary
-  // Note: addresses could be calculated from hotspot and bank count
-  if((address >= 0x1FF6) && (address <= 0x1FF9))
-  {
-    bank(address - 0x1FF6);
-    return true;
-  }
-  return false;
+  addHotspots(0x1FF6, 4, 0);
 }
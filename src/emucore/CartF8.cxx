@@ -26,23 +26,7 @@ CartridgeF8::CartridgeF8(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartridgeF8::checkSwitchBank(uInt16 address, uInt8)
+void CartridgeF8::setupHotspots()
 {
-  // Switch banks if necessary
-  switch(address)
-  {
-    case 0x1FF8:
-      // Set the current bank to the lower 4k bank
-      bank(0);
-      return true;
-
-    case 0x1FF9:
-      // Set the current bank to the upper 4k bank
-      bank(1);
-      return true;
-
-    default:
-      break;
-  }
-  return false;
+  addHotspots(0x1FF8, 2, 0);
 }
@@ -68,7 +68,7 @@ class CartridgeF8 : public CartridgeEnhanced
   #endif
 
   private:
-    bool checkSwitchBank(uInt16 address, uInt8 value) override;
+    void setupHotspots() override;
 
     uInt16 hotspot() const override { return 0x1FF8; }
 
@@ -28,15 +28,7 @@ CartridgeFA::CartridgeFA(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartridgeFA::checkSwitchBank(uInt16 address, uInt8)
+void CartridgeFA::setupHotspots()
 {
-  // Switch banks if necessary
-  if((address >= 0x1FF8) && (address <= 0x1FFA)/* && (mySystem->getDataBusState() & 1) */)
-  {
-    //if((mySystem->getDataBusState() & 1) == 0)
-    //cerr << std::hex << address << ": " << (mySystem->getDataBusState() & 1) << ", ";
-    bank(address - 0x1FF8);
-    return true;
-  }
-  return false;
+  addHotspots(0x1FF8, 3, 0);
 }
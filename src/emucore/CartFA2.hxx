@@ -108,10 +108,13 @@ class CartridgeFA2 : public CartridgeFA
     bool poke(uInt16 address, uInt8 value) override;
 
   private:
-    bool checkSwitchBank(uInt16 address, uInt8 value) override;
+    void setupHotspots() override;
 
     uInt16 hotspot() const override { return 0x1FF5; }
 
+    // Also trap the Harmony flash access at $1FF4
+    uInt64 hotspotTraps() const override { return trapRange(0x1FF4, 1 + 7); }
+
     uInt16 getStartBank() const override { return 0; }
 
     /**
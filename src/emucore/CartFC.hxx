@@ -94,6 +94,9 @@ class CartridgeFC : public CartridgeEnhanced
 
     uInt16 hotspot() const override { return 0x1FF8; }
 
+    // $1FF8/9 are only written, reading $1FFC triggers the bank switch
+    uInt64 hotspotTraps() const override { return trapRange(0x1FFC, 1); }
+
     // Target bank defined by writing to $1FF8/9
     uInt16 myTargetBank{0};
 
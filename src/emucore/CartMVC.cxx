@@ -15,6 +15,11 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "MappedFile.hxx"
 #include "Serializer.hxx"
 #include "Serializable.hxx"
 #include "System.hxx"
@@ -45,24 +50,65 @@ namespace {
   constexpr int BACK_SECONDS = 10;
 
   constexpr int TITLE_CYCLES = 1000000;
+
+  // Number of upcoming fields read ahead when memory mapped (~2 seconds)
+  constexpr int PREFETCH_FIELDS = 120;
+  // Number of fields read ahead at the target of the 'back' control
+  constexpr int PREFETCH_BACK_FIELDS = 4;
 } // namespace
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 /**
   Simulate retrieval 512 byte chunks from a serial source
+
+  If possible, the movie is memory mapped, and a thread reads the upcoming
+  fields into a prefetch buffer, so that reading a field never blocks the
+  emulation (e.g. for movies on slow network storage).  Otherwise the fields
+  are read from the file.
 */
 class StreamReader : public Serializable
 {
   public:
     StreamReader() { myBuffer1.fill(0);  myBuffer2.fill(0); }
+    ~StreamReader() override { close(); }
 
     bool open(string_view path) {
+      close();
+
+      if(myMapping.open(string{path}))
+      {
+        myFileSize = myMapping.size();
+        myMapping.advise(MappedFile::Access::Sequential);
+        myStopPrefetch = false;
+        myPrefetchField = myPrefetchedField = -1;
+        myPrefetchBuffer = vector<PrefetchedField>(PREFETCH_FIELDS +
+                                                   PREFETCH_BACK_FIELDS);
+        myPrefetchThread = std::thread([this] { prefetchFields(); });
+
+        return true;
+      }
+
       myFile = Serializer(path, Serializer::Mode::ReadOnly);
       myFileSize = myFile ? myFile.size() : 0;
 
       return static_cast<bool>(myFile);
     }
 
+    void close() {
+      if(myPrefetchThread.joinable())
+      {
+        {
+          const std::lock_guard<std::mutex> lock(myPrefetchMutex);
+          myStopPrefetch = true;
+        }
+        myPrefetchCondition.notify_one();
+        myPrefetchThread.join();
+      }
+      myPrefetchBuffer.clear();
+      myMapping.close();
+      myFileSize = 0;
+    }
+
     [[nodiscard]] bool isValid() const {
       return myFileSize > 0;
     }
@@ -158,7 +204,24 @@ class StreamReader : public Serializable
     }
 
     bool readField(uInt32 fnum, bool index) {
-      if(myFile)
+      if(myMapping.isValid())
+      {
+        const size_t offset = ((fnum + 0) * CartridgeMVC::MVC_FIELD_SIZE);
+
+        if(offset + CartridgeMVC::MVC_FIELD_SIZE <= myFileSize)
+        {
+          // Only fields which haven't been prefetched (yet) are read here
+          uInt8* buffer = index ? myBuffer1.data() : myBuffer2.data();
+          if(!readPrefetched(static_cast<Int32>(fnum), buffer) &&
+             myMapping.read(offset, buffer, CartridgeMVC::MVC_FIELD_SIZE) !=
+               CartridgeMVC::MVC_FIELD_SIZE)
+            return false;
+          prefetch(static_cast<Int32>(fnum));
+
+          return true;
+        }
+      }
+      else if(myFile)
       {
         const size_t offset = ((fnum + 0) * CartridgeMVC::MVC_FIELD_SIZE);
 
@@ -240,6 +303,133 @@ class StreamReader : public Serializable
       return true;
     }
 
+  private:
+    // A field read ahead by the prefetch thread
+    struct PrefetchedField {
+      Int32 field{-1};  // -1 while unused or being read
+      std::array<uInt8, CartridgeMVC::MVC_FIELD_SIZE> data;
+    };
+
+    /**
+      Copy the given field from the prefetch buffer, if it's there.
+    */
+    bool readPrefetched(Int32 field, uInt8* buffer) {
+      const std::lock_guard<std::mutex> lock(myPrefetchMutex);
+      for(const auto& prefetched: myPrefetchBuffer)
+        if(prefetched.field == field)
+        {
+          std::copy(prefetched.data.begin(), prefetched.data.end(), buffer);
+          return true;
+        }
+      return false;
+    }
+
+    /**
+      Tell the prefetch thread which field has just been read.
+    */
+    void prefetch(Int32 field) {
+      {
+        const std::lock_guard<std::mutex> lock(myPrefetchMutex);
+        if(field == myPrefetchField)
+          return;
+
+        // Normal playback (and stepping while paused) moves by one field,
+        // fast forward and rewind by the speed; anything else is a jump
+        const Int32 step = field - myPrefetchField;
+        if(std::abs(step) > 128)
+          myPrefetchStep = 1;
+        else if(std::abs(step) > 2)
+          myPrefetchStep = step;
+        else
+          myPrefetchStep = step < 0 ? -1 : 1;
+        myPrefetchField = field;
+      }
+      myPrefetchCondition.notify_one();
+    }
+
+    /**
+      The prefetch thread, reads the fields which will be read next into the
+      prefetch buffer.
+    */
+    void prefetchFields() {
+      std::unique_lock<std::mutex> lock(myPrefetchMutex);
+      // Fields prefetched during normal playback
+      Int32 residentStart = -1, residentEnd = -1;
+
+      while(true)
+      {
+        myPrefetchCondition.wait(lock, [this] {
+          return myStopPrefetch || myPrefetchField != myPrefetchedField;
+        });
+        if(myStopPrefetch)
+          break;
+
+        const Int32 field = myPrefetchedField = myPrefetchField;
+        const Int32 step = myPrefetchStep;
+
+        // During normal playback, only refresh when half of the prefetched
+        // fields have been played
+        if(step == 1 && field >= residentStart &&
+           field + PREFETCH_FIELDS / 2 <= residentEnd)
+          continue;
+        residentStart = field;
+        residentEnd = step == 1 ? field + PREFETCH_FIELDS : -1;
+        lock.unlock();
+
+        // The upcoming fields, and the target of the 'back' control
+        const auto fieldOffset = [](Int32 f) {
+          return static_cast<size_t>(f) * CartridgeMVC::MVC_FIELD_SIZE;
+        };
+        const Int32 back = std::max(field - 60 * BACK_SECONDS, 0);
+        vector<Int32> fields;
+        for(Int32 i = 1, f = field + step; i <= PREFETCH_FIELDS && f >= 0 &&
+            fieldOffset(f + 1) <= myFileSize; ++i, f += step)
+          fields.push_back(f);
+        for(Int32 f = back; f < back + PREFETCH_BACK_FIELDS &&
+            fieldOffset(f + 1) <= myFileSize; ++f)
+          if(std::find(fields.begin(), fields.end(), f) == fields.end())
+            fields.push_back(f);
+
+        // Let the OS page in the fields, while they are read one by one
+        if(step == 1)
+          myMapping.willNeed(fieldOffset(field + 1),
+                             fieldOffset(PREFETCH_FIELDS));
+        else
+          for(const Int32 f: fields)
+            myMapping.willNeed(fieldOffset(f), CartridgeMVC::MVC_FIELD_SIZE);
+        myMapping.willNeed(fieldOffset(back), fieldOffset(PREFETCH_BACK_FIELDS));
+
+        // Fields which are no longer needed are replaced, all others kept
+        lock.lock();
+        vector<PrefetchedField*> unused;
+        for(auto& prefetched: myPrefetchBuffer)
+        {
+          const auto f = std::find(fields.begin(), fields.end(), prefetched.field);
+          if(f != fields.end())
+            fields.erase(f);
+          else
+          {
+            prefetched.field = -1;
+            unused.push_back(&prefetched);
+          }
+        }
+
+        // The buffer of a field being read is not accessed by the emulation,
+        // since it's marked as unused
+        for(size_t i = 0; i < fields.size() && !myStopPrefetch; ++i)
+        {
+          lock.unlock();
+          const bool success =
+            myMapping.read(fieldOffset(fields[i]), unused[i]->data.data(),
+                           CartridgeMVC::MVC_FIELD_SIZE) ==
+              CartridgeMVC::MVC_FIELD_SIZE;
+          lock.lock();
+          if(success)
+            unused[i]->field = fields[i];
+        }
+      }
+    }
+
   private:
     const uInt8*  myAudio{nullptr};
 
@@ -261,6 +451,16 @@ class StreamReader : public Serializable
 
     Serializer myFile;
     size_t myFileSize{0};
+
+    MappedFile myMapping;
+    vector<PrefetchedField> myPrefetchBuffer;
+    std::thread myPrefetchThread;
+    std::mutex myPrefetchMutex;
+    std::condition_variable myPrefetchCondition;
+    Int32 myPrefetchField{-1};    // the field read last
+    Int32 myPrefetchedField{-1};  // the field the prefetching is based on
+    Int32 myPrefetchStep{1};
+    bool myStopPrefetch{false};
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
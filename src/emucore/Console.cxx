@@ -43,6 +43,7 @@
 #include "Paddles.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "AutodetectCache.hxx"
 #include "SaveKey.hxx"
 #include "Settings.hxx"
 #include "Sound.hxx"
@@ -145,6 +146,12 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
 
   // Construct the system and components
   mySystem = make_unique<System>(myOSystem.random(), *my6502, *myRiot, *myTIA, *myCart);
+#ifdef DEBUGGER_SUPPORT
+  // Accesses are only tracked for the disassembly when developer settings
+  // are enabled, otherwise tracking starts when the debugger is entered
+  if(!myOSystem.settings().getBool("dev.settings"))
+    mySystem->setAccessTracking(System::AccessTracking::off);
+#endif
 
   // The real controllers for this console will be added later
   // For now, we just add dummy joystick controllers, since autodetection
@@ -183,7 +190,17 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
 
   if(myDisplayFormat == "AUTO" || myOSystem.settings().getBool("rominfo"))
   {
-    autodetectFrameLayout();
+    // Use the layout detected at a previous launch, if available
+    const Settings& settings = myOSystem.settings();
+    const string format = settings.getBool("rominfo") ? EmptyString
+      : myOSystem.autodetectCache().frameLayout(myProperties.get(PropType::Cart_MD5),
+          myCart->detectedType(),
+          settings.getBool("detectpal60"), settings.getBool("detectntsc50"));
+
+    if(!format.empty())
+      myDisplayFormat = format;
+    else
+      autodetectFrameLayout();
 
     if(myProperties.get(PropType::Display_Format) == "AUTO")
     {
@@ -311,8 +328,10 @@ void Console::autodetectFrameLayout(bool reset)
   for(int i = 0; i < 40; ++i)
     myTIA->update();
 
-  switch(frameLayoutDetector.detectedLayout(
-    settings.getBool("detectpal60"), settings.getBool("detectntsc50"),
+  const bool detectPal60 = settings.getBool("detectpal60"),
+             detectNtsc50 = settings.getBool("detectntsc50");
+
+  switch(frameLayoutDetector.detectedLayout(detectPal60, detectNtsc50,
     myProperties.get(PropType::Cart_Name)))
   {
     case FrameLayout::pal:
@@ -331,6 +350,8 @@ void Console::autodetectFrameLayout(bool reset)
       myDisplayFormat = "NTSC";
       break;
   }
+  myOSystem.autodetectCache().setFrameLayout(myProperties.get(PropType::Cart_MD5),
+      myCart->detectedType(), myDisplayFormat, detectPal60, detectNtsc50);
 
   myTIA->setFrameManager(myFrameManager.get());
 
@@ -887,11 +908,17 @@ void Console::createAudioQueue()
   const bool useStereo = myOSystem.settings().getBool(AudioSettings::SETTING_STEREO)
     || myProperties.get(PropType::Cart_Sound) == "STEREO";
 
-  myAudioQueue = make_shared<AudioQueue>(
+  auto audioQueue = make_shared<AudioQueue>(
     myEmulationTiming.audioFragmentSize(),
     myEmulationTiming.audioQueueCapacity(),
     useStereo
   );
+
+  // Keep a running A/V capture attached to the new queue
+  if(myAudioQueue)
+    audioQueue->setFragmentCallback(myAudioQueue->fragmentCallback());
+
+  myAudioQueue = std::move(audioQueue);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -933,10 +960,10 @@ void Console::setControllers(string_view romMd5)
     if(image != nullptr && size != 0)
     {
       Logger::debug(myProperties.get(PropType::Cart_Name) + ":");
-      leftType = ControllerDetector::detectType(image, size, leftType,
-          !swappedPorts ? Controller::Jack::Left : Controller::Jack::Right, myOSystem.settings());
-      rightType = ControllerDetector::detectType(image, size, rightType,
-          !swappedPorts ? Controller::Jack::Right : Controller::Jack::Left, myOSystem.settings());
+      leftType = detectControllerType(image, size, leftType,
+          !swappedPorts ? Controller::Jack::Left : Controller::Jack::Right, romMd5);
+      rightType = detectControllerType(image, size, rightType,
+          !swappedPorts ? Controller::Jack::Right : Controller::Jack::Left, romMd5);
     }
 
     unique_ptr<Controller>
@@ -965,6 +992,31 @@ void Console::setControllers(string_view romMd5)
   myOSystem.eventHandler().setMouseControllerMode(myOSystem.settings().getString("usemouse"));
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Controller::Type Console::detectControllerType(const ByteBuffer& image,
+    size_t size, Controller::Type type, Controller::Jack port, string_view romMd5)
+{
+  const Settings& settings = myOSystem.settings();
+
+  // Use the type detected at a previous launch, if available
+  if(type == Controller::Type::Unknown && !settings.getBool("rominfo"))
+  {
+    const Controller::Type cachedType =
+        myOSystem.autodetectCache().controllerType(romMd5, port);
+
+    if(cachedType != Controller::Type::Unknown)
+      return cachedType;
+  }
+
+  const Controller::Type detectedType =
+      ControllerDetector::detectType(image, size, type, port, settings);
+
+  if(type == Controller::Type::Unknown || settings.getBool("rominfo"))
+    myOSystem.autodetectCache().setControllerType(romMd5, port, detectedType);
+
+  return detectedType;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Console::changeLeftController(int direction)
 {
@@ -187,6 +187,11 @@ class Console : public Serializable, public ConsoleIO
      */
     EmulationTiming& emulationTiming() { return myEmulationTiming; }
 
+    /**
+      Retrieve the audio queue filled by the TIA.
+     */
+    AudioQueue& audioQueue() const { return *myAudioQueue; }
+
     /**
       Toggle left and right controller ports swapping
     */
@@ -425,6 +430,13 @@ class Console : public Serializable, public ConsoleIO
      */
     void createAudioQueue();
 
+    /**
+      Detects the controller type for the given port, using the results
+      of previous launches when available
+    */
+    Controller::Type detectControllerType(const ByteBuffer& image, size_t size,
+        Controller::Type type, Controller::Jack port, string_view romMd5);
+
     /**
       Selects the left or right controller depending on ROM properties
     */
@@ -42,6 +42,7 @@
 #include "M6532.hxx"
 #include "MouseControl.hxx"
 #include "PNGLibrary.hxx"
+#include "AVCapture.hxx"
 #include "TIASurface.hxx"
 
 #include "EventHandler.hxx"
@@ -299,6 +300,11 @@ void EventHandler::poll(uInt64 time)
   }
 #endif
 
+#ifdef IMAGE_SUPPORT
+  // Show the result of snapshots written in the background
+  myOSystem.png().reportSnapshots();
+#endif
+
   // Turn off all mouse-related items; if they haven't been taken care of
   // in the previous ::update() methods, they're now invalid
   myEvent.set(Event::MouseAxisXMove, 0);
@@ -1547,6 +1553,10 @@ void EventHandler::handleEvent(Event::Type event, Int32 value, bool repeated)
       return;
   #endif
 
+    case Event::ToggleAVCapture:
+      if(pressed && !repeated) myOSystem.capture().toggle();
+      return;
+
     case Event::TakeSnapshot:
       if(pressed && !repeated) myOSystem.frameBuffer().tiaSurface().saveSnapShot();
       return;
@@ -2885,6 +2895,7 @@ EventHandler::EmulActionList EventHandler::ourEmulActionList = { {
   { Event::ToggleContSnapshots,     "Save continuous snapsh. (as defined)"  },
   { Event::ToggleContSnapshotsFrame,"Save continuous snapsh. (every frame)" },
 #endif
+  { Event::ToggleAVCapture,         "Start/stop A/V capture"                },
   // Global keys:
   { Event::PreviousSettingGroup,    "Select previous setting group"         },
   { Event::NextSettingGroup,        "Select next setting group"             },
@@ -3176,6 +3187,7 @@ const Event::EventSet EventHandler::MiscEvents = {
   Event::ToggleBezel, Event::PlusRomsSetupMode, Event::ExitMode,
   Event::ToggleTurbo, Event::DecreaseSpeed, Event::IncreaseSpeed,
   Event::TakeSnapshot, Event::ToggleContSnapshots, Event::ToggleContSnapshotsFrame,
+  Event::ToggleAVCapture,
   // Event::MouseAxisXMove, Event::MouseAxisYMove,
   // Event::MouseButtonLeftValue, Event::MouseButtonRightValue,
   Event::HighScoresMenuMode,
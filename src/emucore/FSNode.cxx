@@ -335,6 +335,12 @@ size_t FSNode::getSize() const
   return (_realNode && _realNode->exists()) ? _realNode->getSize() : 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 FSNode::getModificationTime() const
+{
+  return _realNode ? _realNode->getModificationTime() : 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 size_t FSNode::read(ByteBuffer& buffer, size_t size) const
 {
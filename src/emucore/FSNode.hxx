@@ -250,6 +250,13 @@ class FSNode
      */
     size_t getSize() const;
 
+    /**
+     * Get the last modification time of the current node path.
+     *
+     * @return  Modification time (in seconds since the epoch), or 0 if unknown
+     */
+    uInt64 getModificationTime() const;
+
     /**
      * Read data (binary format) into the given buffer.
      *
@@ -452,6 +459,13 @@ class AbstractFSNode
      */
     virtual size_t getSize() const { return 0; }
 
+    /**
+     * Get the last modification time of the current node path.
+     *
+     * @return  Modification time (in seconds since the epoch), or 0 if unknown
+     */
+    virtual uInt64 getModificationTime() const { return 0; }
+
     /**
      * Read data (binary format) into the given buffer.
      *
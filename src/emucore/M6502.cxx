@@ -65,8 +65,8 @@ void M6502::reset()
   myExecutionStatus = 0;
 
   // Set registers to random or default values
-  const bool devSettings = mySettings.getBool("dev.settings");
-  const string& cpurandom = mySettings.getString(devSettings ? "dev.cpurandom" : "plr.cpurandom");
+  const auto settings = mySettings.emulation();
+  const string& cpurandom = settings->cpuRandom;
   SP = BSPF::containsIgnoreCase(cpurandom, "S") ?
           mySystem->randGenerator().next() : 0xfd;
   A  = BSPF::containsIgnoreCase(cpurandom, "A") ?
@@ -83,7 +83,7 @@ void M6502::reset()
   // Load PC from the reset vector
   PC = static_cast<uInt16>(mySystem->peek(0xfffc)) | (static_cast<uInt16>(mySystem->peek(0xfffd)) << 8);
 
-  myLastAddress = myLastPeekAddress = myLastPokeAddress =
+  myLastPeekAddress = myLastPokeAddress =
     myLastPeekBaseAddress = myLastPokeBaseAddress = 0;
   myLastSrcAddressS = myLastSrcAddressA =
     myLastSrcAddressX = myLastSrcAddressY = -1;
@@ -91,11 +91,11 @@ void M6502::reset()
   myFlags = DISASM_NONE;
 
   myHaltRequested = false;
-  myGhostReadsTrap = mySettings.getBool("dbg.ghostreadstrap");
-  myReadFromWritePortBreak = devSettings ? mySettings.getBool("dev.rwportbreak") : false;
-  myWriteToReadPortBreak = devSettings ? mySettings.getBool("dev.wrportbreak") : false;
-  myLogBreaks = mySettings.getBool("dbg.logbreaks");
-  myLogTrace = mySettings.getBool("dbg.logtrace");
+  myGhostReadsTrap = settings->ghostReadsTrap;
+  myReadFromWritePortBreak = settings->readFromWritePortBreak;
+  myWriteToReadPortBreak = settings->writeToReadPortBreak;
+  myLogBreaks = settings->logBreaks;
+  myLogTrace = settings->logTrace;
 
   myLastBreakCycle = ULLONG_MAX;
 }
@@ -105,14 +105,9 @@ inline uInt8 M6502::peek(uInt16 address, Device::AccessFlags flags)
 {
   handleHalt();
 
-  ////////////////////////////////////////////////
-  // TODO - move this logic directly into CartAR
-  if(address != myLastAddress)
-  {
-    ++myNumberOfDistinctAccesses;
-    myLastAddress = address;
-  }
-  ////////////////////////////////////////////////
+  if(myBusObserver)
+    myBusObserver->busAccess(address);
+
   mySystem->incrementCycles(SYSTEM_CYCLES_PER_CPU);
   icycles += SYSTEM_CYCLES_PER_CPU;
   myFlags = flags;
@@ -143,14 +138,9 @@ inline uInt8 M6502::peek(uInt16 address, Device::AccessFlags flags)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline void M6502::poke(uInt16 address, uInt8 value, Device::AccessFlags flags)
 {
-  ////////////////////////////////////////////////
-  // TODO - move this logic directly into CartAR
-  if(address != myLastAddress)
-  {
-    ++myNumberOfDistinctAccesses;
-    myLastAddress = address;
-  }
-  ////////////////////////////////////////////////
+  if(myBusObserver)
+    myBusObserver->busAccess(address);
+
   mySystem->incrementCycles(SYSTEM_CYCLES_PER_CPU);
   icycles += SYSTEM_CYCLES_PER_CPU;
   mySystem->poke(address, value, flags);
@@ -497,10 +487,7 @@ bool M6502::save(Serializer& out) const
 
     out.putByte(myExecutionStatus);
 
-    // Indicates the number of distinct memory accesses
-    out.putInt(myNumberOfDistinctAccesses);
     // Indicates the last addresses which were accessed
-    out.putShort(myLastAddress);
     out.putShort(myLastPeekAddress);
     out.putShort(myLastPokeAddress);
     out.putShort(myDataAddressForPoke);
@@ -544,10 +531,7 @@ bool M6502::load(Serializer& in)
 
     myExecutionStatus = in.getByte();
 
-    // Indicates the number of distinct memory accesses
-    myNumberOfDistinctAccesses = in.getInt();
     // Indicates the last addresses which were accessed
-    myLastAddress = in.getShort();
     myLastPeekAddress = in.getShort();
     myLastPokeAddress = in.getShort();
     myDataAddressForPoke = in.getShort();
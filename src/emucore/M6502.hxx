@@ -60,6 +60,23 @@ class M6502 : public Serializable
 
     using onHaltCallback = std::function<void()>;
 
+    /**
+      Interface for devices which have to know about each memory access of
+      the CPU (e.g. the Supercharger, which times its RAM writes this way).
+    */
+    class BusObserver
+    {
+      public:
+        virtual ~BusObserver() = default;
+
+        /**
+          Called by the CPU before it accesses the given address.
+
+          @param address  The address accessed
+        */
+        virtual void busAccess(uInt16 address) = 0;
+    };
+
   public:
     /**
       Create a new 6502 microprocessor.
@@ -203,11 +220,12 @@ class M6502 : public Serializable
     Int32 lastSrcAddressY() const { return myLastSrcAddressY; }
 
     /**
-      Get the number of memory accesses to distinct memory locations
+      Set the device which is informed about each memory access of the CPU.
+      Only one observer is supported, nullptr removes it.
 
-      @return The number of memory accesses to distinct memory locations
+      @param observer  The observer to use
     */
-    uInt32 distinctAccesses() const { return myNumberOfDistinctAccesses; }
+    void setBusObserver(BusObserver* observer) { myBusObserver = observer; }
 
     /**
       Saves the current state of this device to the given Serializer.
@@ -391,11 +409,8 @@ class M6502 : public Serializable
 
     uInt8 icycles{0}; // cycles of last instruction
 
-    /// Indicates the numer of distinct memory accesses
-    uInt32 myNumberOfDistinctAccesses{0};
-
-    /// Indicates the last address which was accessed
-    uInt16 myLastAddress{0};
+    /// The device informed about each memory access (if any)
+    BusObserver* myBusObserver{nullptr};
 
     /// Last cycle that triggered a breakpoint
     uInt64 myLastBreakCycle{ULLONG_MAX};
@@ -45,10 +45,10 @@ void M6532::reset()
   };
 
   // Initialize the 128 bytes of memory
-  const bool devSettings = mySettings.getBool("dev.settings");
-  if(mySettings.getString(devSettings ? "dev.console" : "plr.console") == "7800")
+  const auto settings = mySettings.emulation();
+  if(settings->console7800)
     std::copy_n(RAM_7800.begin(), RAM_7800.size(), myRAM.begin());
-  else if(mySettings.getBool(devSettings ? "dev.ramrandom" : "plr.ramrandom"))
+  else if(settings->ramRandom)
     for(auto& ram: myRAM)
       ram = mySystem->randGenerator().next();
   else
@@ -18,6 +18,8 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <numeric>
+
 #include "MD5.hxx"
 
 // Constants for MD5Transform routine.
@@ -39,6 +41,153 @@ namespace {
     S42 = 10,
     S43 = 15,
     S44 = 21;
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Multi-buffer MD5
+  //
+  // The messages are processed in lanes, each lane holding one word of a
+  // different message.  All operations are simple loops over the lanes,
+  // which are vectorized by the compiler (SSE2/AVX2/NEON, depending on the
+  // target).
+  /////////////////////////////////////////////////////////////////////////////
+  using Lanes = std::array<uInt32, MD5::LANES>;
+
+  // The basic MD5 functions (see MD5::F() etc.)
+  constexpr auto F = [](uInt32 x, uInt32 y, uInt32 z) { return (x&y) | (~x&z); };
+  constexpr auto G = [](uInt32 x, uInt32 y, uInt32 z) { return (x&z) | (y&~z); };
+  constexpr auto H = [](uInt32 x, uInt32 y, uInt32 z) { return x^y^z; };
+  constexpr auto I = [](uInt32 x, uInt32 y, uInt32 z) { return y ^ (x | ~z); };
+
+  // One MD5 operation for all lanes (see MD5::FF() etc.)
+  template<typename Func>
+  FORCE_INLINE void step(Func func, Lanes& a, const Lanes& b, const Lanes& c,
+                         const Lanes& d, const Lanes& x, uInt32 s, uInt32 ac)
+  {
+    for(size_t l = 0; l < MD5::LANES; ++l)
+    {
+      const uInt32 t = a[l] + func(b[l], c[l], d[l]) + x[l] + ac;
+      a[l] = ((t << s) | (t >> (32 - s))) + b[l];
+    }
+  }
+
+  // A message of one lane, split into blocks
+  struct LaneMessage
+  {
+    const uInt8* data{nullptr};
+    size_t fullBlocks{0};     // the blocks taken directly from the message
+    size_t blocks{0};         // all blocks, including the padding
+    std::array<uInt8, 128> tail{};  // the rest of the message and padding
+
+    void init(string_view message)
+    {
+      data = reinterpret_cast<const uInt8*>(message.data());
+      fullBlocks = message.size() / 64;
+
+      // Pad out to 56 mod 64 and append the length in bits
+      const size_t rest = message.size() % 64;
+      const size_t tailSize = rest < 56 ? 64 : 128;
+      std::copy_n(data + fullBlocks * 64, rest, tail.data());
+      tail[rest] = 0x80;
+      const uInt64 bits = static_cast<uInt64>(message.size()) << 3;
+      for(size_t i = 0; i < 8; ++i)
+        tail[tailSize - 8 + i] = static_cast<uInt8>(bits >> (i * 8));
+
+      blocks = fullBlocks + tailSize / 64;
+    }
+
+    const uInt8* block(size_t i) const
+    {
+      return i < fullBlocks ? data + i * 64 : tail.data() + (i - fullBlocks) * 64;
+    }
+  };
+
+  // Apply MD5 algo on one block of each lane (see MD5::transform())
+  void transformLanes(std::array<Lanes, 4>& state, const std::array<Lanes, 16>& x,
+                      const Lanes& active)
+  {
+    Lanes a = state[0], b = state[1], c = state[2], d = state[3];
+
+    /* Round 1 */
+    step(F, a, b, c, d, x[ 0], S11, 0xd76aa478); /* 1 */
+    step(F, d, a, b, c, x[ 1], S12, 0xe8c7b756); /* 2 */
+    step(F, c, d, a, b, x[ 2], S13, 0x242070db); /* 3 */
+    step(F, b, c, d, a, x[ 3], S14, 0xc1bdceee); /* 4 */
+    step(F, a, b, c, d, x[ 4], S11, 0xf57c0faf); /* 5 */
+    step(F, d, a, b, c, x[ 5], S12, 0x4787c62a); /* 6 */
+    step(F, c, d, a, b, x[ 6], S13, 0xa8304613); /* 7 */
+    step(F, b, c, d, a, x[ 7], S14, 0xfd469501); /* 8 */
+    step(F, a, b, c, d, x[ 8], S11, 0x698098d8); /* 9 */
+    step(F, d, a, b, c, x[ 9], S12, 0x8b44f7af); /* 10 */
+    step(F, c, d, a, b, x[10], S13, 0xffff5bb1); /* 11 */
+    step(F, b, c, d, a, x[11], S14, 0x895cd7be); /* 12 */
+    step(F, a, b, c, d, x[12], S11, 0x6b901122); /* 13 */
+    step(F, d, a, b, c, x[13], S12, 0xfd987193); /* 14 */
+    step(F, c, d, a, b, x[14], S13, 0xa679438e); /* 15 */
+    step(F, b, c, d, a, x[15], S14, 0x49b40821); /* 16 */
+
+    /* Round 2 */
+    step(G, a, b, c, d, x[ 1], S21, 0xf61e2562); /* 17 */
+    step(G, d, a, b, c, x[ 6], S22, 0xc040b340); /* 18 */
+    step(G, c, d, a, b, x[11], S23, 0x265e5a51); /* 19 */
+    step(G, b, c, d, a, x[ 0], S24, 0xe9b6c7aa); /* 20 */
+    step(G, a, b, c, d, x[ 5], S21, 0xd62f105d); /* 21 */
+    step(G, d, a, b, c, x[10], S22,  0x2441453); /* 22 */
+    step(G, c, d, a, b, x[15], S23, 0xd8a1e681); /* 23 */
+    step(G, b, c, d, a, x[ 4], S24, 0xe7d3fbc8); /* 24 */
+    step(G, a, b, c, d, x[ 9], S21, 0x21e1cde6); /* 25 */
+    step(G, d, a, b, c, x[14], S22, 0xc33707d6); /* 26 */
+    step(G, c, d, a, b, x[ 3], S23, 0xf4d50d87); /* 27 */
+    step(G, b, c, d, a, x[ 8], S24, 0x455a14ed); /* 28 */
+    step(G, a, b, c, d, x[13], S21, 0xa9e3e905); /* 29 */
+    step(G, d, a, b, c, x[ 2], S22, 0xfcefa3f8); /* 30 */
+    step(G, c, d, a, b, x[ 7], S23, 0x676f02d9); /* 31 */
+    step(G, b, c, d, a, x[12], S24, 0x8d2a4c8a); /* 32 */
+
+    /* Round 3 */
+    step(H, a, b, c, d, x[ 5], S31, 0xfffa3942); /* 33 */
+    step(H, d, a, b, c, x[ 8], S32, 0x8771f681); /* 34 */
+    step(H, c, d, a, b, x[11], S33, 0x6d9d6122); /* 35 */
+    step(H, b, c, d, a, x[14], S34, 0xfde5380c); /* 36 */
+    step(H, a, b, c, d, x[ 1], S31, 0xa4beea44); /* 37 */
+    step(H, d, a, b, c, x[ 4], S32, 0x4bdecfa9); /* 38 */
+    step(H, c, d, a, b, x[ 7], S33, 0xf6bb4b60); /* 39 */
+    step(H, b, c, d, a, x[10], S34, 0xbebfbc70); /* 40 */
+    step(H, a, b, c, d, x[13], S31, 0x289b7ec6); /* 41 */
+    step(H, d, a, b, c, x[ 0], S32, 0xeaa127fa); /* 42 */
+    step(H, c, d, a, b, x[ 3], S33, 0xd4ef3085); /* 43 */
+    step(H, b, c, d, a, x[ 6], S34,  0x4881d05); /* 44 */
+    step(H, a, b, c, d, x[ 9], S31, 0xd9d4d039); /* 45 */
+    step(H, d, a, b, c, x[12], S32, 0xe6db99e5); /* 46 */
+    step(H, c, d, a, b, x[15], S33, 0x1fa27cf8); /* 47 */
+    step(H, b, c, d, a, x[ 2], S34, 0xc4ac5665); /* 48 */
+
+    /* Round 4 */
+    step(I, a, b, c, d, x[ 0], S41, 0xf4292244); /* 49 */
+    step(I, d, a, b, c, x[ 7], S42, 0x432aff97); /* 50 */
+    step(I, c, d, a, b, x[14], S43, 0xab9423a7); /* 51 */
+    step(I, b, c, d, a, x[ 5], S44, 0xfc93a039); /* 52 */
+    step(I, a, b, c, d, x[12], S41, 0x655b59c3); /* 53 */
+    step(I, d, a, b, c, x[ 3], S42, 0x8f0ccc92); /* 54 */
+    step(I, c, d, a, b, x[10], S43, 0xffeff47d); /* 55 */
+    step(I, b, c, d, a, x[ 1], S44, 0x85845dd1); /* 56 */
+    step(I, a, b, c, d, x[ 8], S41, 0x6fa87e4f); /* 57 */
+    step(I, d, a, b, c, x[15], S42, 0xfe2ce6e0); /* 58 */
+    step(I, c, d, a, b, x[ 6], S43, 0xa3014314); /* 59 */
+    step(I, b, c, d, a, x[13], S44, 0x4e0811a1); /* 60 */
+    step(I, a, b, c, d, x[ 4], S41, 0xf7537e82); /* 61 */
+    step(I, d, a, b, c, x[11], S42, 0xbd3af235); /* 62 */
+    step(I, c, d, a, b, x[ 2], S43, 0x2ad7d2bb); /* 63 */
+    step(I, b, c, d, a, x[ 9], S44, 0xeb86d391); /* 64 */
+
+    // Lanes whose message is already complete keep their state
+    for(size_t l = 0; l < MD5::LANES; ++l)
+    {
+      state[0][l] += a[l] & active[l];
+      state[1][l] += b[l] & active[l];
+      state[2][l] += c[l] & active[l];
+      state[3][l] += d[l] & active[l];
+    }
+  }
 } // namespace
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -278,11 +427,80 @@ string MD5::hash(const ByteBuffer& buffer, size_t length)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string MD5::hash(const uInt8* buffer, size_t length)
 {
-  static MD5 ourMD5;  // singleton
+  MD5 md5;  // not static, since this may be called from several threads
 
-  ourMD5.init();
-  ourMD5.update(buffer, static_cast<uInt32>(length));
-  ourMD5.finalize();
+  md5.init();
+  md5.update(buffer, static_cast<uInt32>(length));
+  md5.finalize();
+
+  return md5.hexdigest();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StringList MD5::hash(const vector<string_view>& buffers)
+{
+  StringList digests(buffers.size());
+
+  // Hash messages of similar size together, so that few lanes run idle
+  vector<size_t> order(buffers.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&buffers](size_t a, size_t b) {
+    return buffers[a].size() < buffers[b].size();
+  });
+
+  for(size_t first = 0; first < order.size(); first += LANES)
+  {
+    const size_t count = std::min(LANES, order.size() - first);
+
+    // Unused lanes hash an empty message, which is ignored
+    std::array<LaneMessage, LANES> messages;
+    size_t maxBlocks = 0;
+    for(size_t l = 0; l < LANES; ++l)
+    {
+      messages[l].init(l < count ? buffers[order[first + l]] : string_view{});
+      maxBlocks = std::max(maxBlocks, messages[l].blocks);
+    }
+
+    // Load magic initialization constants
+    std::array<Lanes, 4> state;
+    state[0].fill(0x67452301);
+    state[1].fill(0xefcdab89);
+    state[2].fill(0x98badcfe);
+    state[3].fill(0x10325476);
+
+    for(size_t i = 0; i < maxBlocks; ++i)
+    {
+      std::array<Lanes, 16> x;
+      Lanes active;
+      for(size_t l = 0; l < LANES; ++l)
+      {
+        const bool hasBlock = i < messages[l].blocks;
+        const uInt8* block = messages[l].block(hasBlock ? i : 0);
+        for(size_t w = 0; w < 16; ++w)
+          x[w][l] =  (static_cast<uInt32>(block[w * 4]))
+                  | ((static_cast<uInt32>(block[w * 4 + 1])) << 8)
+                  | ((static_cast<uInt32>(block[w * 4 + 2])) << 16)
+                  | ((static_cast<uInt32>(block[w * 4 + 3])) << 24);
+        active[l] = hasBlock ? 0xffffffff : 0;
+      }
+      transformLanes(state, x, active);
+    }
+
+    // Return hex representation of the digests
+    static constexpr char hex[] = "0123456789abcdef";
+    for(size_t l = 0; l < count; ++l)
+    {
+      string& result = digests[order[first + l]];
+      result.reserve(32);
+      for(const auto& word: state)
+        for(int shift = 0; shift < 32; shift += 8)
+        {
+          const uInt8 c = static_cast<uInt8>(word[l] >> shift);
+          result += hex[(c >> 4) & 0x0f];
+          result += hex[c & 0x0f];
+        }
+    }
+  }
 
-  return ourMD5.hexdigest();
+  return digests;
 }
@@ -48,6 +48,7 @@
 #include "TIAConstants.hxx"
 #include "Settings.hxx"
 #include "PropsSet.hxx"
+#include "AutodetectCache.hxx"
 #include "EventHandler.hxx"
 #include "PNGLibrary.hxx"
 #include "JPGLibrary.hxx"
@@ -55,8 +56,10 @@
 #include "Random.hxx"
 #include "StateManager.hxx"
 #include "TimerManager.hxx"
+#include "AVCapture.hxx"
 #ifdef GUI_SUPPORT
   #include "HighScoresManager.hxx"
+  #include "RomIndex.hxx"
 #endif
 #include "Version.hxx"
 #include "TIA.hxx"
@@ -101,6 +104,7 @@ OSystem::OSystem()
   mySettings = MediaFactory::createSettings();
 
   myPropSet = make_unique<PropertiesSet>();
+  myAutodetectCache = make_unique<AutodetectCache>();
 
   Logger::instance().setLogParameters(Logger::Level::MAX, false);
 }
@@ -161,6 +165,7 @@ bool OSystem::initialize(const Settings::Options& options)
 
   myStateManager = make_unique<StateManager>(*this);
   myTimerManager = make_unique<TimerManager>();
+  myAVCapture = make_unique<AVCapture>(*this);
 
   myAudioSettings = make_unique<AudioSettings>(*mySettings);
 
@@ -189,6 +194,8 @@ bool OSystem::initialize(const Settings::Options& options)
   myLauncher = make_unique<Launcher>(*this);
 
   myHighScoresManager->setRepository(getHighscoreRepository());
+  myRomIndex = make_unique<RomIndex>();
+  myRomIndex->setRepository(getRomIndexRepository());
 #endif
 
 #ifdef IMAGE_SUPPORT
@@ -232,6 +239,7 @@ void OSystem::loadConfig(const Settings::Options& options)
 
   mySettings->setRepository(getSettingsRepository());
   myPropSet->setRepository(getPropertyRepository());
+  myAutodetectCache->setRepository(getAutodetectRepository());
 
   mySettings->load(options);
 
@@ -705,7 +713,11 @@ unique_ptr<Console> OSystem::openConsole(const FSNode& romfile, string& md5)
     };
 
     unique_ptr<Cartridge> cart =
-      CartCreator::create(romfile, image, size, cartmd5, type, *mySettings);
+      CartCreator::create(romfile, image, size, cartmd5, type, *mySettings,
+                          myAutodetectCache.get());
+    // The cart has its own copy now, so don't keep the image around while
+    // the console is created
+    image.reset();
     cart->setMessageCallback(callback);
 
     // Some properties may not have a name set; we can't leave it blank
@@ -772,6 +784,9 @@ void OSystem::closeConsole()
 {
   if(myConsole)
   {
+    // Finish a running capture while the console still exists
+    myAVCapture->stop();
+
   #ifdef CHEATCODE_SUPPORT
     // If a previous console existed, save cheats before creating a new one
     myCheatManager->saveCheats(myConsole->properties().get(PropType::Cart_MD5));
@@ -813,6 +828,34 @@ string OSystem::getROMMD5(const FSNode& rom)
   return image ? MD5::hash(image, size) : EmptyString;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StringList OSystem::getROMMD5(const vector<const FSNode*>& roms)
+{
+  StringList md5s(roms.size());
+
+  // All images are read first, and then hashed together
+  vector<ByteBuffer> images;
+  vector<string_view> buffers;
+  vector<size_t> indices;
+  for(size_t i = 0; i < roms.size(); ++i)
+  {
+    size_t size = 0;
+    ByteBuffer image = openROM(*roms[i], size, false);  // ignore error message
+    if(image)
+    {
+      buffers.emplace_back(reinterpret_cast<const char*>(image.get()), size);
+      indices.push_back(i);
+      images.push_back(std::move(image));
+    }
+  }
+
+  const StringList hashes = MD5::hash(buffers);
+  for(size_t i = 0; i < indices.size(); ++i)
+    md5s[indices[i]] = hashes[i];
+
+  return md5s;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 ByteBuffer OSystem::openROM(const FSNode& rom, size_t& size,
                             bool showErrorMessage)
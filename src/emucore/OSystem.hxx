@@ -23,6 +23,7 @@ class FrameBuffer;
 class EventHandler;
 class Properties;
 class PropertiesSet;
+class AutodetectCache;
 class Random;
 class Sound;
 class StateManager;
@@ -30,6 +31,7 @@ class TimerManager;
 class HighScoresManager;
 class EmulationWorker;
 class AudioSettings;
+class AVCapture;
 #ifdef CHEATCODE_SUPPORT
   class CheatManager;
 #endif
@@ -43,6 +45,7 @@ class AudioSettings;
   class OptionsMenu;
   class MessageMenu;
   class PlusRomsMenu;
+  class RomIndex;
   class TimeMachine;
   class VideoAudioDialog;
 #endif
@@ -135,6 +138,13 @@ class OSystem
     */
     PropertiesSet& propSet() const { return *myPropSet; }
 
+    /**
+      Get the cached autodetection results for the system.
+
+      @return The autodetection cache object
+    */
+    AutodetectCache& autodetectCache() const { return *myAutodetectCache; }
+
     /**
       Get the console of the system.  The console won't always exist,
       so we should test if it's available.
@@ -158,6 +168,13 @@ class OSystem
       @return The highscore manager object
     */
     HighScoresManager& highScores() const { return *myHighScoresManager; }
+
+    /**
+      Get the index of the ROMs shown in the launcher.
+
+      @return The ROM index object
+    */
+    RomIndex& romIndex() const { return *myRomIndex; }
   #endif
 
     /**
@@ -174,6 +191,13 @@ class OSystem
     */
     TimerManager& timer() const { return *myTimerManager; }
 
+    /**
+      Get the A/V capture of the system.
+
+      @return The A/V capture object
+    */
+    AVCapture& capture() const { return *myAVCapture; }
+
     /**
       This method should be called to save the current settings. It first asks
       each subsystem to update its settings, then it saves all settings to the
@@ -356,6 +380,17 @@ class OSystem
     */
     static string getROMMD5(const FSNode& rom);
 
+    /**
+      Open the given ROMs and return the MD5sums of their data.  This is
+      faster than calling getROMMD5() for each ROM, since the MD5sums of
+      several ROMs are calculated simultaneously.
+
+      @param roms  The file nodes of the ROMs to open
+
+      @return  MD5s of the ROM images, in the order of the ROMs
+    */
+    static StringList getROMMD5(const vector<const FSNode*>& roms);
+
     /**
       Creates a new game console from the specified romfile, and correctly
       initializes the system state to start emulation of the Console.
@@ -486,6 +521,10 @@ class OSystem
 
     virtual shared_ptr<CompositeKeyValueRepositoryAtomic> getHighscoreRepository() = 0;
 
+    virtual shared_ptr<CompositeKeyValueRepository> getAutodetectRepository() = 0;
+
+    virtual shared_ptr<CompositeKeyValueRepository> getRomIndexRepository() = 0;
+
   protected:
 
     //////////////////////////////////////////////////////////////////////
@@ -531,6 +570,9 @@ class OSystem
     // Pointer to the PropertiesSet object
     unique_ptr<PropertiesSet> myPropSet;
 
+    // Pointer to the AutodetectCache object
+    unique_ptr<AutodetectCache> myAutodetectCache;
+
     // Pointer to the (currently defined) Console object
     unique_ptr<Console> myConsole;
 
@@ -584,9 +626,15 @@ class OSystem
     // Pointer to the TimerManager object
     unique_ptr<TimerManager> myTimerManager;
 
+    // Pointer to the AVCapture object
+    unique_ptr<AVCapture> myAVCapture;
+
   #ifdef GUI_SUPPORT
     // Pointer to the HighScoresManager object
     unique_ptr<HighScoresManager> myHighScoresManager;
+
+    // Pointer to the RomIndex object
+    unique_ptr<RomIndex> myRomIndex;
   #endif
 
     // Indicates whether ROM launcher was ever opened during this run
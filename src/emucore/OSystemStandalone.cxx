@@ -49,6 +49,18 @@ shared_ptr<CompositeKeyValueRepositoryAtomic> OSystemStandalone::getHighscoreRep
   return {myStellaDb, &myStellaDb->highscoreRepository()};
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+shared_ptr<CompositeKeyValueRepository> OSystemStandalone::getAutodetectRepository()
+{
+  return {myStellaDb, &myStellaDb->autodetectRepository()};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+shared_ptr<CompositeKeyValueRepository> OSystemStandalone::getRomIndexRepository()
+{
+  return {myStellaDb, &myStellaDb->romIndexRepository()};
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void OSystemStandalone::getBaseDirectories(
     string& basedir, string& homedir, bool useappdir, string_view usedir)
@@ -34,6 +34,10 @@ class OSystemStandalone : public OSystem
 
     shared_ptr<CompositeKeyValueRepositoryAtomic> getHighscoreRepository() override;
 
+    shared_ptr<CompositeKeyValueRepository> getAutodetectRepository() override;
+
+    shared_ptr<CompositeKeyValueRepository> getRomIndexRepository() override;
+
   protected:
 
     void initPersistence(FSNode& basedir) override;
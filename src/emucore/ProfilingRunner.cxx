@@ -20,6 +20,7 @@
 #include "ProfilingRunner.hxx"
 #include "FSNode.hxx"
 #include "Cart.hxx"
+#include "CartARM.hxx"
 #include "CartCreator.hxx"
 #include "MD5.hxx"
 #include "Control.hxx"
@@ -54,12 +55,20 @@ namespace {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 ProfilingRunner::ProfilingRunner(int argc, char* argv[])
-  : profilingRuns{std::max<size_t>(argc - 2, 0)}
 {
   for (int i = 2; i < argc; i++) {
-    ProfilingRun& run(profilingRuns[i-2]);
-
     const string arg = argv[i];
+
+    if (arg == "-armprofile") {
+      myArmProfile = true;
+      continue;
+    }
+    if (arg == "-armrecord") {
+      myArmRecord = true;
+      continue;
+    }
+
+    ProfilingRun& run(profilingRuns.emplace_back());
     const size_t splitPoint = arg.find_first_of(':');
 
     run.romFile = splitPoint == string::npos ? arg : arg.substr(0, splitPoint);
@@ -170,6 +179,16 @@ bool ProfilingRunner::runOne(const ProfilingRun& run)
   tia.setFrameManager(&frameManager);
   tia.setLayout(frameLayout);
 
+  auto* armCartridge = cartridge->isARM()
+    ? static_cast<CartridgeARM*>(cartridge.get()) : nullptr;
+  if (armCartridge && myArmProfile) armCartridge->enableProfiling(true);
+
+  const string recordFile = imageFile.getNameWithExt(".armrec");
+  const bool armRecording = armCartridge && myArmRecord &&
+    armCartridge->startArmRecording(recordFile);
+  if (armCartridge && myArmRecord && !armRecording)
+    cout << "ERROR: unable to record ARM runs into " << recordFile << '\n';
+
   system.reset();
 
   const EmulationTiming emulationTiming(frameLayout, consoleTiming);
@@ -207,5 +226,26 @@ bool ProfilingRunner::runOne(const ProfilingRun& run)
   (cout << "100%" << '\n').flush();
   cout << "real time: " << realtimeUsed << " seconds\n";
 
+  if (armRecording) {
+    armCartridge->stopArmRecording();
+    cout << "ARM runs recorded as " << recordFile << '\n';
+  }
+
+  if (armCartridge && armCartridge->profiling()) {
+    armCartridge->writeProfileSummary(cout);
+
+    stringstream out;
+    armCartridge->writeCollapsedProfile(out);
+    try {
+      const FSNode profileFile(imageFile.getNameWithExt(".folded"));
+
+      profileFile.write(out);
+      cout << "ARM profile saved as " << profileFile.getShortPath() << '\n';
+    }
+    catch(...) {
+      cout << "ERROR: unable to save ARM profile\n";
+    }
+  }
+
   return true;
 }
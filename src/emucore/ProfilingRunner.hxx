@@ -57,6 +57,12 @@ class ProfilingRunner {
 
     vector<ProfilingRun> profilingRuns;
 
+    // Profile the code of ARM carts (-armprofile)
+    bool myArmProfile{false};
+
+    // Record the runs of the ARM code for thumbbench (-armrecord)
+    bool myArmRecord{false};
+
     Settings mySettings;
 
     Properties myProps;
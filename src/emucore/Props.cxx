@@ -36,9 +36,13 @@ Properties::Properties(const Properties& properties)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Properties::load(KeyValueRepository& repo)
 {
-  setDefaults();
+  load(repo.load());
+}
 
-  const auto props = repo.load();
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Properties::load(const KVRMap& props)
+{
+  setDefaults();
 
   for (const auto& [key, value]: props)
     set(getPropType(key), value.toString());
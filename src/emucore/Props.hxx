@@ -87,6 +87,8 @@ class Properties
   public:
     void load(KeyValueRepository& repo);
 
+    void load(const KVRMap& props);
+
     bool save(KeyValueRepository& repo) const;
 
     /**
@@ -25,6 +25,36 @@
 #include "repository/CompositeKeyValueRepositoryNoop.hxx"
 #include "repository/KeyValueRepositoryPropertyFile.hxx"
 
+namespace {
+  /**
+    Convert an MD5 string into the binary form used by 'DefPropsMD5'.
+    Returns false if the string is no valid MD5.
+  */
+  bool md5ToKey(string_view md5, std::array<uInt64, 2>& key)
+  {
+    key = {};
+    if(md5.size() != 32)
+      return false;
+
+    for(size_t i = 0; i < md5.size(); ++i)
+    {
+      const char c = md5[i];
+      uInt64 nibble = 0;
+      if(c >= '0' && c <= '9')
+        nibble = c - '0';
+      else if(c >= 'a' && c <= 'f')
+        nibble = c - 'a' + 10;
+      else if(c >= 'A' && c <= 'F')
+        nibble = c - 'A' + 10;
+      else
+        return false;
+
+      key[i / 16] = (key[i / 16] << 4) | nibble;
+    }
+    return true;
+  }
+} // namespace
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 PropertiesSet::PropertiesSet()
   : myRepository{make_shared<CompositeKeyValueRepositoryNoop>()}
@@ -55,8 +85,9 @@ bool PropertiesSet::getMD5(string_view md5, Properties& properties,
   // First check properties from external file
   if(!useDefaults)
   {
-    if (myRepository->has(md5)) {
-      properties.load(*myRepository->get(md5));
+    KVRMap values;
+    if (myRepository->load(md5, values)) {
+      properties.load(values);
 
       found = true;
     }
@@ -71,29 +102,21 @@ bool PropertiesSet::getMD5(string_view md5, Properties& properties,
     }
   }
 
-  // Otherwise, search the internal database using binary search
-  if(!found)
+  // Otherwise, search the internal database using binary search on the
+  // binary MD5s
+  std::array<uInt64, 2> key{};
+  if(!found && md5ToKey(md5, key))
   {
-    int low = 0, high = DEF_PROPS_SIZE - 1;
-    while(low <= high)
-    {
-      const int i = (low + high) / 2;
-      const int cmp = BSPF::compareIgnoreCase(md5,
-          DefProps[i][static_cast<uInt8>(PropType::Cart_MD5)]);
+    const auto iter = std::lower_bound(DefPropsMD5.begin(), DefPropsMD5.end(), key);
 
-      if(cmp == 0)  // found it
-      {
-        for(uInt8 p = 0; p < static_cast<uInt8>(PropType::NumTypes); ++p)
-          if(DefProps[i][p][0] != 0)
-            properties.set(PropType{p}, DefProps[i][p]);
+    if(iter != DefPropsMD5.end() && *iter == key)  // found it
+    {
+      const auto& defProps = DefProps[iter - DefPropsMD5.begin()];
+      for(uInt8 p = 0; p < static_cast<uInt8>(PropType::NumTypes); ++p)
+        if(defProps[p][0] != 0)
+          properties.set(PropType{p}, defProps[p]);
 
-        found = true;
-        break;
-      }
-      else if(cmp < 0)
-        high = i - 1; // look at lower range
-      else
-        low = i + 1;  // look at upper range
+      found = true;
     }
   }
 
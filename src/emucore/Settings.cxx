@@ -317,6 +317,8 @@ Settings::Settings()
   setPermanent("dev.thumb.chiptype", "0"); // = LPC2103
   setPermanent("dev.thumb.mammode", "2");
 #endif
+
+  updateEmulation();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -341,6 +343,8 @@ void Settings::load(const Options& options)
   // Finally, validate some settings, so the rest of the codebase
   // can assume the values are valid
   validate();
+
+  updateEmulation();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -638,7 +642,8 @@ void Settings::usage()
     << "                                state saving\n\n"
     << "  -rominfo      <rom>          Display detailed information for the given ROM\n"
     << "  -listrominfo                 Display contents of stella.pro, one line per ROM\n"
-    << "                                entry\n\n"
+    << "                                entry\n"
+    << "  -capexport    <file>         Convert the given A/V capture video to Y4M\n\n"
     << "  -exitlauncher <0|1>          On exiting a ROM, go back to the ROM launcher\n"
     << "  -launcherpos  <XxY>          Sets the window position in windowed launcher\n"
     << "                                mode\n"
@@ -880,6 +885,9 @@ void Settings::setValue(string_view key, const Variant& value, bool persist)
   }
   else
     myTemporarySettings[string{key}] = value;
+
+  if(myEmulationKeys.find(key) != myEmulationKeys.end())
+    updateEmulation();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -894,6 +902,81 @@ void Settings::setTemporary(string_view key, const Variant& value)
   myTemporarySettings[string{key}] = value;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Settings::updateEmulation()
+{
+  myEmulationKeys.clear();
+
+  // Any key read here triggers an update when it changes
+  const auto get = [&](string_view key) -> const Variant& {
+    myEmulationKeys.emplace(key);
+    return value(key);
+  };
+  const bool devSettings = get("dev.settings").toBool();
+  // Get the option of the active settings set
+  const auto getSet = [&](string_view key) -> const Variant& {
+    return get(string{devSettings ? "dev." : "plr."}.append(key));
+  };
+  auto emulation = make_shared<Emulation>();
+
+  emulation->devSettings = devSettings;
+
+  emulation->cpuRandom = getSet("cpurandom").toString();
+  emulation->ghostReadsTrap = get("dbg.ghostreadstrap").toBool();
+  emulation->readFromWritePortBreak = devSettings && get("dev.rwportbreak").toBool();
+  emulation->writeToReadPortBreak = devSettings && get("dev.wrportbreak").toBool();
+  emulation->logBreaks = get("dbg.logbreaks").toBool();
+  emulation->logTrace = get("dbg.logtrace").toBool();
+
+  emulation->console7800 = getSet("console").toString() == "7800";
+  emulation->ramRandom = getSet("ramrandom").toBool();
+  emulation->bankRandom = getSet("bankrandom").toBool();
+  emulation->randomHotspots = devSettings && get("dev.randomhs").toBool();
+  emulation->fastSCBios = get("fastscbios").toBool();
+  emulation->dpcPitch = get(AudioSettings::SETTING_DPC_PITCH).toInt();
+
+  if(devSettings)
+  {
+    emulation->thumbTrapFatal = get("dev.thumb.trapfatal").toBool();
+    emulation->thumbCycleFactor =
+      static_cast<double>(get("dev.thumb.cyclefactor").toFloat());
+    emulation->thumbIncCycles = get("dev.thumb.inccycles").toBool();
+    emulation->thumbChipType = get("dev.thumb.chiptype").toInt();
+    emulation->thumbMamMode = get("dev.thumb.mammode").toInt();
+  }
+
+  emulation->tiaDbgColors = get("tia.dbgcolors").toString();
+  emulation->debugColors = getSet("debugcolors").toBool();
+  emulation->phosphorMode = get(PhosphorHandler::SETTING_MODE).toString();
+  if(devSettings)
+  {
+    const string& type = get("dev.tia.type").toString();
+    const bool custom = BSPF::equalsIgnoreCase("custom", type);
+    const auto tiaOption = [&](string_view key, string_view preset) {
+      return custom ? get(key).toBool() : BSPF::equalsIgnoreCase(preset, type);
+    };
+
+    emulation->plInvPhase = tiaOption("dev.tia.plinvphase", "koolaidman");
+    emulation->msInvPhase = tiaOption("dev.tia.msinvphase", "cosmicark");
+    emulation->blInvPhase = custom && get("dev.tia.blinvphase").toBool();
+    emulation->delayPFBits = tiaOption("dev.tia.delaypfbits", "pesco");
+    emulation->delayPFColor = tiaOption("dev.tia.delaypfcolor", "quickstep");
+    emulation->pfScoreGlitch = tiaOption("dev.tia.pfscoreglitch", "matchie");
+    emulation->delayBKColor = tiaOption("dev.tia.delaybkcolor", "indy500");
+    emulation->delayPlSwap = tiaOption("dev.tia.delayplswap", "heman");
+    emulation->delayBlSwap = custom && get("dev.tia.delayblswap").toBool();
+  }
+  emulation->tiaRandom = getSet("tiarandom").toBool();
+  emulation->tiaDriven = devSettings && get("dev.tiadriven").toBool();
+  emulation->tvJitter = getSet("tv.jitter").toBool();
+  emulation->jitterSense = getSet("tv.jitter_sense").toInt();
+  emulation->jitterRecovery = getSet("tv.jitter_recovery").toInt();
+  emulation->colorLoss = getSet("colorloss").toBool();
+
+  std::atomic_store(&myEmulation,
+                    shared_ptr<const Emulation>(std::move(emulation)));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Settings::migrateOne()
 {
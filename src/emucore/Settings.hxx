@@ -19,6 +19,7 @@
 #define SETTINGS_HXX
 
 #include <map>
+#include <set>
 
 #include "Variant.hxx"
 #include "bspf.hxx"
@@ -54,6 +55,55 @@ class Settings
     static constexpr int SETTINGS_VERSION = 1;
     static constexpr string_view SETTINGS_VERSION_KEY = "settings.version";
 
+    /**
+      The options read by the emulation core (CPU, RIOT, TIA and
+      cartridges), already resolved for the active (player or developer)
+      settings set.
+    */
+    struct Emulation
+    {
+      bool devSettings{false};
+      // CPU
+      string cpuRandom;
+      bool ghostReadsTrap{false};
+      bool readFromWritePortBreak{false};
+      bool writeToReadPortBreak{false};
+      bool logBreaks{false};
+      bool logTrace{false};
+      // Console, RIOT and cartridges
+      bool console7800{false};
+      bool ramRandom{false};
+      bool bankRandom{false};
+      bool randomHotspots{false};
+      bool fastSCBios{false};
+      int dpcPitch{0};
+      // ARM
+      bool thumbTrapFatal{false};
+      double thumbCycleFactor{1.0};
+      bool thumbIncCycles{false};
+      int thumbChipType{0};
+      int thumbMamMode{0};
+      // TIA
+      string tiaDbgColors;
+      bool debugColors{false};
+      string phosphorMode;
+      bool plInvPhase{false};
+      bool msInvPhase{false};
+      bool blInvPhase{false};
+      bool delayPFBits{false};
+      bool delayPFColor{false};
+      bool pfScoreGlitch{false};
+      bool delayBKColor{false};
+      bool delayPlSwap{false};
+      bool delayBlSwap{false};
+      bool tiaRandom{false};
+      bool tiaDriven{false};
+      bool tvJitter{false};
+      int jitterSense{0};
+      int jitterRecovery{0};
+      bool colorLoss{false};
+    };
+
   public:
     /**
       This method should be called to display usage information.
@@ -112,6 +162,18 @@ class Settings
       return value(key).toPoint();
     }
 
+    /**
+      Answer the options used by the emulation core.  The returned values
+      never change; a new set is published whenever one of the underlying
+      options changes.  So they can be used without any lookups, and from
+      any thread.
+
+      @return  The current emulation options
+    */
+    shared_ptr<const Emulation> emulation() const {
+      return std::atomic_load(&myEmulation);
+    }
+
   protected:
     /**
       Add key/value pair to specified map.  Note that these should only be called
@@ -129,6 +191,12 @@ class Settings
     */
     void validate();
 
+    /**
+      Resolve the emulation options and publish them, recording the keys
+      they depend on.
+    */
+    void updateEmulation();
+
     /**
       Migrate settings over one version.
      */
@@ -150,6 +218,10 @@ class Settings
 
     shared_ptr<KeyValueRepository> myRespository;
 
+    // The current emulation options, and the keys used to resolve them
+    shared_ptr<const Emulation> myEmulation;
+    std::set<string, std::less<>> myEmulationKeys;
+
   private:
     // Following constructors and assignment operators not supported
     Settings(const Settings&) = delete;
@@ -96,30 +96,44 @@ void System::clearDirtyPages()
   myPageIsDirtyTable.fill(false);
 }
 
+#ifdef DEBUGGER_SUPPORT
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8 System::peek(uInt16 addr, Device::AccessFlags flags)
+inline void System::trackAccess(const PageAccess& access, uInt16 addr,
+                                Device::AccessFlags flags, bool isWrite) const
 {
-  const PageAccess& access = getPageAccess(addr);
-
-#ifdef DEBUGGER_SUPPORT
   // Set access type
   if(access.romAccessBase)
     *(access.romAccessBase + (addr & PAGE_MASK)) |= (flags | (addr & Device::HADDR));
   else
     access.device->setAccessFlags(addr, flags);
+
   // Increase access counter
-  if(flags != Device::NONE)
+  if(myAccessTracking == AccessTracking::full && flags != Device::NONE)
   {
-    if(access.romPeekCounter)
-      *(access.romPeekCounter + (addr & PAGE_MASK)) += 1;
+    Device::AccessCounter* counter = isWrite ? access.romPokeCounter
+                                             : access.romPeekCounter;
+    if(counter)
+      *(counter + (addr & PAGE_MASK)) += 1;
     else
-      access.device->increaseAccessCounter(addr);
+      access.device->increaseAccessCounter(addr, isWrite);
   }
+}
 #endif
 
-  // See if this page uses direct accessing or not
-  const uInt8 result = access.directPeekBase
-      ? *(access.directPeekBase + (addr & PAGE_MASK))
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8 System::peek(uInt16 addr, Device::AccessFlags flags)
+{
+  const PageAccess& access = getPageAccess(addr);
+
+#ifdef DEBUGGER_SUPPORT
+  if(myAccessTracking != AccessTracking::off)
+    trackAccess(access, addr, flags, false);
+#endif
+
+  // See if this page (and address) uses direct accessing or not
+  const uInt16 offset = addr & PAGE_MASK;
+  const uInt8 result = access.directPeekBase && !((access.peekTraps >> offset) & 1)
+      ? *(access.directPeekBase + offset)
       : access.device->peek(addr);
 
 #ifdef DEBUGGER_SUPPORT
@@ -137,19 +151,8 @@ void System::poke(uInt16 addr, uInt8 value, Device::AccessFlags flags)
   const PageAccess& access = myPageAccessTable[page];
 
 #ifdef DEBUGGER_SUPPORT
-  // Set access type
-  if(access.romAccessBase)
-    *(access.romAccessBase + (addr & PAGE_MASK)) |= (flags | (addr & Device::HADDR));
-  else
-    access.device->setAccessFlags(addr, flags);
-  // Increase access counter
-  if(flags != Device::NONE)
-  {
-    if(access.romPokeCounter)
-      *(access.romPokeCounter + (addr & PAGE_MASK)) += 1;
-    else
-      access.device->increaseAccessCounter(addr, true);
-  }
+  if(myAccessTracking != AccessTracking::off)
+    trackAccess(access, addr, flags, true);
 #endif
 
   // See if this page uses direct accessing or not
@@ -223,6 +223,22 @@ class System : public Serializable
       @param address The address to modify
     */
     void increaseAccessCounter(uInt16 address, bool isWrite) const;
+
+    /**
+      Levels of tracking the accesses done by peek() and poke().  The
+      access flags are used by the disassembly, the counters are saved by
+      the 'saveAccess' command.  Since tracking is a large part of the cost
+      of each access, it is only fully enabled when the debugger needs it.
+      Accesses done while tracking was off are missing in the disassembly,
+      which then relies on the static analysis for these addresses.
+    */
+    enum class AccessTracking : uInt8 {
+      off,    // no tracking
+      flags,  // access flags only
+      full    // access flags and access counters
+    };
+    void setAccessTracking(AccessTracking level) { myAccessTracking = level; }
+    AccessTracking accessTracking() const { return myAccessTracking; }
   #endif
 
   public:
@@ -248,6 +264,13 @@ class System : public Serializable
       */
       uInt8* directPeekBase{nullptr};
 
+      /**
+        Bitmask of the addresses within a directly accessed page (bit n for
+        page offset n), for which the device's peek method must be invoked
+        anyway (e.g. bankswitching hotspots).
+      */
+      uInt64 peekTraps{0};
+
       /**
         Pointer to a block of memory or the null pointer.  The null pointer
         indicates that the device's poke method should be invoked for writes
@@ -291,6 +314,8 @@ class System : public Serializable
       */
       PageAccessType type{PageAccessType::READ};
 
+      static_assert(PAGE_SIZE == 64, "peekTraps requires a page size of 64");
+
       // Constructors
       PageAccess() = default;
       PageAccess(Device* dev, PageAccessType access) : device{dev}, type{access} { }
@@ -306,6 +331,20 @@ class System : public Serializable
       myPageAccessTable[(addr & ADDRESS_MASK) >> PAGE_SHIFT] = access;
     }
 
+    /**
+      Set the page accessing methods for consecutive pages, starting with
+      the page of the specified address.
+
+      @param addr    The address of the first page
+      @param access  The accessing methods to be used by the pages
+      @param pages   The number of pages
+    */
+    void setPageAccess(uInt16 addr, const PageAccess* access, uInt16 pages) {
+      const uInt16 page = (addr & ADDRESS_MASK) >> PAGE_SHIFT;
+      std::copy_n(access, std::min<uInt16>(pages, NUM_PAGES - page),
+                  myPageAccessTable.begin() + page);
+    }
+
     /**
       Get the page accessing method for the specified address.
 
@@ -365,6 +404,15 @@ class System : public Serializable
     */
     bool load(Serializer& in) override;
 
+  private:
+  #ifdef DEBUGGER_SUPPORT
+    /**
+      Track the given access, according to the current tracking level.
+    */
+    void trackAccess(const PageAccess& access, uInt16 addr,
+                     Device::AccessFlags flags, bool isWrite) const;
+  #endif
+
   private:
     // The system RNG
     Random& myRandom;
@@ -401,6 +449,11 @@ class System : public Serializable
     // debugger is active.
     bool myDataBusLocked{false};
 
+  #ifdef DEBUGGER_SUPPORT
+    // The accesses tracked by peek() and poke()
+    AccessTracking myAccessTracking{AccessTracking::full};
+  #endif
+
     // Whether autodetection is currently running (ie, the emulation
     // core is attempting to autodetect display settings, cart modes, etc)
     // Some parts of the codebase need to act differently in such a case
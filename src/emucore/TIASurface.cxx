@@ -22,6 +22,7 @@
 #include "TIA.hxx"
 #include "PNGLibrary.hxx"
 #include "PaletteHandler.hxx"
+#include "AVCapture.hxx"
 #include "TIASurface.hxx"
 
 namespace {
@@ -118,10 +119,14 @@ void TIASurface::setPalette(const PaletteArray& tia_palette,
                             const PaletteArray& rgb_palette)
 {
   myPalette = tia_palette;
+  myRGBPalette = rgb_palette;
 
   // The NTSC filtering needs access to the raw RGB data, since it calculates
   // its own internal palette
   myNTSCFilter.setPalette(rgb_palette);
+
+  // A running A/V capture records the palette change
+  myOSystem.capture().setPalette(rgb_palette);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
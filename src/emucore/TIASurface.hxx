@@ -96,6 +96,11 @@ class TIASurface
      */
     uInt32 mapIndexedPixel(uInt8 indexedColor, uInt8 shift = 0) const;
 
+    /**
+      Get the RGB components of the current palette.
+    */
+    const PaletteArray& rgbPalette() const { return myRGBPalette; }
+
     /**
       Get the NTSCFilter object associated with the framebuffer
     */
@@ -255,8 +260,8 @@ class TIASurface
     // Use scanlines in TIA rendering mode
     bool myScanlinesEnabled{false};
 
-    // Palette for normal TIA rendering mode
-    PaletteArray myPalette;
+    // Palette for normal TIA rendering mode, and its RGB components
+    PaletteArray myPalette, myRGBPalette;
 
     // Flag for saving a snapshot
     bool mySaveSnapFlag{false};
@@ -0,0 +1,509 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <cstring>
+
+#include "Cart.hxx"
+#include "Thumbulator.hxx"
+#include "ThumbRecorder.hxx"
+
+namespace {
+  // Recording file layout (all values little-endian):
+  //   header:   magic, version, state size, ROM size, RAM size, cBase, cStart,
+  //             cStack, configuration, ROM words, initial RAM words
+  //   runs:     RUN_MARKER, run data (see writeRun), ...
+  //   end:      END_MARKER
+  constexpr std::array<char, 8> MAGIC = { 'S', 'T', 'E', 'L', 'L', 'A', 'R', 'M' };
+  constexpr uInt32 VERSION = 1;
+  constexpr uInt32 RUN_MARKER = 1, END_MARKER = 0;
+
+  void put32(ostream& out, uInt32 value)
+  {
+    const std::array<char, 4> bytes = {
+      static_cast<char>(value), static_cast<char>(value >> 8),
+      static_cast<char>(value >> 16), static_cast<char>(value >> 24)
+    };
+    out.write(bytes.data(), bytes.size());
+  }
+
+  uInt32 get32(istream& in)
+  {
+    std::array<uInt8, 4> bytes{0};
+    in.read(reinterpret_cast<char*>(bytes.data()), bytes.size());  // NOLINT
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) |
+           (static_cast<uInt32>(bytes[3]) << 24);
+  }
+
+  void putWords(ostream& out, const uInt16* words, size_t size)
+  {
+    std::vector<char> bytes(size * 2);
+    for(size_t i = 0; i < size; ++i)
+    {
+      bytes[i * 2]     = static_cast<char>(words[i]);
+      bytes[i * 2 + 1] = static_cast<char>(words[i] >> 8);
+    }
+    out.write(bytes.data(), bytes.size());
+  }
+
+  void getWords(istream& in, uInt16* words, size_t size)
+  {
+    std::vector<uInt8> bytes(size * 2);
+    in.read(reinterpret_cast<char*>(bytes.data()), bytes.size());  // NOLINT
+    for(size_t i = 0; i < size; ++i)
+      words[i] = bytes[i * 2] | (bytes[i * 2 + 1] << 8);
+  }
+} // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ThumbRecorder::~ThumbRecorder()
+{
+  stopRecording();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ThumbRecorder::startRecording(const string& filename, Thumbulator& thumb)
+{
+  stopRecording();
+
+  myOut.open(filename, std::ios::binary | std::ios::trunc);
+  if(!myOut.is_open())
+    return false;
+
+  myOut.write(MAGIC.data(), MAGIC.size());
+  put32(myOut, VERSION);
+  put32(myOut, static_cast<uInt32>(getState(thumb).size()));
+  put32(myOut, thumb.romSize);
+  put32(myOut, thumb.ramSize);
+  put32(myOut, thumb.cBase);
+  put32(myOut, thumb.cStart);
+  put32(myOut, thumb.cStack);
+  put32(myOut, static_cast<uInt32>(thumb.configuration));
+  putWords(myOut, thumb.rom, thumb.romSize / 2);
+  putWords(myOut, thumb.ram, thumb.ramSize / 2);
+
+  myLastRam.assign(thumb.ram, thumb.ram + thumb.ramSize / 2);
+  myRecorded = &thumb;
+  thumb.setRecorder(this);
+
+  return myOut.good();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbRecorder::stopRecording()
+{
+  if(myRecorded)
+    myRecorded->setRecorder(nullptr);
+  myRecorded = nullptr;
+
+  if(myOut.is_open())
+  {
+    put32(myOut, END_MARKER);
+    myOut.close();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbRecorder::startRun(Thumbulator& thumb, uInt32 cycles, bool irqDrivenAudio)
+{
+  if(&thumb != myRecorded)
+    return;
+
+  myRun.cycles = cycles;
+  myRun.irqDrivenAudio = irqDrivenAudio;
+  myRun.hle = thumb._hleEnabled;
+  myRun.state = getState(thumb);
+  myRun.callbacks.clear();
+
+  // Store the RAM changes since the end of the last recorded run, which
+  // were done by the 6507 side (or by a run which aborted)
+  myRun.ramChunks.clear();
+  myRun.ramData.clear();
+  const auto size = static_cast<uInt32>(myLastRam.size());
+  for(uInt32 i = 0; i < size; )
+  {
+    if(thumb.ram[i] == myLastRam[i])
+    {
+      ++i;
+      continue;
+    }
+    const uInt32 start = i;
+    while(i < size && thumb.ram[i] != myLastRam[i])
+      ++i;
+    myRun.ramChunks.emplace_back(start, i - start);
+    myRun.ramData.insert(myRun.ramData.end(), thumb.ram + start, thumb.ram + i);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbRecorder::endRun(Thumbulator& thumb, uInt32 cycles)
+{
+  if(&thumb != myRecorded)
+    return;
+
+  myRun.outcome = getOutcome(thumb, cycles);
+  std::copy_n(thumb.ram, myLastRam.size(), myLastRam.begin());
+  writeRun(myRun);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 ThumbRecorder::callback(Cartridge* cart, uInt8 function,
+                               uInt32 value1, uInt32 value2)
+{
+  if(myReplayed)
+  {
+    // Return the recorded result, the cart is not available when replaying
+    if(myCallback < myReplayed->callbacks.size())
+    {
+      const Callback& recorded = myReplayed->callbacks[myCallback++];
+      if(recorded.function == function && recorded.value1 == value1 &&
+         recorded.value2 == value2)
+        return recorded.result;
+    }
+    if(myError.empty())
+      myError = "unexpected callback " + std::to_string(function) + "(" +
+                std::to_string(value1) + ", " + std::to_string(value2) + ")";
+    return 0;
+  }
+
+  const uInt32 result = cart ? cart->thumbCallback(function, value1, value2) : 0;
+  if(myRecorded)
+    myRun.callbacks.push_back({function, value1, value2, result});
+  return result;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ThumbRecorder::load(const string& filename)
+{
+  myRuns.clear();
+  myThumb.reset();
+  myError.clear();
+
+  std::ifstream in(filename, std::ios::binary);
+  std::array<char, 8> magic{0};
+  in.read(magic.data(), magic.size());
+  if(!in || magic != MAGIC || get32(in) != VERSION)
+  {
+    myError = "not a valid ARM recording";
+    return false;
+  }
+  const uInt32 stateSize = get32(in);
+  const uInt32 romSize   = get32(in);
+  const uInt32 ramSize   = get32(in);
+  const uInt32 cBase     = get32(in);
+  const uInt32 cStart    = get32(in);
+  const uInt32 cStack    = get32(in);
+  const auto configuration = static_cast<Thumbulator::ConfigureFor>(get32(in));
+  if(!in || romSize > 512_KB || ramSize > 32_KB)
+  {
+    myError = "invalid ARM recording header";
+    return false;
+  }
+
+  myRom.assign(romSize / 2, 0);
+  myStartRam.assign(32_KB / 2, 0);  // the full RAM area addressable by the ARM
+  getWords(in, myRom.data(), myRom.size());
+  getWords(in, myStartRam.data(), ramSize / 2);
+  myRam = myStartRam;
+
+  Run run;
+  while(readRun(in, run, stateSize))
+    myRuns.push_back(run);
+  if(!myError.empty())
+    return false;
+
+  myThumb = make_unique<Thumbulator>(myRom.data(), myRam.data(), romSize,
+      cBase, cStart, cStack, true, 1.0, configuration, nullptr);
+  if(myThumb->ramSize != ramSize || getState(*myThumb).size() != stateSize)
+  {
+    myThumb.reset();
+    myError = "ARM recording from a different build configuration";
+    return false;
+  }
+  myThumb->setRecorder(this);
+  rewind();
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbRecorder::rewind()
+{
+  std::copy(myStartRam.begin(), myStartRam.end(), myRam.begin());
+  myInstructions = 0;
+  myError.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ThumbRecorder::replay(size_t index, bool verify)
+{
+  const Run& run = myRuns[index];
+  Thumbulator& thumb = *myThumb;
+
+  setState(thumb, run.state);
+  if(thumb._hleEnabled != run.hle)
+    thumb.enableHLE(run.hle);
+  const uInt16* data = run.ramData.data();
+  for(const auto& [offset, size]: run.ramChunks)
+  {
+    std::copy_n(data, size, myRam.begin() + offset);
+    data += size;
+  }
+
+  uInt32 cycles = run.cycles;
+  myReplayed = &run;
+  myCallback = 0;
+  try
+  {
+    thumb.run(cycles, run.irqDrivenAudio);
+  }
+  catch(const std::exception& e)
+  {
+    myError = e.what();
+  }
+  myReplayed = nullptr;
+  myInstructions += thumb._stats.instructions;
+
+  if(verify && myError.empty())
+  {
+    const Outcome outcome = getOutcome(thumb, cycles);
+    const Outcome& expected = run.outcome;
+
+    if(outcome.instructions != expected.instructions)
+      myError = "executed " + std::to_string(outcome.instructions) +
+                " instructions instead of " + std::to_string(expected.instructions);
+    else if(outcome.cycles != expected.cycles)
+      myError = "returned " + std::to_string(outcome.cycles) +
+                " cycles instead of " + std::to_string(expected.cycles);
+    else if(outcome.regs != expected.regs || outcome.znFlags != expected.znFlags ||
+            outcome.cFlag != expected.cFlag || outcome.vFlag != expected.vFlag)
+      myError = "registers differ";
+    else if(outcome.ramHash != expected.ramHash)
+      myError = "RAM differs";
+    else if(myCallback != run.callbacks.size())
+      myError = "missing callbacks";
+  }
+  if(!myError.empty())
+  {
+    myError = "run " + std::to_string(index) + ": " + myError;
+    return false;
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<typename Visitor>
+void ThumbRecorder::visitState(Thumbulator& thumb, Visitor visit)
+{
+  // Visit a member as one or two words, which may be modified by the visitor
+  const auto member = [&](auto& value) {
+    using T = std::remove_reference_t<decltype(value)>;
+    if constexpr(std::is_same_v<T, double>)
+    {
+      uInt64 bits = 0;
+      std::memcpy(&bits, &value, sizeof(bits));
+      auto low = static_cast<uInt32>(bits), high = static_cast<uInt32>(bits >> 32);
+      visit(low);
+      visit(high);
+      bits = low | (static_cast<uInt64>(high) << 32);
+      std::memcpy(&value, &bits, sizeof(bits));
+    }
+    else
+    {
+      auto word = static_cast<uInt32>(value);
+      visit(word);
+      value = static_cast<T>(word);
+    }
+  };
+
+  // Everything which is kept between runs (see Thumbulator::reset())
+  member(thumb.mamcr);
+  member(thumb._lockMamcr);
+  member(thumb._chipType);
+  member(thumb._MHz);
+  member(thumb._flashCycles);
+  member(thumb._flashBanks);
+  member(thumb._consoleTiming);
+  member(thumb.timing_factor);
+#ifdef TIMER_0
+  member(thumb.T0TCR);
+  member(thumb.T0TC);
+  member(thumb.tim0Start);
+  member(thumb.tim0Total);
+#endif
+  member(thumb.T1TCR);
+  member(thumb.T1TC);
+  member(thumb.tim1Start);
+  member(thumb.tim1Total);
+#ifndef UNSAFE_OPTIMIZATIONS
+  member(thumb.trapOnFatal);
+#endif
+  member(thumb._countCycles);
+#ifdef THUMB_CYCLE_COUNT
+  member(thumb._armCyclesFactor);
+  member(thumb._pipeIdx);
+  for(auto& type: thumb._prefetchCycleType)
+    member(type);
+  for(auto& type: thumb._lastCycleType)
+    member(type);
+  for(auto& addr: thumb._prefetchBufferAddr)
+    member(addr);
+  for(auto& addr: thumb._branchBufferAddr)
+    member(addr);
+  member(thumb._dataBufferAddr);
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::vector<uInt32> ThumbRecorder::getState(Thumbulator& thumb)
+{
+  std::vector<uInt32> state;
+  visitState(thumb, [&](const uInt32& word) { state.push_back(word); });
+  return state;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbRecorder::setState(Thumbulator& thumb, const std::vector<uInt32>& state)
+{
+  size_t i = 0;
+  visitState(thumb, [&](uInt32& word) { word = state[i++]; });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ThumbRecorder::Outcome ThumbRecorder::getOutcome(Thumbulator& thumb, uInt32 cycles)
+{
+  Outcome outcome;
+  outcome.cycles = cycles;
+  outcome.instructions = thumb._stats.instructions;
+  outcome.regs = thumb.reg_norm;
+  outcome.znFlags = thumb.znFlags;
+  outcome.cFlag = thumb.cFlag;
+  outcome.vFlag = thumb.vFlag;
+  outcome.ramHash = ramHash(thumb);
+  return outcome;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 ThumbRecorder::ramHash(const Thumbulator& thumb)
+{
+  // 64 bit FNV-1a
+  uInt64 hash = 0xcbf29ce484222325ULL;
+  for(uInt32 i = 0; i < thumb.ramSize / 2; ++i)
+  {
+    hash = (hash ^ (thumb.ram[i] & 0xff)) * 0x100000001b3ULL;
+    hash = (hash ^ (thumb.ram[i] >> 8)) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbRecorder::writeRun(const Run& run)
+{
+  put32(myOut, RUN_MARKER);
+  put32(myOut, run.cycles);
+  put32(myOut, (run.irqDrivenAudio ? 1 : 0) | (run.hle ? 2 : 0));
+  for(const uInt32 word: run.state)
+    put32(myOut, word);
+
+  put32(myOut, static_cast<uInt32>(run.ramChunks.size()));
+  for(const auto& [offset, size]: run.ramChunks)
+  {
+    put32(myOut, offset);
+    put32(myOut, size);
+  }
+  putWords(myOut, run.ramData.data(), run.ramData.size());
+
+  put32(myOut, static_cast<uInt32>(run.callbacks.size()));
+  for(const Callback& callback: run.callbacks)
+  {
+    put32(myOut, callback.function);
+    put32(myOut, callback.value1);
+    put32(myOut, callback.value2);
+    put32(myOut, callback.result);
+  }
+
+  const Outcome& outcome = run.outcome;
+  put32(myOut, outcome.cycles);
+  put32(myOut, outcome.instructions);
+  for(const uInt32 reg: outcome.regs)
+    put32(myOut, reg);
+  put32(myOut, outcome.znFlags);
+  put32(myOut, outcome.cFlag);
+  put32(myOut, outcome.vFlag);
+  put32(myOut, static_cast<uInt32>(outcome.ramHash));
+  put32(myOut, static_cast<uInt32>(outcome.ramHash >> 32));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ThumbRecorder::readRun(std::ifstream& in, Run& run, size_t stateSize)
+{
+  // A missing end marker means the recording was not stopped properly,
+  // all complete runs are still valid
+  if(get32(in) != RUN_MARKER || !in)
+    return false;
+
+  run.cycles = get32(in);
+  const uInt32 flags = get32(in);
+  run.irqDrivenAudio = flags & 1;
+  run.hle = flags & 2;
+  run.state.resize(stateSize);
+  for(uInt32& word: run.state)
+    word = get32(in);
+
+  const uInt32 chunks = get32(in);
+  if(!in || chunks > 32_KB)
+    return false;
+  run.ramChunks.resize(chunks);
+  size_t words = 0;
+  for(auto& [offset, size]: run.ramChunks)
+  {
+    offset = get32(in);
+    size = get32(in);
+    if(offset + size > 32_KB / 2)
+    {
+      myError = "invalid RAM changes in run " + std::to_string(myRuns.size());
+      return false;
+    }
+    words += size;
+  }
+  run.ramData.resize(words);
+  getWords(in, run.ramData.data(), words);
+
+  const uInt32 callbacks = get32(in);
+  if(!in || callbacks > (1U << 20))
+    return false;
+  run.callbacks.resize(callbacks);
+  for(Callback& callback: run.callbacks)
+  {
+    callback.function = get32(in);
+    callback.value1 = get32(in);
+    callback.value2 = get32(in);
+    callback.result = get32(in);
+  }
+
+  Outcome& outcome = run.outcome;
+  outcome.cycles = get32(in);
+  outcome.instructions = get32(in);
+  for(uInt32& reg: outcome.regs)
+    reg = get32(in);
+  outcome.znFlags = get32(in);
+  outcome.cFlag = get32(in);
+  outcome.vFlag = get32(in);
+  outcome.ramHash = get32(in);
+  outcome.ramHash |= static_cast<uInt64>(get32(in)) << 32;
+
+  return static_cast<bool>(in);
+}
@@ -0,0 +1,151 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef THUMB_RECORDER_HXX
+#define THUMB_RECORDER_HXX
+
+#include <fstream>
+
+class Cartridge;
+class Thumbulator;
+
+#include "bspf.hxx"
+
+/**
+  This class records all runs of a Thumbulator, and replays them without
+  the rest of the emulation (e.g. for benchmarking the ARM emulation).
+
+  For each run, the complete entry state (emulator state, changes of the ARM
+  RAM since the last run, cart callbacks) and the outcome (registers, RAM
+  contents, cycles) are recorded.  Replaying a run restores the entry state
+  and verifies that the run ends with the recorded outcome.
+
+  Recordings are only valid for emulators built with the same configuration
+  (e.g. with or without cycle counting).
+*/
+class ThumbRecorder
+{
+  public:
+    ThumbRecorder() = default;
+    ~ThumbRecorder();
+
+    /**
+      Start recording all runs of the given emulator into the given file.
+
+      @return  False on any errors, else true
+    */
+    bool startRecording(const string& filename, Thumbulator& thumb);
+
+    /**
+      Stop recording and close the file.
+    */
+    void stopRecording();
+
+    /**
+      Load a recording, and create an emulator for replaying it.
+
+      @return  False on any errors, else true
+    */
+    bool load(const string& filename);
+
+    /**
+      Restore the state at the start of the recording.
+    */
+    void rewind();
+
+    /**
+      Replay the given run of the loaded recording.  Runs must be replayed
+      in the recorded order, starting after loading or rewinding.
+
+      @param index   The run to replay
+      @param verify  Verify the outcome of the run
+
+      @return  False if the outcome differs from the recording, else true
+    */
+    bool replay(size_t index, bool verify = true);
+
+    size_t runs() const { return myRuns.size(); }
+    uInt64 instructions() const { return myInstructions; }
+    const string& error() const { return myError; }
+
+  private:
+    // Interface for the Thumbulator
+    friend class Thumbulator;
+
+    void startRun(Thumbulator& thumb, uInt32 cycles, bool irqDrivenAudio);
+    void endRun(Thumbulator& thumb, uInt32 cycles);
+    uInt32 callback(Cartridge* cart, uInt8 function, uInt32 value1, uInt32 value2);
+
+  private:
+    struct Callback {
+      uInt32 function{0}, value1{0}, value2{0}, result{0};
+    };
+    struct Outcome {
+      uInt32 cycles{0};
+      uInt32 instructions{0};
+      std::array<uInt32, 16> regs{0};
+      uInt32 znFlags{0}, cFlag{0}, vFlag{0};
+      uInt64 ramHash{0};
+    };
+    struct Run {
+      uInt32 cycles{0};
+      bool irqDrivenAudio{false};
+      bool hle{false};
+      std::vector<uInt32> state;
+      std::vector<std::pair<uInt32, uInt32>> ramChunks;  // word offset, size
+      std::vector<uInt16> ramData;    // changed RAM words of all chunks
+      std::vector<Callback> callbacks;
+      Outcome outcome;
+    };
+
+    template<typename Visitor>
+    static void visitState(Thumbulator& thumb, Visitor visit);
+    static std::vector<uInt32> getState(Thumbulator& thumb);
+    static void setState(Thumbulator& thumb, const std::vector<uInt32>& state);
+    static Outcome getOutcome(Thumbulator& thumb, uInt32 cycles);
+    static uInt64 ramHash(const Thumbulator& thumb);
+
+    void writeRun(const Run& run);
+    bool readRun(std::ifstream& in, Run& run, size_t stateSize);
+
+  private:
+    // Recording
+    std::ofstream myOut;
+    Thumbulator* myRecorded{nullptr};
+    std::vector<uInt16> myLastRam;  // RAM at the end of the last recorded run
+    Run myRun;                      // the run currently recorded
+
+    // Replaying
+    std::vector<uInt16> myRom;
+    std::vector<uInt16> myRam;
+    std::vector<uInt16> myStartRam;
+    std::vector<Run> myRuns;
+    unique_ptr<Thumbulator> myThumb;
+    const Run* myReplayed{nullptr};
+    size_t myCallback{0};
+    uInt64 myInstructions{0};
+    string myError;
+
+  private:
+    // Following constructors and assignment operators not supported
+    ThumbRecorder(const ThumbRecorder&) = delete;
+    ThumbRecorder(ThumbRecorder&&) = delete;
+    ThumbRecorder& operator=(const ThumbRecorder&) = delete;
+    ThumbRecorder& operator=(ThumbRecorder&&) = delete;
+};
+
+#endif
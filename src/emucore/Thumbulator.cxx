@@ -26,6 +26,7 @@
 #include "Base.hxx"
 #include "Cart.hxx"
 #include "Thumbulator.hxx"
+#include "ThumbRecorder.hxx"
 using Common::Base;
 
 // Uncomment the following to enable specific functionality
@@ -129,6 +130,79 @@ using Common::Base;
   #define THUMB_STAT(statement)
 #endif
 
+// Use direct-threaded dispatch (computed goto) where the compiler supports it,
+// otherwise dispatch through the switch statement in execute()
+#if defined(__GNUC__) && !defined(THUMB_DISS) && !defined(THUMB_DBUG)
+  #define THUMB_THREADED_DISPATCH
+#endif
+
+#ifdef THUMB_CYCLE_COUNT
+  #define INC_FETCH_CYCLES(addr) incFetchCycles(addr)
+#else
+  #define INC_FETCH_CYCLES(addr)
+#endif
+
+#ifdef THUMB_PROFILE
+  // 'Profiling' is the template parameter of execute()
+  #define PROFILE_INSTRUCTION(addr, op) \
+    if constexpr(Profiling)             \
+      profileInstruction(addr, op)
+#else
+  #define PROFILE_INSTRUCTION(addr, op)
+#endif
+
+#ifndef UNSAFE_OPTIMIZATIONS
+  #define COUNT_INSTRUCTION ++instructions
+#else
+  #define COUNT_INSTRUCTION
+#endif
+
+#ifdef COUNT_OPS
+  #define COUNT_OP(op) ++opCount[static_cast<int>(op)]
+#else
+  #define COUNT_OP(op)
+#endif
+
+// Start executing the current micro-op; the pipeline makes PC point two
+// instructions ahead
+#define FETCH_INSTRUCTION                                                  \
+  PROFILE_INSTRUCTION(pc - 2, decoded->op);                                \
+  INC_FETCH_CYCLES(pc - 2);                                                \
+  pc += 2;                                                                 \
+  reg_norm[15] = pc;                                                       \
+  inst = decoded->inst;                                                    \
+  COUNT_INSTRUCTION;                                                       \
+  COUNT_OP(decoded->op);                                                   \
+  DO_DISS(statusMsg << Base::HEX8 << (pc-5) << ": " << Base::HEX4 << inst << " ")
+
+#ifdef THUMB_THREADED_DISPATCH
+  #define OP_CASE(name) case Op::name: op_##name
+  #ifndef UNSAFE_OPTIMIZATIONS
+    #define OP_LABEL_SAFE(name) &&op_##name
+  #else
+    #define OP_LABEL_SAFE(name) &&invalidInstruction
+  #endif
+  #define DISPATCH_INSTRUCTION                                             \
+    do {                                                                   \
+      FETCH_INSTRUCTION;                                                   \
+      goto *dispatchTable[static_cast<uInt32>(decoded->op)];               \
+    } while(0)
+#else
+  #define OP_CASE(name) case Op::name
+  #define DISPATCH_INSTRUCTION goto dispatchInstruction
+#endif
+
+// Continue with the next micro-op of the current straight-line run, unless
+// the last instruction changed the program flow or the run has ended
+#define NEXT_INSTRUCTION                                                   \
+  do {                                                                     \
+    if(reg_norm[15] != pc || ++decoded == blockEnd)                        \
+      goto newBlock;                                                       \
+    DISPATCH_INSTRUCTION;                                                  \
+  } while(0)
+
+#define EXIT_EXECUTION goto exitExecution
+
 #define do_znflags(x) znFlags=(x)
 #define do_cflag_bit(x) cFlag = (x)
 #define do_vflag_bit(x) vFlag = (x)
@@ -144,14 +218,42 @@ Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, uInt32 rom_size
     cBase{c_base},
     cStart{c_start},
     cStack{c_stack},
-    decodedRom{make_unique<Op[]>(romSize / 2)},  // NOLINT
-    decodedParam{make_unique<uInt32[]>(romSize / 2)},  // NOLINT
+    decodedRom{make_unique<DecodedOp[]>(romSize / 2)},  // NOLINT
     ram{ram_ptr},
     configuration{configurefor},
     myCartridge{cartridge}
 {
+  // CDFJ+ allows more than 8 KB RAM depending on ROM sizes
+  switch(romSize)
+  {
+    case 64_KB:
+    case 128_KB:
+      ramSize = 16_KB;
+      break;
+
+    case 256_KB:
+    case 512_KB:
+      ramSize = 32_KB;
+      break;
+
+    default: // assuming 32 KB
+      ramSize = 8_KB;
+      break;
+  }
+  decodedRam = make_unique<DecodedOp[]>(ramSize / 2);  // NOLINT
+
+  // ROM code is decoded once; RAM code is decoded when it is executed and
+  // decoded again whenever its contents have been changed
   for(uInt32 i = 0; i < romSize / 2; ++i)
-    decodedRom[i] = decodeInstructionWord(CONV_RAMROM(rom[i]), i * 2);
+    decodeInstruction(decodedRom[i], CONV_RAMROM(rom[i]), i * 2);
+  for(uInt32 i = 0; i < ramSize / 2; ++i)
+    decodeInstruction(decodedRam[i], CONV_RAMROM(ram[i]), 0x40000000 | (i * 2));
+#ifndef UNSAFE_OPTIMIZATIONS
+  decodeInstruction(fatalFetchOp, 0, 0);
+#endif
+
+  setupMemoryMap();
+  setupHLE();
 
   setConsoleTiming(ConsoleTiming::ntsc);
 #ifndef UNSAFE_OPTIMIZATIONS
@@ -168,14 +270,16 @@ string Thumbulator::doRun(uInt32& cycles, bool irqDrivenAudio)
 {
   _irqDrivenAudio = irqDrivenAudio;
   reset();
-  for(;;)
+#ifdef THUMB_PROFILE
+  if(_profiling)
   {
-    if(execute()) break;
-#ifndef UNSAFE_OPTIMIZATIONS
-    if(_stats.instructions > 500000) // way more than would otherwise be possible
-      throw runtime_error("instructions > 500000");
-#endif
+    profileRunStart();
+    execute<true>();
+    profileRunEnd();
   }
+  else
+#endif
+    execute<false>();
 #ifdef THUMB_CYCLE_COUNT
   _totalCycles *= _armCyclesFactor;
 
@@ -237,8 +341,21 @@ void Thumbulator::updateTimer(uInt32 cycles)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string Thumbulator::run(uInt32& cycles, bool irqDrivenAudio)
 {
+  if(myRecorder)
+    myRecorder->startRun(*this, cycles, irqDrivenAudio);
   updateTimer(cycles);
-  return doRun(cycles, irqDrivenAudio);
+  string result = doRun(cycles, irqDrivenAudio);
+  if(myRecorder)
+    myRecorder->endRun(*this, cycles);
+  return result;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Thumbulator::thumbCallback(uInt8 function, uInt32 value1, uInt32 value2)
+{
+  return myRecorder
+    ? myRecorder->callback(myCartridge, function, value1, value2)
+    : myCartridge->thumbCallback(function, value1, value2);
 }
 
 #ifndef UNSAFE_OPTIMIZATIONS
@@ -296,12 +413,78 @@ void Thumbulator::dump_regs()
 #endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-FORCE_INLINE uInt32 Thumbulator::fetch16(uInt32 addr)
+FORCE_INLINE const Thumbulator::DecodedOp*
+Thumbulator::lookupBlock(uInt32 addr, const DecodedOp*& blockEnd)
 {
+  switch(addr & 0xF0000000)
+  {
+    case 0x00000000: //ROM
+      addr &= ROMADDMASK;
 #ifndef UNSAFE_OPTIMIZATIONS
-  uInt32 data = 0;
+      if(addr < 0x50)
+        fatalError("fetch16", addr, "abort");
+      if(addr >= romSize)
+      {
+        fatalError("fetch16", addr, "abort - out of range");
+        return fatalFetch(blockEnd);
+      }
+#endif
+      DO_DBUG(statusMsg << "fetch16(" << Base::HEX8 << addr << ")=" << Base::HEX4 << decodedRom[addr >> 1].inst << '\n');
+      // ROM code cannot change, so the run continues until the end of ROM
+      blockEnd = &decodedRom[romSize / 2 - 1] + 1;
+      return &decodedRom[addr >> 1];
+
+    case 0x40000000: //RAM
+    {
+      addr &= RAMADDMASK;
+#ifndef UNSAFE_OPTIMIZATIONS
+      if(addr >= ramSize)
+      {
+        fatalError("fetch16", addr, "abort - out of range");
+        return fatalFetch(blockEnd);
+      }
+#else
+      addr &= ramSize - 1;
+#endif
+      // RAM code may be modified by the ARM or the 6507 side at any time, so
+      // each instruction is checked against the current RAM contents and
+      // forms a run of its own
+      DecodedOp& decoded = decodedRam[addr >> 1];
+      const uInt16 inst = CONV_RAMROM(ram[addr >> 1]);
+      if(decoded.inst != inst)
+        decodeInstruction(decoded, inst, 0x40000000 | addr);
+      DO_DBUG(statusMsg << "fetch16(" << Base::HEX8 << addr << ")=" << Base::HEX4 << inst << '\n');
+      blockEnd = &decoded + 1;
+      return &decoded;
+    }
+
+    default:  // reserved
+      break;
+  }
+#ifndef UNSAFE_OPTIMIZATIONS
+  fatalError("fetch16", addr, "abort");
+  return fatalFetch(blockEnd);
+#else
+  return nullptr;
+#endif
+}
+
+#ifndef UNSAFE_OPTIMIZATIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FORCE_INLINE const Thumbulator::DecodedOp*
+Thumbulator::fatalFetch(const DecodedOp*& blockEnd)
+{
+  // Only reached if fatal errors are not trapped; like the old fetch16(),
+  // the invalid fetch yields instruction 0 and the emulation continues
+  blockEnd = &fatalFetchOp + 1;
+  return &fatalFetchOp;
+}
+#endif
 
 #ifdef THUMB_CYCLE_COUNT
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FORCE_INLINE void Thumbulator::incFetchCycles(uInt32 addr)
+{
   _pipeIdx = (_pipeIdx+1) % 3;
 
 #ifdef MERGE_I_S
@@ -331,45 +514,133 @@ FORCE_INLINE uInt32 Thumbulator::fetch16(uInt32 addr)
   }
   _prefetchCycleType[_pipeIdx] = CycleType::S; // default
   //_prefetchAccessType[_pipeIdx] = AccessType::prefetch; // default
+}
 #endif
 
-  switch(addr & 0xF0000000)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::setupMemoryMap()
+{
+  myReadPages.fill(nullptr);
+  myWritePages.fill(nullptr);
+
+  // Unmapped pages act as sentinels, their accesses are handled (and range
+  // checked) by the slow path.
+  // When range checking is enabled, the first ROM and RAM pages also use
+  // the slow path, because they contain the protected driver areas.
+#ifndef UNSAFE_OPTIMIZATIONS
+  constexpr uInt32 firstPage = 1;
+#else
+  constexpr uInt32 firstPage = 0;
+#endif
+  const auto* romBase = reinterpret_cast<const uInt8*>(rom);
+  auto* ramBase = reinterpret_cast<uInt8*>(ram);
+
+  for(uInt32 page = firstPage; page < romSize / PAGE_SIZE; ++page)
+    myReadPages[pageIndex(0x00000000 + page * PAGE_SIZE)] = romBase + page * PAGE_SIZE;
+
+  for(uInt32 page = 0; page < ramSize / PAGE_SIZE; ++page)
   {
-    case 0x00000000: //ROM
-      addr &= ROMADDMASK;
-      if(addr < 0x50)
-        fatalError("fetch16", addr, "abort");
-      addr >>= 1;
-      data = CONV_RAMROM(rom[addr]);
-      DO_DBUG(statusMsg << "fetch16(" << Base::HEX8 << addr << ")=" << Base::HEX4 << data << '\n');
-      return data;
+    myReadPages[pageIndex(0x40000000 + page * PAGE_SIZE)] = ramBase + page * PAGE_SIZE;
+    if(page >= firstPage)
+      myWritePages[pageIndex(0x40000000 + page * PAGE_SIZE)] = ramBase + page * PAGE_SIZE;
+  }
+}
 
-    case 0x40000000: //RAM
-      addr &= RAMADDMASK;
-      addr >>= 1;
-      data = CONV_RAMROM(ram[addr]);
-      DO_DBUG(statusMsg << "fetch16(" << Base::HEX8 << addr << ")=" << Base::HEX4 << data << '\n');
-      return data;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FORCE_INLINE uInt32 Thumbulator::pageIndex(uInt32 addr)
+{
+  // Only the lower REGION_SIZE bytes of each 256 MB region can be mapped
+  return addr & (0x0FFFFFFF & ~(REGION_SIZE - 1))
+    ? UNMAPPED_PAGE
+    : ((addr >> 28) * REGION_PAGES) + ((addr & (REGION_SIZE - 1)) / PAGE_SIZE);
+}
 
-    default:  // reserved
-      break;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FORCE_INLINE uInt32 Thumbulator::read16(uInt32 addr)
+{
+#ifndef UNSAFE_OPTIMIZATIONS
+  if(addr & 1)
+    fatalError("read16", addr, "abort - misaligned");
+#endif
+  THUMB_STAT(_stats.reads)
+
+  const uInt8* page = myReadPages[pageIndex(addr)];
+  if(page)
+  {
+    const uInt32 data = CONV_RAMROM(*reinterpret_cast<const uInt16*>(page + (addr & (PAGE_SIZE - 2))));
+    DO_DBUG(statusMsg << "read16(" << Base::HEX8 << addr << ")=" << Base::HEX4 << data << '\n');
+    return data;
   }
-  return fatalError("fetch16", addr, "abort");
-#else
-  addr &= ROMADDMASK;
-  addr >>= 1;
-  return CONV_RAMROM(rom[addr]);
+  return read16Slow(addr);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FORCE_INLINE uInt32 Thumbulator::read32(uInt32 addr)
+{
+#ifndef UNSAFE_OPTIMIZATIONS
+  if(addr & 3)
+    fatalError("read32", addr, "abort - misaligned");
 #endif
+
+  const uInt8* page = myReadPages[pageIndex(addr)];
+  if(page)
+  {
+    THUMB_STAT(_stats.reads)
+    THUMB_STAT(_stats.reads)
+    const auto* data = reinterpret_cast<const uInt16*>(page + (addr & (PAGE_SIZE - 4)));
+    const uInt32 lo = CONV_RAMROM(data[0]);
+    const uInt32 hi = CONV_RAMROM(data[1]);
+    const uInt32 result = lo | (hi << 16);
+    DO_DBUG(statusMsg << "read32(" << Base::HEX8 << addr << ")=" << Base::HEX8 << result << '\n');
+    return result;
+  }
+  return read32Slow(addr);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Thumbulator::write16(uInt32 addr, uInt32 data)
+FORCE_INLINE void Thumbulator::write16(uInt32 addr, uInt32 data)
 {
 #ifndef UNSAFE_OPTIMIZATIONS
   if(addr & 1)
     fatalError("write16", addr, "abort - misaligned");
 #endif
   THUMB_STAT(_stats.writes)
+
+  uInt8* page = myWritePages[pageIndex(addr)];
+  if(page)
+  {
+    DO_DBUG(statusMsg << "write16(" << Base::HEX8 << addr << "," << Base::HEX8 << data << ")\n");
+    *reinterpret_cast<uInt16*>(page + (addr & (PAGE_SIZE - 2))) = CONV_DATA(data);
+    return;
+  }
+  write16Slow(addr, data);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FORCE_INLINE void Thumbulator::write32(uInt32 addr, uInt32 data)
+{
+#ifndef UNSAFE_OPTIMIZATIONS
+  if(addr & 3)
+    fatalError("write32", addr, "abort - misaligned");
+#endif
+
+  uInt8* page = myWritePages[pageIndex(addr)];
+  if(page)
+  {
+    THUMB_STAT(_stats.writes)
+    THUMB_STAT(_stats.writes)
+    DO_DBUG(statusMsg << "write32(" << Base::HEX8 << addr << "," << Base::HEX8 << data << ")\n");
+    auto* dest = reinterpret_cast<uInt16*>(page + (addr & (PAGE_SIZE - 4)));
+    dest[0] = CONV_DATA(data);
+    dest[1] = CONV_DATA(data >> 16);
+    return;
+  }
+  write32Slow(addr, data);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::write16Slow(uInt32 addr, uInt32 data)
+{
   DO_DBUG(statusMsg << "write16(" << Base::HEX8 << addr << "," << Base::HEX8 << data << ")\n");
 
   switch(addr & 0xF0000000) // NOLINT (missing default for UNSAFE_OPTIMIZATIONS)
@@ -405,12 +676,8 @@ void Thumbulator::write16(uInt32 addr, uInt32 data)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Thumbulator::write32(uInt32 addr, uInt32 data)
+void Thumbulator::write32Slow(uInt32 addr, uInt32 data)
 {
-#ifndef UNSAFE_OPTIMIZATIONS
-  if(addr & 3)
-    fatalError("write32", addr, "abort - misaligned");
-#endif
   DO_DBUG(statusMsg << "write32(" << Base::HEX8 << addr << "," << Base::HEX8 << data << ")\n");
 
   switch(addr & 0xF0000000) // NOLINT (missing default for UNSAFE_OPTIMIZATIONS)
@@ -566,19 +833,7 @@ FORCE_INLINE bool Thumbulator::isInvalidROM(uInt32 addr) const
 FORCE_INLINE bool Thumbulator::isInvalidRAM(uInt32 addr) const
 {
   // Note: addr is already checked for RAM (0x4xxxxxxx)
-  switch(romSize) // CDFJ+ allows more than 8 KB RAM depending on ROM sizes
-  {
-    case 64_KB:
-    case 128_KB:
-      return addr > 0x40003fff; // 16 KB
-
-    case 256_KB:
-    case 512_KB:
-      return addr > 0x40007fff; // 32 KB
-
-    default: // assuming 32 KB
-      return addr > 0x40001fff; // 8 KB
-  }
+  return addr >= 0x40000000 + ramSize;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -617,14 +872,9 @@ FORCE_INLINE bool Thumbulator::isProtectedRAM(uInt32 addr)
 #endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 Thumbulator::read16(uInt32 addr)
+uInt32 Thumbulator::read16Slow(uInt32 addr)
 {
   uInt32 data = 0;
-#ifndef UNSAFE_OPTIMIZATIONS
-  if(addr & 1)
-    fatalError("read16", addr, "abort - misaligned");
-#endif
-  THUMB_STAT(_stats.reads)
 
   switch(addr & 0xF0000000) // NOLINT (missing default for UNSAFE_OPTIMIZATIONS)
   {
@@ -668,13 +918,8 @@ uInt32 Thumbulator::read16(uInt32 addr)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 Thumbulator::read32(uInt32 addr)
+uInt32 Thumbulator::read32Slow(uInt32 addr)
 {
-#ifndef UNSAFE_OPTIMIZATIONS
-  if(addr & 3)
-    fatalError("read32", addr, "abort - misaligned");
-#endif
-
   uInt32 data = 0;
   switch(addr & 0xF0000000) // NOLINT (missing default for UNSAFE_OPTIMIZATIONS)
   {
@@ -836,7 +1081,16 @@ void Thumbulator::do_cvflag(uInt32 a, uInt32 b, uInt32 c)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Thumbulator::Op Thumbulator::decodeInstructionWord(uint16_t inst, uInt32 pc) {
+void Thumbulator::decodeInstruction(DecodedOp& decoded, uInt16 inst, uInt32 pc)
+{
+  decoded.inst = inst;
+  decoded.param = 0;
+  decoded.op = decodeInstructionWord(inst, pc, decoded.param);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Thumbulator::Op Thumbulator::decodeInstructionWord(uint16_t inst, uInt32 pc,
+                                                   uInt32& param) {
   //ADC add with carry
   if((inst & 0xFFC0) == 0x4140) return Op::adc;
 
@@ -881,7 +1135,7 @@ Thumbulator::Op Thumbulator::decodeInstructionWord(uint16_t inst, uInt32 pc) {
     rb <<= 1;
     rb += pc;
     rb += 2;
-    decodedParam[pc / 2] = rb + 4;
+    param = rb + 4;
 
     switch(op)
     {
@@ -942,7 +1196,7 @@ Thumbulator::Op Thumbulator::decodeInstructionWord(uint16_t inst, uInt32 pc) {
     rb <<= 1;
     rb += pc;
     rb += 2;
-    decodedParam[pc / 2] = rb + 4;
+    param = rb + 4;
 
     return Op::b2;
   }
@@ -1137,48 +1391,598 @@ Thumbulator::Op Thumbulator::decodeInstructionWord(uint16_t inst, uInt32 pc) {
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
+void Thumbulator::setupHLE()
 {
-  uInt32 sp, inst, ra, rb, rc, rm, rd, rn, rs;  // NOLINT
+  // The routines are recognized by their exact code, which is generated
+  // unchanged into most ARM games (as halfwords in ARM memory order)
+  struct Signature {
+    HleType type;
+    uInt32 size;
+    std::array<uInt16, 11> code;
+  };
+  static constexpr std::array<Signature, 6> signatures = {{
+    // push {r4,lr}; movs r3,#0; b 1f; 0: ldrb r4,[r1,r3]; strb r4,[r0,r3];
+    // adds r3,#1; 1: cmp r3,r2; blt 0b; pop {r4}; pop {r0}; bx r0
+    { HleType::memcpy_bx, 11, { 0xb510, 0x2300, 0xe002, 0x5ccc, 0x54c4, 0x3301,
+                                0x4293, 0xdbfa, 0xbc10, 0xbc01, 0x4700 } },
+    // ... pop {r4,pc}
+    { HleType::memcpy_pc,  9, { 0xb510, 0x2300, 0xe002, 0x5ccc, 0x54c4, 0x3301,
+                                0x4293, 0xdbfa, 0xbd10 } },
+    // push {r4,lr}; movs r3,r0; b 1f; 0: strb r1,[r3]; adds r3,#1;
+    // 1: subs r4,r3,r0; cmp r4,r2; blt 0b; pop {r4}; pop {r0}; bx r0
+    { HleType::memset_bx, 11, { 0xb510, 0x1c03, 0xe001, 0x7019, 0x3301, 0x1a1c,
+                                0x4294, 0xdbfa, 0xbc10, 0xbc01, 0x4700 } },
+    // ... pop {r4,pc}
+    { HleType::memset_pc,  9, { 0xb510, 0x1c03, 0xe001, 0x7019, 0x3301, 0x1a1c,
+                                0x4294, 0xdbfa, 0xbd10 } },
+    // 0: subs r1,#4; bmi 1f; ldr r3,[r0,r1]; str r3,[r2,r1]; bne 0b; 1:
+    { HleType::copyWords,  5, { 0x3904, 0xd402, 0x5843, 0x5053, 0xd1fa } },
+    // 0: subs r1,#4; bmi 1f; str r0,[r2,r1]; bne 0b; 1:
+    { HleType::fillWords,  4, { 0x3904, 0xd401, 0x5050, 0xd1fb } },
+  }};
+
+  _hleRoutines.clear();
+  for(uInt32 i = 0; i < romSize / 2; ++i)
+  {
+    for(const auto& signature : signatures)
+    {
+      if(decodedRom[i].inst != signature.code[0] || i + signature.size > romSize / 2)
+        continue;
 
-#ifndef UNSAFE_OPTIMIZATIONS
-  uInt32 pc = read_register(15);
-#else
-  uInt32 pc = read_register(15) & ~1; // not checked and corrected in read_register
+      uInt32 j = 1;
+      while(j < signature.size && decodedRom[i + j].inst == signature.code[j])
+        ++j;
+      if(j == signature.size)
+      {
+        _hleRoutines.push_back({ signature.type, i * 2, decodedRom[i].op });
+        break;
+      }
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::enableHLE(bool enable)
+{
+#if defined(THUMB_DISS) || defined(THUMB_DBUG) || defined(__BIG_ENDIAN__)
+  // The native routines neither log nor convert the byte order
+  enable = false;
 #endif
+  if(enable == _hleEnabled)
+    return;
 
-  const uInt32 instructionPtr = pc - 2;
-  const uInt32 instructionPtr2 = instructionPtr >> 1;
-  inst = fetch16(instructionPtr);
+  _hleEnabled = enable;
+  for(uInt32 i = 0; i < _hleRoutines.size(); ++i)
+  {
+    const uInt32 addr = _hleRoutines[i].addr;
+    DecodedOp& decoded = decodedRom[addr >> 1];
 
-  pc += 2;
-#ifndef UNSAFE_OPTIMIZATIONS
-  write_register(15, pc, false);
-#else
-  write_register(15, pc);
+    if(enable)
+    {
+      decoded.op = Op::hle;
+      decoded.param = i;
+    }
+    else
+      decodeInstruction(decoded, decoded.inst, addr);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt8* Thumbulator::hostReadRange(uInt32 addr, uInt32 size) const
+{
+  // The whole range must be mapped to contiguous host memory
+  if(size == 0 || size > REGION_SIZE || addr + size < addr)
+    return nullptr;
+
+  const uInt32 first = pageIndex(addr), last = pageIndex(addr + size - 1);
+  const uInt8* base = myReadPages[first];
+  if(base == nullptr || last < first)
+    return nullptr;
+
+  for(uInt32 page = first + 1; page <= last; ++page)
+    if(myReadPages[page] != base + (page - first) * PAGE_SIZE)
+      return nullptr;
+
+  return base + (addr & (PAGE_SIZE - 1));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8* Thumbulator::hostWriteRange(uInt32 addr, uInt32 size) const
+{
+  // Byte stores read the surrounding halfword, so the range must be readable
+  // from the same host memory too
+  const uInt8* readable = hostReadRange(addr, size);
+  if(readable == nullptr)
+    return nullptr;
+
+  const uInt32 first = pageIndex(addr), last = pageIndex(addr + size - 1);
+  uInt8* base = myWritePages[first];
+  for(uInt32 page = first; page <= last; ++page)
+    if(myWritePages[page] != myReadPages[page] || myWritePages[page] == nullptr)
+      return nullptr;
+
+  return base + (addr & (PAGE_SIZE - 1));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Thumbulator::runHLE(const HleRoutine& routine)
+{
+  // Returns the number of instructions the routine would have executed, or
+  // 0 if it has to be interpreted (e.g. because it accesses memory outside
+  // the fast memory map or its cycles have to be counted).
+  // Registers, flags and memory are left exactly as the interpreted code
+  // would have left them.
+#ifdef THUMB_CYCLE_COUNT
+  if(_countCycles)
+    return 0;
+#endif
+#ifdef THUMB_PROFILE
+  // Profiled code is always interpreted
+  if(_profiling)
+    return 0;
 #endif
-  DO_DISS(statusMsg << Base::HEX8 << (pc-5) << ": " << Base::HEX4 << inst << " ");
 
-#ifndef UNSAFE_OPTIMIZATIONS
-  ++_stats.instructions;
+  switch(routine.type)
+  {
+    case HleType::memcpy_bx:
+    case HleType::memcpy_pc:
+    case HleType::memset_bx:
+    case HleType::memset_pc:
+    {
+      const bool isCopy = routine.type == HleType::memcpy_bx
+                          || routine.type == HleType::memcpy_pc;
+      const bool viaBx = routine.type == HleType::memcpy_bx
+                         || routine.type == HleType::memset_bx;
+      const uInt32 dst = reg_norm[0], sp = reg_norm[13], lr = reg_norm[14];
+      // the loops compare signed
+      const uInt32 size = static_cast<Int32>(reg_norm[2]) > 0 ? reg_norm[2] : 0;
+
+      // 'bx r0' to ARM code is handled by the cartridge
+      if(viaBx && !(lr & 1))
+        return 0;
+      if((sp & 3) || hostWriteRange(sp - 8, 8) == nullptr)
+        return 0;
+
+      uInt8* to = nullptr;
+      const uInt8* from = nullptr;
+      if(size)
+      {
+        // destination must not overlap the pushed registers
+        to = hostWriteRange(dst, size);
+        if(to == nullptr || (dst < sp && dst + size > sp - 8))
+          return 0;
+        if(isCopy && (from = hostReadRange(reg_norm[1], size)) == nullptr)
+          return 0;
+      }
+
+      // push {r4,lr}
+      write32(sp - 8, reg_norm[4]);
+      write32(sp - 4, lr);
+
+      if(isCopy)
+      {
+        if(to <= from || to >= from + size)
+          std::memmove(to, from, size);
+        else
+          // overlapping, the loop copies forwards byte by byte
+          for(uInt32 i = 0; i < size; ++i)
+            to[i] = from[i];
+      }
+      else
+        std::fill_n(to, size, static_cast<uInt8>(reg_norm[1]));
+
+      // final 'cmp' of the loop counter (r3 resp. r4) with r2
+      reg_norm[3] = isCopy ? size : dst + size;
+      do_znflags(size - reg_norm[2]);
+      do_cvflag(size, ~reg_norm[2], 1);
+
+      // pop {r4}; pop {r0}; bx r0 resp. pop {r4,pc}
+      if(viaBx)
+      {
+        reg_norm[0] = lr;
+        write_register(15, (lr + 2) & ~1U);
+      }
+      else
+        write_register(15, lr + 2);
+
+      return (isCopy ? 5 : 6) + size * 5 + (viaBx ? 3 : 1);
+    }
+
+    case HleType::copyWords:
+    case HleType::fillWords:
+    {
+      const bool isCopy = routine.type == HleType::copyWords;
+      // r1 is the offset after the last word, the words are processed downwards
+      const uInt32 count = reg_norm[1], dst = reg_norm[2];
+
+      if(static_cast<Int32>(count) < 0 || ((count | dst) & 3)
+         || (isCopy && (reg_norm[0] & 3)))
+        return 0;
+
+      if(count)
+      {
+        uInt8* to = hostWriteRange(dst, count);
+        if(to == nullptr)
+          return 0;
+
+        if(isCopy)
+        {
+          const uInt8* from = hostReadRange(reg_norm[0], count);
+          if(from == nullptr)
+            return 0;
+
+          if(to >= from || to + count <= from)
+            std::memmove(to, from, count);
+          else
+            for(uInt32 i = count; i > 0; i -= 4)
+              std::memcpy(to + i - 4, from + i - 4, 4);
+          // the last word loaded is the one stored at the lowest address
+          reg_norm[3] = read32(dst);
+        }
+        else
+        {
+          const uInt32 data = reg_norm[0];
+          for(uInt32 i = 0; i < count; i += 4)
+            std::memcpy(to + i, &data, 4);
+        }
+
+        // the loop ends with 'subs r1,#4' resulting in zero and falling
+        // through 'bne'
+        reg_norm[1] = 0;
+        do_znflags(0);
+        do_cvflag(4, ~4U, 1);
+        reg_norm[15] = routine.addr + (isCopy ? 12 : 10);
+        return (isCopy ? 5 : 4) * (count / 4);
+      }
+
+      // 'subs r1,#4' results in a negative value, 'bmi' leaves the loop
+      reg_norm[1] = count - 4;
+      do_znflags(count - 4);
+      do_cvflag(count, ~4U, 1);
+      write_register(15, decodedRom[(routine.addr + 2) >> 1].param);
+      return 2;
+    }
+
+    default:
+      return 0;
+  }
+}
+
+#ifdef THUMB_PROFILE
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::enableProfiling(bool enable)
+{
+  _profiling = enable;
+  if(enable && _profileNodes.empty())
+    resetProfile();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::resetProfile()
+{
+  _profileRuns = 0;
+  _profileAddrs.assign((romSize + ramSize) / 2, ProfileCounter());
+  _profileNodes.clear();
+  _profileNodes.push_back({ cStart, 0, {}, {} });
+  _profileStack.clear();
+  _profileNode = 0;
+  _profileOp = Op::invalid;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Thumbulator::profileIndex(uInt32 addr) const
+{
+  if(addr < romSize)
+    return addr >> 1;
+  if((addr & 0xF0000000) == 0x40000000 && (addr & 0x0FFFFFFF) < ramSize)
+    return (romSize + (addr & 0x0FFFFFFF)) >> 1;
+  return UINT32_MAX;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::profileRunStart()
+{
+  // Each run starts at the root node
+  ++_profileRuns;
+  _profileStack.clear();
+  _profileNode = 0;
+  _profileOp = Op::invalid;
+  _profileCycles = _totalCycles;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::profileInstruction(uInt32 addr, Op op)
+{
+  // Limits the call tree for deeply recursive code
+  constexpr size_t MAX_DEPTH = 256;
+
+  if(_profileOp != Op::invalid)
+  {
+    // The cycles counted since the last fetch belong to the last instruction
+    const uInt32 cycles = _totalCycles - _profileCycles;
+    const uInt32 lastIdx = profileIndex(_profileAddr);
+
+    if(lastIdx != UINT32_MAX)
+      _profileAddrs[lastIdx].cycles += cycles;
+    _profileNodes[_profileNode].counter.cycles += cycles;
+
+    if(addr != _profileAddr + 2)  // program flow changed
+    {
+      if((_profileOp == Op::blx_thumb || _profileOp == Op::blx2)
+         && _profileStack.size() < MAX_DEPTH)
+      {
+        // Function call, enter the callee's node
+        _profileStack.push_back({ reg_norm[14] & ~1U, _profileNode });
+
+        uInt32 callee = 0;
+        for(const uInt32 child : _profileNodes[_profileNode].children)
+          if(_profileNodes[child].function == addr)
+          {
+            callee = child;
+            break;
+          }
+        if(callee == 0)
+        {
+          callee = static_cast<uInt32>(_profileNodes.size());
+          _profileNodes[_profileNode].children.push_back(callee);
+          _profileNodes.push_back({ addr, _profileNode, {}, {} });
+        }
+        _profileNode = callee;
+      }
+      else
+      {
+        // Returns may skip frames (e.g. when a callee was left by a jump)
+        for(size_t i = _profileStack.size(); i > 0; --i)
+          if(_profileStack[i - 1].returnAddr == addr)
+          {
+            _profileNode = _profileStack[i - 1].node;
+            _profileStack.resize(i - 1);
+            break;
+          }
+      }
+    }
+  }
+
+  const uInt32 idx = profileIndex(addr);
+  if(idx != UINT32_MAX)
+    ++_profileAddrs[idx].instructions;
+  ++_profileNodes[_profileNode].counter.instructions;
+
+  _profileAddr = addr;
+  _profileOp = op;
+  _profileCycles = _totalCycles;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::profileRunEnd()
+{
+  if(_profileOp == Op::invalid)
+    return;
+
+  const uInt32 cycles = _totalCycles - _profileCycles;
+  const uInt32 idx = profileIndex(_profileAddr);
+
+  if(idx != UINT32_MAX)
+    _profileAddrs[idx].cycles += cycles;
+  _profileNodes[_profileNode].counter.cycles += cycles;
+  _profileOp = Op::invalid;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::writeCollapsedProfile(ostream& out) const
+{
+  bool hasCycles = false;
+  for(const auto& node : _profileNodes)
+    hasCycles |= node.counter.cycles != 0;
+
+  std::vector<uInt32> stack;
+  for(uInt32 i = 0; i < _profileNodes.size(); ++i)
+  {
+    const ProfileCounter& counter = _profileNodes[i].counter;
+    const uInt64 count = hasCycles ? counter.cycles : counter.instructions;
+    if(count == 0)
+      continue;
+
+    stack.clear();
+    for(uInt32 n = i; n != 0; n = _profileNodes[n].parent)
+      stack.push_back(_profileNodes[n].function);
+    stack.push_back(_profileNodes[0].function);
+
+    for(auto it = stack.rbegin(); it != stack.rend(); ++it)
+      out << (it == stack.rbegin() ? "0x" : ";0x") << Base::HEX8 << *it;
+    out << std::dec << std::setfill(' ') << ' ' << count << '\n';
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::writeProfileSummary(ostream& out, uInt32 maxLines) const
+{
+  struct Entry {
+    uInt32 addr{0};
+    uInt64 self{0};
+    uInt64 total{0};
+  };
+  ProfileCounter sum;
+  for(const auto& node : _profileNodes)
+  {
+    sum.instructions += node.counter.instructions;
+    sum.cycles += node.counter.cycles;
+  }
+  const bool hasCycles = sum.cycles != 0;
+  const auto value = [hasCycles](const ProfileCounter& counter) {
+    return hasCycles ? counter.cycles : counter.instructions;
+  };
+
+  // Accumulate the nodes per function, recursive calls are counted only once
+  // for the function's total
+  std::vector<Entry> functions;
+  const auto function = [&functions](uInt32 addr) -> Entry& {
+    for(auto& entry : functions)
+      if(entry.addr == addr)
+        return entry;
+    functions.push_back({ addr, 0, 0 });
+    return functions.back();
+  };
+  std::vector<uInt32> counted;
+  for(uInt32 i = 0; i < _profileNodes.size(); ++i)
+  {
+    const uInt64 count = value(_profileNodes[i].counter);
+
+    function(_profileNodes[i].function).self += count;
+    counted.clear();
+    for(uInt32 n = i; ; n = _profileNodes[n].parent)
+    {
+      const uInt32 addr = _profileNodes[n].function;
+      if(std::find(counted.begin(), counted.end(), addr) == counted.end())
+      {
+        counted.push_back(addr);
+        function(addr).total += count;
+      }
+      if(n == 0)
+        break;
+    }
+  }
+
+  std::vector<Entry> addrs;
+  for(uInt32 i = 0; i < _profileAddrs.size(); ++i)
+  {
+    const uInt64 count = value(_profileAddrs[i]);
+    if(count)
+      addrs.push_back({ i < romSize / 2 ? i * 2 : 0x40000000 + i * 2 - romSize, count, 0 });
+  }
+
+  const auto bySelf = [](const Entry& a, const Entry& b) {
+    return a.self > b.self || (a.self == b.self && a.addr < b.addr);
+  };
+  std::sort(functions.begin(), functions.end(), bySelf);
+  std::sort(addrs.begin(), addrs.end(), bySelf);
+
+  const double total = std::max<double>(static_cast<double>(value(sum)), 1);
+  const auto percent = [total](uInt64 count) {
+    return 100.0 * static_cast<double>(count) / total;
+  };
+
+  const auto line = [&out, percent](uInt32 addr, uInt64 self) -> ostream& {
+    // Note: the hex format resets the floating point format
+    return out << "0x" << Base::HEX8 << addr << std::dec << std::setfill(' ')
+               << std::fixed << std::setprecision(1) << std::setw(7) << percent(self);
+  };
+
+  out << "ARM profile of " << _profileRuns << " runs: " << sum.instructions
+      << " instructions, " << sum.cycles << " cycles\n"
+      << "Function    Self%  Total%\n";
+  for(uInt32 i = 0; i < functions.size() && i < maxLines; ++i)
+    line(functions[i].addr, functions[i].self)
+      << std::setw(8) << percent(functions[i].total) << '\n';
+  out << (hasCycles ? "Address     Cycles%\n" : "Address     Instructions%\n");
+  for(uInt32 i = 0; i < addrs.size() && i < maxLines; ++i)
+    line(addrs[i].addr, addrs[i].self) << '\n';
+}
 #endif
 
-  Op decodedOp{};
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#ifdef THUMB_THREADED_DISPATCH
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wpedantic"  // computed goto
+#endif
+template<bool Profiling>
+int Thumbulator::execute()  // NOLINT (readability-function-size)
+{
+  uInt32 sp, inst, ra, rb, rc, rm, rd, rn, rs;  // NOLINT
+  uInt32 pc = 0;
+  const DecodedOp* decoded = nullptr;   // the micro-op currently executed
+  const DecodedOp* blockEnd = nullptr;  // end of the current straight-line run
 #ifndef UNSAFE_OPTIMIZATIONS
-  if ((instructionPtr & 0xF0000000) == 0 && instructionPtr < romSize)
-    decodedOp = decodedRom[instructionPtr2];
-  else
-    decodedOp = decodeInstructionWord(CONV_RAMROM(rom[instructionPtr2]), instructionPtr);
-#else
-  decodedOp = decodedRom[(instructionPtr & ROMADDMASK) >> 1];
+  uInt32 instructions = 0;
+#endif
+#ifndef THUMB_THREADED_DISPATCH
+  Op op = Op::invalid;  // the op dispatched by the switch statement
 #endif
 
-#ifdef COUNT_OPS
-  ++opCount[static_cast<int>(decodedOp)];
+#ifdef THUMB_THREADED_DISPATCH
+  // Handler addresses, in the order of the Op enum
+  static const void* const dispatchTable[] = {
+    &&invalidInstruction,
+    &&op_adc,
+    &&op_add1, &&op_add2, &&op_add3, &&op_add4, &&op_add5, &&op_add6, &&op_add7,
+    &&op_and_,
+    &&op_asr1, &&op_asr2,
+    &&op_beq, &&op_bne, &&op_bcs, &&op_bcc, &&op_bmi, &&op_bpl, &&op_bvs,
+    &&op_bvc, &&op_bhi, &&op_bls, &&op_bge, &&op_blt, &&op_bgt, &&op_ble,
+    &&op_b2,
+    &&op_bic,
+    OP_LABEL_SAFE(bkpt),
+    &&op_bl, &&op_blx_thumb, &&op_blx_arm,
+    &&op_blx2,
+    &&op_bx,
+    &&op_cmn,
+    &&op_cmp1, &&op_cmp2, &&op_cmp3,
+    OP_LABEL_SAFE(cps),
+    &&op_cpy,
+    &&op_eor,
+    &&op_ldmia,
+    &&op_ldr1, &&op_ldr2, &&op_ldr3, &&op_ldr4,
+    &&op_ldrb1, &&op_ldrb2,
+    &&op_ldrh1, &&op_ldrh2,
+    &&op_ldrsb,
+    &&op_ldrsh,
+    &&op_lsl1, &&op_lsl2,
+    &&op_lsr1, &&op_lsr2,
+    &&op_mov1, &&op_mov2, &&op_mov3,
+    &&op_mul,
+    &&op_mvn,
+    &&op_neg,
+    &&op_orr,
+    &&op_pop,
+    &&op_push,
+    &&op_rev,
+    &&op_rev16,
+    &&op_revsh,
+    &&op_ror,
+    &&op_sbc,
+    OP_LABEL_SAFE(setend),
+    &&op_stmia,
+    &&op_str1, &&op_str2, &&op_str3,
+    &&op_strb1, &&op_strb2,
+    &&op_strh1, &&op_strh2,
+    &&op_sub1, &&op_sub2, &&op_sub3, &&op_sub4,
+    &&op_swi,
+    &&op_sxtb,
+    &&op_sxth,
+    &&op_tst,
+    &&op_uxtb,
+    &&op_uxth,
+    &&op_hle,
+    &&invalidInstruction  // numOps
+  };
+  static_assert(std::size(dispatchTable) == static_cast<size_t>(Op::numOps) + 1,
+                "dispatch table does not match Op enum");
+#endif
+
+newBlock:
+  // Called for the first instruction and after every change of program flow
+#ifndef UNSAFE_OPTIMIZATIONS
+  _stats.instructions = instructions;
+  if(instructions > 500000) // way more than would otherwise be possible
+    throw runtime_error("instructions > 500000");
+#endif
+  pc = reg_norm[15] & ~1;
+  decoded = lookupBlock(pc - 2, blockEnd);
+  if(decoded == nullptr)
+    EXIT_EXECUTION;
+  DISPATCH_INSTRUCTION;
+
+#ifndef THUMB_THREADED_DISPATCH
+dispatchInstruction:
+  FETCH_INSTRUCTION;
+  op = decoded->op;
+dispatchOp:
+  switch (op) {
+#else
+  switch (decoded->op) {
 #endif
-  switch (decodedOp) {
     //ADC
-    case Op::adc: {
+    OP_CASE(adc): {
       rd = (inst >> 0) & 0x07;
       rm = (inst >> 3) & 0x07;
       DO_DISS(statusMsg << "adc r" << dec << rd << ",r" << dec << rm << '\n');
@@ -1191,11 +1995,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       do_znflags(rc);
       if(cFlag) do_cvflag(ra, rb, 1);
       else      do_cvflag(ra, rb, 0);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ADD(1) small immediate two registers
-    case Op::add1: {
+    OP_CASE(add1): {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rb = (inst >> 6) & 0x7;
@@ -1209,7 +2013,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
         write_register(rd, rc);
         do_znflags(rc);
         do_cvflag(ra, rb, 0);
-        return 0;
+        NEXT_INSTRUCTION;
       }
       else
       {
@@ -1219,7 +2023,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
     }
 
     //ADD(2) big immediate one register
-    case Op::add2: {
+    OP_CASE(add2): {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x7;
       DO_DISS(statusMsg << "adds r" << dec << rd << ",#0x" << Base::HEX2 << rb << '\n');
@@ -1228,11 +2032,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       do_cvflag(ra, rb, 0);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ADD(3) three registers
-    case Op::add3: {
+    OP_CASE(add3): {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -1243,11 +2047,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       do_cvflag(ra, rb, 0);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ADD(4) two registers one or both high no flags
-    case Op::add4: {
+    OP_CASE(add4): {
       if((inst >> 6) & 3)
       {
         //UNPREDICTABLE
@@ -1270,11 +2074,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       }
       //fprintf(stderr,"0x%08X = 0x%08X + 0x%08X\n",rc,ra,rb);
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ADD(5) rd = pc plus immediate
-    case Op::add5: {
+    OP_CASE(add5): {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x7;
       rb <<= 2;
@@ -1282,11 +2086,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       ra = read_register(15);
       rc = (ra & (~3U)) + rb;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ADD(6) rd = sp plus immediate
-    case Op::add6: {
+    OP_CASE(add6): {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x7;
       rb <<= 2;
@@ -1294,22 +2098,22 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       ra = read_register(13);
       rc = ra + rb;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ADD(7) sp plus immediate
-    case Op::add7: {
+    OP_CASE(add7): {
       rb = (inst >> 0) & 0x7F;
       rb <<= 2;
       DO_DISS(statusMsg << "add SP,#0x" << Base::HEX2 << rb << '\n');
       ra = read_register(13);
       rc = ra + rb;
       write_register(13, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //AND
-    case Op::and_: {
+    OP_CASE(and_): {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "ands r" << dec << rd << ",r" << dec << rm << '\n');
@@ -1318,11 +2122,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = ra & rb;
       write_register(rd, rc);
       do_znflags(rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ASR(1) two register immediate
-    case Op::asr1: {
+    OP_CASE(asr1): {
       rd = (inst >> 0) & 0x07;
       rm = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -1352,11 +2156,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       INC_SHIFT_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ASR(2) two register
-    case Op::asr2: {
+    OP_CASE(asr2): {
       rd = (inst >> 0) & 0x07;
       rs = (inst >> 3) & 0x07;
       DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rs << '\n');
@@ -1392,125 +2196,125 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       INC_SHIFT_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //B(1) conditional branch variants:
     // (beq, bne, bcs, bcc, bmi, bpl, bvs, bvc, bhi, bls, bge, blt, bgt, ble)
-    case Op::beq: {
+    OP_CASE(beq): {
       THUMB_STAT(_stats.branches)
       if(!znFlags)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, decoded->param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bne: {
+    OP_CASE(bne): {
       THUMB_STAT(_stats.branches)
       if(znFlags)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, decoded->param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bcs: {
+    OP_CASE(bcs): {
       THUMB_STAT(_stats.branches)
       if(cFlag)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, decoded->param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bcc: {
+    OP_CASE(bcc): {
       THUMB_STAT(_stats.branches)
       if(!cFlag)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, decoded->param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bmi: {
+    OP_CASE(bmi): {
       THUMB_STAT(_stats.branches)
       if(znFlags & 0x80000000)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, decoded->param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bpl: {
+    OP_CASE(bpl): {
       THUMB_STAT(_stats.branches)
       if(!(znFlags & 0x80000000))
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, decoded->param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bvs: {
+    OP_CASE(bvs): {
       THUMB_STAT(_stats.branches)
       if(vFlag)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, decoded->param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bvc: {
+    OP_CASE(bvc): {
       THUMB_STAT(_stats.branches)
       if(!vFlag)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, decoded->param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bhi: {
+    OP_CASE(bhi): {
       THUMB_STAT(_stats.branches)
       if(cFlag && znFlags)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, decoded->param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bls: {
+    OP_CASE(bls): {
       THUMB_STAT(_stats.branches)
       if(!znFlags || !cFlag)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, decoded->param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bge: {
+    OP_CASE(bge): {
       THUMB_STAT(_stats.branches)
       if(((znFlags & 0x80000000) && vFlag) ||
          ((!(znFlags & 0x80000000)) && !vFlag))
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, decoded->param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::blt: {
+    OP_CASE(blt): {
       THUMB_STAT(_stats.branches)
       if((!(znFlags & 0x80000000) && vFlag) ||
          (((znFlags & 0x80000000)) && !vFlag))
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, decoded->param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bgt: {
+    OP_CASE(bgt): {
       THUMB_STAT(_stats.branches)
       if(znFlags)
       {
         if(((znFlags & 0x80000000) && vFlag) ||
            ((!(znFlags & 0x80000000)) && !vFlag))
-          write_register(15, decodedParam[instructionPtr2]);      }
-      return 0;
+          write_register(15, decoded->param);      }
+      NEXT_INSTRUCTION;
     }
 
-    case Op::ble: {
+    OP_CASE(ble): {
       THUMB_STAT(_stats.branches)
       if(!znFlags ||
          (!(znFlags & 0x80000000) && vFlag) ||
          (((znFlags & 0x80000000)) && !vFlag))
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, decoded->param);
+      NEXT_INSTRUCTION;
     }
 
     //B(2) unconditional branch
-    case Op::b2: {
+    OP_CASE(b2): {
       THUMB_STAT(_stats.branches)
-      write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+      write_register(15, decoded->param);
+      NEXT_INSTRUCTION;
     }
 
     //BIC
-    case Op::bic: {
+    OP_CASE(bic): {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "bics r" << dec << rd << ",r" << dec << rm << '\n');
@@ -1519,21 +2323,21 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = ra & (~rb);
       write_register(rd, rc);
       do_znflags(rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
 #ifndef UNSAFE_OPTIMIZATIONS
     //BKPT
-    case Op::bkpt: {
+    OP_CASE(bkpt): {
       rb = (inst >> 0) & 0xFF;
       statusMsg << "bkpt 0x" << Base::HEX2 << rb << '\n';
-      return 1;
+      EXIT_EXECUTION;
     }
 #endif
 
     //BL/BLX(1) variants
     // (bl, blx_thumb, blx_arm)
-    case Op::bl: {
+    OP_CASE(bl): {
       // branch to label
       DO_DISS(statusMsg << '\n');
       rb = inst & ((1 << 11) - 1);
@@ -1541,10 +2345,10 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rb <<= 12;
       rb += pc;
       write_register(14, rb);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
-    case Op::blx_thumb: {
+    OP_CASE(blx_thumb): {
       // branch to label, switch to thumb
       rb = read_register(14);
       rb += (inst & ((1 << 11) - 1)) << 1;
@@ -1552,10 +2356,10 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << '\n');
       write_register(14, (pc-2) | 1);
       write_register(15, rb);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
-    case Op::blx_arm: {
+    OP_CASE(blx_arm): {
       // branch to label, switch to arm
       //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
       // fxq: this should exit the code without having to detect it
@@ -1567,11 +2371,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << '\n');
       write_register(14, (pc-2) | 1);
       write_register(15, rb);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //BLX(2)
-    case Op::blx2: {
+    OP_CASE(blx2): {
       rm = (inst >> 3) & 0xF;
       DO_DISS(statusMsg << "blx r" << dec << rm << '\n');
       rc = read_register(rm);
@@ -1584,18 +2388,18 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
         rc &= ~1; // not checked and corrected in write_register
 #endif
         write_register(15, rc);
-        return 0;
+        NEXT_INSTRUCTION;
       }
       else
       {
         //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
         // fxq: this could serve as exit code
-        return 1;
+        EXIT_EXECUTION;
       }
     }
 
     //BX
-    case Op::bx: {
+    OP_CASE(bx): {
       rm = (inst >> 3) & 0xF;
       DO_DISS(statusMsg << "bx r" << dec << rm << '\n');
       rc = read_register(rm);
@@ -1606,7 +2410,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
         // branch to odd address denotes 16 bit ARM code
         rc &= ~1;
         write_register(15, rc);
-        return 0;
+        NEXT_INSTRUCTION;
       }
       else
       {
@@ -1643,22 +2447,22 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
 
             if      (pc == BUS_SetNote)
             {
-              myCartridge->thumbCallback(0, read_register(2), read_register(3));
+              thumbCallback(0, read_register(2), read_register(3));
               handled = true;
             }
             else if (pc == BUS_ResetWave)
             {
-              myCartridge->thumbCallback(1, read_register(2), 0);
+              thumbCallback(1, read_register(2), 0);
               handled = true;
             }
             else if (pc == BUS_GetWavePtr)
             {
-              write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
+              write_register(2, thumbCallback(2, read_register(2), 0));
               handled = true;
             }
             else if (pc == BUS_SetWaveSize)
             {
-              myCartridge->thumbCallback(3, read_register(2), read_register(3));
+              thumbCallback(3, read_register(2), read_register(3));
               handled = true;
             }
             else if (pc == 0x0000083a)
@@ -1674,7 +2478,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
               uInt32 r3 = read_register(3);
               uInt32 r4 = read_register(4);
   #endif
-              myCartridge->thumbCallback(255, 0, 0);
+              thumbCallback(255, 0, 0);
             }
 
             break;
@@ -1705,22 +2509,22 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
 
             if      (pc == CDF_SetNote)
             {
-              myCartridge->thumbCallback(0, read_register(2), read_register(3));
+              thumbCallback(0, read_register(2), read_register(3));
               handled = true;
             }
             else if (pc == CDF_ResetWave)
             {
-              myCartridge->thumbCallback(1, read_register(2), 0);
+              thumbCallback(1, read_register(2), 0);
               handled = true;
             }
             else if (pc == CDF_GetWavePtr)
             {
-              write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
+              write_register(2, thumbCallback(2, read_register(2), 0));
               handled = true;
             }
             else if (pc == CDF_SetWaveSize)
             {
-              myCartridge->thumbCallback(3, read_register(2), read_register(3));
+              thumbCallback(3, read_register(2), read_register(3));
               handled = true;
             }
             else if (pc == 0x0000083a)
@@ -1736,7 +2540,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
               uInt32 r3 = read_register(3);
               uInt32 r4 = read_register(4);
             #endif
-              myCartridge->thumbCallback(255, 0, 0);
+              thumbCallback(255, 0, 0);
             }
 
             break;
@@ -1769,7 +2573,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
 
             if      (pc == CDF1_SetNote)
             {
-              myCartridge->thumbCallback(0, read_register(2), read_register(3));
+              thumbCallback(0, read_register(2), read_register(3));
               // approximated cycles
               INC_ARM_CYCLES(_flashCycles + 1);     // this instruction
               INC_ARM_CYCLES(6);                    // ARM code NoteStore
@@ -1778,7 +2582,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
             }
             else if (pc == CDF1_ResetWave)
             {
-              myCartridge->thumbCallback(1, read_register(2), 0);
+              thumbCallback(1, read_register(2), 0);
               // approximated cycles
               INC_ARM_CYCLES(_flashCycles + 1);     // this instruction
               INC_ARM_CYCLES(6 + _flashCycles + 2); // ARM code ResetWaveStore
@@ -1787,7 +2591,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
             }
             else if (pc == CDF1_GetWavePtr)
             {
-              write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
+              write_register(2, thumbCallback(2, read_register(2), 0));
               // approximated cycles
               INC_ARM_CYCLES(_flashCycles + 1);     // this instruction
               INC_ARM_CYCLES(6 + _flashCycles + 2); // ARM code WavePtrFetch
@@ -1796,7 +2600,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
             }
             else if (pc == CDF1_SetWaveSize)
             {
-              myCartridge->thumbCallback(3, read_register(2), read_register(3));
+              thumbCallback(3, read_register(2), read_register(3));
               // approximated cycles
               INC_ARM_CYCLES(_flashCycles + 1);           // this instruction
               INC_ARM_CYCLES(18 + _flashCycles * 3 + 2);  // ARM code WaveSizeStore
@@ -1816,7 +2620,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
               uInt32 r3 = read_register(3);
               uInt32 r4 = read_register(4);
   #endif
-              myCartridge->thumbCallback(255, 0, 0);
+              thumbCallback(255, 0, 0);
             }
 
             break;
@@ -1834,14 +2638,14 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
           //rc &= ~1;
           write_register(15, rc);
           //_totalCycles += 100; // just a wild guess
-          return 0;
+          NEXT_INSTRUCTION;
         }
-        return 1;
+        EXIT_EXECUTION;
       }
     }
 
     //CMN
-    case Op::cmn: {
+    OP_CASE(cmn): {
       rn = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "cmns r" << dec << rn << ",r" << dec << rm << '\n');
@@ -1850,11 +2654,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = ra + rb;
       do_znflags(rc);
       do_cvflag(ra, rb, 0);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //CMP(1) compare immediate
-    case Op::cmp1: {
+    OP_CASE(cmp1): {
       rb = (inst >> 0) & 0xFF;
       rn = (inst >> 8) & 0x07;
       DO_DISS(statusMsg << "cmp r" << dec << rn << ",#0x" << Base::HEX2 << rb << '\n');
@@ -1863,11 +2667,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
       do_znflags(rc);
       do_cvflag(ra, ~rb, 1);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //CMP(2) compare register
-    case Op::cmp2: {
+    OP_CASE(cmp2): {
       rn = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << '\n');
@@ -1877,11 +2681,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
       do_znflags(rc);
       do_cvflag(ra, ~rb, 1);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //CMP(3) compare high register
-    case Op::cmp3: {
+    OP_CASE(cmp3): {
       if(((inst >> 6) & 3) == 0x0)
       {
         //UNPREDICTABLE
@@ -1899,19 +2703,19 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = ra - rb;
       do_znflags(rc);
       do_cvflag(ra, ~rb, 1);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
 #ifndef UNSAFE_OPTIMIZATIONS
     //CPS
-    case Op::cps: {
+    OP_CASE(cps): {
       DO_DISS(statusMsg << "cps TODO\n");
-      return 1;
+      EXIT_EXECUTION;
     }
 #endif
 
     //CPY copy high register
-    case Op::cpy: {
+    OP_CASE(cpy): {
       //same as mov except you can use both low registers
       //going to let mov handle high registers
       rd = (inst >> 0) & 0x7;
@@ -1919,11 +2723,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       DO_DISS(statusMsg << "cpy r" << dec << rd << ",r" << dec << rm << '\n');
       rc = read_register(rm);
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //EOR
-    case Op::eor: {
+    OP_CASE(eor): {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "eors r" << dec << rd << ",r" << dec << rm << '\n');
@@ -1932,11 +2736,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = ra ^ rb;
       write_register(rd, rc);
       do_znflags(rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDMIA
-    case Op::ldmia: {
+    OP_CASE(ldmia): {
       rn = (inst >> 8) & 0x7;
     #if defined(THUMB_DISS)
       statusMsg << "ldmia r" << dec << rn << "!,{";
@@ -1975,11 +2779,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       //there is a write back exception.
       if((inst & (1 << rn)) == 0)
         write_register(rn, sp);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDR(1) two register immediate
-    case Op::ldr1: {
+    OP_CASE(ldr1): {
       rd = (inst >> 0) & 0x07;
       rn = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -1989,11 +2793,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read32(rb);
       write_register(rd, rc);
       INC_LDR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDR(2) three register
-    case Op::ldr2: {
+    OP_CASE(ldr2): {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2002,11 +2806,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read32(rb);
       write_register(rd, rc);
       INC_LDR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDR(3)
-    case Op::ldr3: {
+    OP_CASE(ldr3): {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x07;
       rb <<= 2;
@@ -2018,11 +2822,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read32(rb);
       write_register(rd, rc);
       INC_LDR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDR(4)
-    case Op::ldr4: {
+    OP_CASE(ldr4): {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x07;
       rb <<= 2;
@@ -2033,11 +2837,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read32(rb);
       write_register(rd, rc);
       INC_LDR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDRB(1)
-    case Op::ldrb1: {
+    OP_CASE(ldrb1): {
       rd = (inst >> 0) & 0x07;
       rn = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -2057,11 +2861,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       }
       write_register(rd, rc & 0xFF);
       INC_LDRB_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDRB(2)
-    case Op::ldrb2: {
+    OP_CASE(ldrb2): {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2078,11 +2882,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       }
       write_register(rd, rc & 0xFF);
       INC_LDRB_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDRH(1)
-    case Op::ldrh1: {
+    OP_CASE(ldrh1): {
       rd = (inst >> 0) & 0x07;
       rn = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -2092,11 +2896,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read16(rb);
       write_register(rd, rc & 0xFFFF);
       INC_LDR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDRH(2)
-    case Op::ldrh2: {
+    OP_CASE(ldrh2): {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2105,11 +2909,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read16(rb);
       write_register(rd, rc & 0xFFFF);
       INC_LDR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDRSB
-    case Op::ldrsb: {
+    OP_CASE(ldrsb): {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2129,11 +2933,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
         rc |= ((~0U) << 8);
       write_register(rd, rc);
       INC_LDRB_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDRSH
-    case Op::ldrsh: {
+    OP_CASE(ldrsh): {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2145,11 +2949,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
         rc |= ((~0U) << 16);
       write_register(rd, rc);
       INC_LDR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LSL(1)
-    case Op::lsl1: {
+    OP_CASE(lsl1): {
       rd = (inst >> 0) & 0x07;
       rm = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -2170,11 +2974,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       INC_SHIFT_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LSL(2) two register
-    case Op::lsl2: {
+    OP_CASE(lsl2): {
       rd = (inst >> 0) & 0x07;
       rs = (inst >> 3) & 0x07;
       DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rs << '\n');
@@ -2202,11 +3006,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       INC_SHIFT_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LSR(1) two register immediate
-    case Op::lsr1: {
+    OP_CASE(lsr1): {
       rd = (inst >> 0) & 0x07;
       rm = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -2225,11 +3029,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       INC_SHIFT_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LSR(2) two register
-    case Op::lsr2: {
+    OP_CASE(lsr2): {
       rd = (inst >> 0) & 0x07;
       rs = (inst >> 3) & 0x07;
       DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rs << '\n');
@@ -2257,21 +3061,21 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       INC_SHIFT_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //MOV(1) immediate
-    case Op::mov1: {
+    OP_CASE(mov1): {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x07;
       DO_DISS(statusMsg << "movs r" << dec << rd << ",#0x" << Base::HEX2 << rb << '\n');
       write_register(rd, rb);
       do_znflags(rb);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //MOV(2) two low registers
-    case Op::mov2: {
+    OP_CASE(mov2): {
       rd = (inst >> 0) & 7;
       rn = (inst >> 3) & 7;
       DO_DISS(statusMsg << "movs r" << dec << rd << ",r" << dec << rn << '\n');
@@ -2281,11 +3085,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       do_znflags(rc);
       do_cflag_bit(0);
       do_vflag_bit(0);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //MOV(3)
-    case Op::mov3: {
+    OP_CASE(mov3): {
       rd  = (inst >> 0) & 0x7;
       rd |= (inst >> 4) & 0x8;
       rm  = (inst >> 3) & 0xF;
@@ -2302,11 +3106,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
         rc += 2;  //The program counter is special
       }
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //MUL
-    case Op::mul: {
+    OP_CASE(mul): {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "muls r" << dec << rd << ",r" << dec << rm << '\n');
@@ -2333,11 +3137,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = ra * rb;
       write_register(rd, rc);
       do_znflags(rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //MVN
-    case Op::mvn: {
+    OP_CASE(mvn): {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "mvns r" << dec << rd << ",r" << dec << rm << '\n');
@@ -2345,11 +3149,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = (~ra);
       write_register(rd, rc);
       do_znflags(rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //NEG
-    case Op::neg: {
+    OP_CASE(neg): {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "negs r" << dec << rd << ",r" << dec << rm << '\n');
@@ -2358,11 +3162,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       do_cvflag(0, ~ra, 1);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ORR
-    case Op::orr: {
+    OP_CASE(orr): {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "orrs r" << dec << rd << ",r" << dec << rm << '\n');
@@ -2371,11 +3175,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = ra | rb;
       write_register(rd, rc);
       do_znflags(rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //POP
-    case Op::pop: {
+    OP_CASE(pop): {
     #if defined(THUMB_DISS)
       statusMsg << "pop {";
       for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,++ra)
@@ -2431,11 +3235,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
         sp += 4;
       }
       write_register(13, sp);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //PUSH
-    case Op::push: {
+    OP_CASE(push): {
     #if defined(THUMB_DISS)
       statusMsg << "push {";
       for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,++ra)
@@ -2506,11 +3310,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       }
       write_register(13, sp);
       FETCH_TYPE_N; // ??? (copied from stmia)
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //REV
-    case Op::rev: {
+    OP_CASE(rev): {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "rev r" << dec << rd << ",r" << dec << rn << '\n');
@@ -2520,11 +3324,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc |= ((ra >> 16) & 0xFF) <<  8;
       rc |= ((ra >> 24) & 0xFF) <<  0;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //REV16
-    case Op::rev16: {
+    OP_CASE(rev16): {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "rev16 r" << dec << rd << ",r" << dec << rn << '\n');
@@ -2534,11 +3338,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc |= ((ra >> 16) & 0xFF) << 24;
       rc |= ((ra >> 24) & 0xFF) << 16;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //REVSH
-    case Op::revsh: {
+    OP_CASE(revsh): {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "revsh r" << dec << rd << ",r" << dec << rn << '\n');
@@ -2548,11 +3352,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       if(rc & 0x8000) rc |= 0xFFFF0000;
       else            rc &= 0x0000FFFF;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ROR
-    case Op::ror: {
+    OP_CASE(ror): {
       rd = (inst >> 0) & 0x7;
       rs = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "rors r" << dec << rd << ",r" << dec << rs << '\n');
@@ -2580,11 +3384,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       INC_SHIFT_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //SBC
-    case Op::sbc: {
+    OP_CASE(sbc): {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "sbc r" << dec << rd << ",r" << dec << rm << '\n');
@@ -2596,19 +3400,19 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       do_znflags(rc);
       if(cFlag) do_cvflag(ra, ~rb, 1);
       else      do_cvflag(ra, ~rb, 0);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
 #ifndef UNSAFE_OPTIMIZATIONS
     //SETEND
-    case Op::setend: {
+    OP_CASE(setend): {
       statusMsg << "setend not implemented\n";
-      return 1;
+      EXIT_EXECUTION;
     }
 #endif
 
     //STMIA
-    case Op::stmia: {
+    OP_CASE(stmia): {
       rn = (inst >> 8) & 0x7;
     #if defined(THUMB_DISS)
       statusMsg << "stmia r" << dec << rn << "!,{";
@@ -2645,11 +3449,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       }
       write_register(rn, sp);
       FETCH_TYPE_N;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //STR(1)
-    case Op::str1: {
+    OP_CASE(str1): {
       rd = (inst >> 0) & 0x07;
       rn = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -2659,11 +3463,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read_register(rd);
       write32(rb, rc);
       INC_STR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //STR(2)
-    case Op::str2: {
+    OP_CASE(str2): {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2672,11 +3476,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read_register(rd);
       write32(rb, rc);
       INC_STR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //STR(3)
-    case Op::str3: {
+    OP_CASE(str3): {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x07;
       rb <<= 2;
@@ -2686,11 +3490,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read_register(rd);
       write32(rb, rc);
       INC_STR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //STRB(1)
-    case Op::strb1: {
+    OP_CASE(strb1): {
       rd = (inst >> 0) & 0x07;
       rn = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -2714,11 +3518,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       }
       write16(rb & (~1U), ra & 0xFFFF);
       INC_STRB_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //STRB(2)
-    case Op::strb2: {
+    OP_CASE(strb2): {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2742,11 +3546,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       }
       write16(rb & (~1U), ra & 0xFFFF);
       INC_STRB_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //STRH(1)
-    case Op::strh1: {
+    OP_CASE(strh1): {
       rd = (inst >> 0) & 0x07;
       rn = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -2756,11 +3560,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc=  read_register(rd);
       write16(rb, rc & 0xFFFF);
       INC_STR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //STRH(2)
-    case Op::strh2: {
+    OP_CASE(strh2): {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2769,11 +3573,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read_register(rd);
       write16(rb, rc & 0xFFFF);
       INC_STR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //SUB(1)
-    case Op::sub1: {
+    OP_CASE(sub1): {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rb = (inst >> 6) & 0x7;
@@ -2783,11 +3587,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       do_cvflag(ra, ~rb, 1);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //SUB(2)
-    case Op::sub2: {
+    OP_CASE(sub2): {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x07;
       DO_DISS(statusMsg << "subs r" << dec << rd << ",#0x" << Base::HEX2 << rb << '\n');
@@ -2796,11 +3600,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       do_cvflag(ra, ~rb, 1);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //SUB(3)
-    case Op::sub3: {
+    OP_CASE(sub3): {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2811,41 +3615,41 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       do_cvflag(ra, ~rb, 1);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //SUB(4)
-    case Op::sub4: {
+    OP_CASE(sub4): {
       rb = inst & 0x7F;
       rb <<= 2;
       DO_DISS(statusMsg << "sub SP,#0x" << Base::HEX2 << rb << '\n');
       ra = read_register(13);
       ra -= rb;
       write_register(13, ra);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //SWI
-    case Op::swi: { // never used
+    OP_CASE(swi): { // never used
 //      rb = inst & 0xFF;  // NOLINT: clang-analyzer-deadcode.DeadStores
 //      DO_DISS(statusMsg << "swi 0x" << Base::HEX2 << rb << '\n');
 //
 //      if(rb == 0xCC)
 //      {
 //        write_register(0, cpsr);
-//        return 0;
+//        NEXT_INSTRUCTION;
 //      }
 //      else
 //      {
 //#if defined(THUMB_DISS)
 //        statusMsg << "\n\nswi 0x" << Base::HEX2 << rb << '\n';
 //#endif
-          return 1;
+          EXIT_EXECUTION;
 //      }
     }
 
     //SXTB
-    case Op::sxtb: {
+    OP_CASE(sxtb): {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "sxtb r" << dec << rd << ",r" << dec << rm << '\n');
@@ -2854,11 +3658,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       if(rc & 0x80)
         rc |= (~0U) << 8;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //SXTH
-    case Op::sxth: {
+    OP_CASE(sxth): {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "sxth r" << dec << rd << ",r" << dec << rm << '\n');
@@ -2867,11 +3671,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       if(rc & 0x8000)
         rc |= (~0U) << 16;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //TST
-    case Op::tst: {
+    OP_CASE(tst): {
       rn = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "tst r" << dec << rn << ",r" << dec << rm << '\n');
@@ -2879,29 +3683,49 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rb = read_register(rm);
       rc = ra & rb;
       do_znflags(rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //UXTB
-    case Op::uxtb: {
+    OP_CASE(uxtb): {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "uxtb r" << dec << rd << ",r" << dec << rm << '\n');
       ra = read_register(rm);
       rc = ra & 0xFF;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //UXTH
-    case Op::uxth: {
+    OP_CASE(uxth): {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "uxth r" << dec << rd << ",r" << dec << rm << '\n');
       ra = read_register(rm);
       rc = ra & 0xFFFF;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
+    }
+
+    //HLE, native execution of a recognized routine
+    OP_CASE(hle): {
+      const HleRoutine& routine = _hleRoutines[decoded->param];
+      const uInt32 emulated = runHLE(routine);
+      if(emulated)
+      {
+      #ifndef UNSAFE_OPTIMIZATIONS
+        instructions += emulated - 1;
+      #endif
+        goto newBlock;
+      }
+      // Not applicable, execute the replaced instruction instead
+    #ifdef THUMB_THREADED_DISPATCH
+      goto *dispatchTable[static_cast<uInt32>(routine.op)];
+    #else
+      op = routine.op;
+      goto dispatchOp;
+    #endif
     }
 
     // Silence compiler
@@ -2917,12 +3741,23 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
 #endif
   }
 
+#ifdef THUMB_THREADED_DISPATCH
+invalidInstruction:
+#endif
 #ifndef UNSAFE_OPTIMIZATIONS
   statusMsg << "invalid instruction " << Base::HEX8 << pc << " "
             << Base::HEX4 << inst << '\n';
 #endif
+
+exitExecution:
+#ifndef UNSAFE_OPTIMIZATIONS
+  _stats.instructions = instructions;
+#endif
   return 1;
 }
+#ifdef THUMB_THREADED_DISPATCH
+  #pragma GCC diagnostic pop
+#endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 int Thumbulator::reset()
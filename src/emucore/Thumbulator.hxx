@@ -26,6 +26,7 @@
 #define THUMBULATOR_HXX
 
 class Cartridge;
+class ThumbRecorder;
 
 #include "bspf.hxx"
 #include "Console.hxx"
@@ -36,6 +37,7 @@ class Cartridge;
 
 #ifdef DEBUGGER_SUPPORT
   #define THUMB_CYCLE_COUNT
+  #define THUMB_PROFILE
   //#define COUNT_OPS
   //#define THUMB_STATS
 #endif
@@ -141,6 +143,60 @@ class Thumbulator
     */
     void setConsoleTiming(ConsoleTiming timing);
 
+    /**
+      Enable or disable the native execution of recognized routines (high
+      level emulation).  Since these are executed without accounting for
+      the cycles they take, this only takes effect while cycle counting is
+      disabled.
+
+      @param enable  Enable or disable high level emulation
+    */
+    void enableHLE(bool enable);
+
+    /**
+      Set the recorder which records all runs and cart callbacks, see
+      ThumbRecorder.
+
+      @param recorder  The recorder, or nullptr to stop recording
+    */
+    void setRecorder(ThumbRecorder* recorder) { myRecorder = recorder; }
+
+  #ifdef THUMB_PROFILE
+    /**
+      Enable or disable the ARM code profiler.  While enabled, the executed
+      instructions and ARM cycles (if cycle counting is enabled) are counted
+      per instruction address and per call stack.  Call stacks are tracked
+      by following the BL/BLX calls and the returns to their return addresses.
+
+      @param enable  Enable or disable profiling
+    */
+    void enableProfiling(bool enable);
+    bool profiling() const { return _profiling; }
+    void resetProfile();
+
+    /**
+      Write the profile in the collapsed stack format ('caller;callee count'
+      per line), as used by flame graph tools.  Functions are named by
+      their entry address; counts are ARM cycles, or instructions if no
+      cycles have been counted.
+    */
+    void writeCollapsedProfile(ostream& out) const;
+
+    /**
+      Write a summary of the profile, listing the most expensive functions
+      and instruction addresses.
+
+      @param maxLines  Maximum number of functions and addresses listed
+    */
+    void writeProfileSummary(ostream& out, uInt32 maxLines = 10) const;
+  #else
+    void enableProfiling(bool) { }
+    bool profiling() const { return false; }
+    void resetProfile() { }
+    void writeCollapsedProfile(ostream&) const { }
+    void writeProfileSummary(ostream&, uInt32 = 10) const { }
+  #endif
+
   private:
 
     enum class Op : uInt8 {
@@ -195,8 +251,30 @@ class Thumbulator
       tst,
       uxtb,
       uxth,
+      hle,  // native implementation of a recognized routine
       numOps
     };
+    // A pre-decoded instruction, including its pre-calculated parameter
+    // (e.g. the branch target)
+    struct DecodedOp {
+      Op op{Op::invalid};
+      uInt16 inst{0};
+      uInt32 param{0};
+    };
+    // Routines commonly found in ARM drivers and games (e.g. the stock
+    // memcpy/memset of the CDF/CDFJ/BUS/DPC+ toolchains), which can be
+    // executed natively instead of being interpreted
+    enum class HleType : uInt8 {
+      memcpy_bx, memcpy_pc,  // return via 'pop {r0}; bx r0' or 'pop {pc}'
+      memset_bx, memset_pc,
+      copyWords,             // word copy loop of the C runtime startup
+      fillWords              // word fill loop of the C runtime startup
+    };
+    struct HleRoutine {
+      HleType type{HleType::memcpy_bx};
+      uInt32 addr{0};        // ARM address of the routine's entry
+      Op op{Op::invalid};    // the replaced op at the entry
+    };
   #ifdef THUMB_CYCLE_COUNT
     enum class CycleType {
       S, N, I // Sequential, Non-sequential, Internal
@@ -219,9 +297,16 @@ class Thumbulator
     uInt32 read_register(uInt32 reg);
     void write_register(uInt32 reg, uInt32 data, bool isFlowBreak = true);
 #endif
-    uInt32 fetch16(uInt32 addr);
+    const DecodedOp* lookupBlock(uInt32 addr, const DecodedOp*& blockEnd);
+#ifndef UNSAFE_OPTIMIZATIONS
+    const DecodedOp* fatalFetch(const DecodedOp*& blockEnd);
+#endif
+    void setupMemoryMap();
+    static uInt32 pageIndex(uInt32 addr);
     uInt32 read16(uInt32 addr);
     uInt32 read32(uInt32 addr);
+    uInt32 read16Slow(uInt32 addr);
+    uInt32 read32Slow(uInt32 addr);
   #ifndef UNSAFE_OPTIMIZATIONS
     bool isInvalidROM(uInt32 addr) const;
     bool isInvalidRAM(uInt32 addr) const;
@@ -229,9 +314,23 @@ class Thumbulator
   #endif
     void write16(uInt32 addr, uInt32 data);
     void write32(uInt32 addr, uInt32 data);
+    void write16Slow(uInt32 addr, uInt32 data);
+    void write32Slow(uInt32 addr, uInt32 data);
     void updateTimer(uInt32 cycles);
 
-    Op decodeInstructionWord(uint16_t inst, uInt32 pc);
+    void decodeInstruction(DecodedOp& decoded, uInt16 inst, uInt32 pc);
+  #ifdef THUMB_PROFILE
+    uInt32 profileIndex(uInt32 addr) const;
+    void profileRunStart();
+    void profileInstruction(uInt32 addr, Op op);
+    void profileRunEnd();
+  #endif
+    void setupHLE();
+    uInt32 runHLE(const HleRoutine& routine);
+    uInt32 thumbCallback(uInt8 function, uInt32 value1, uInt32 value2);
+    const uInt8* hostReadRange(uInt32 addr, uInt32 size) const;
+    uInt8* hostWriteRange(uInt32 addr, uInt32 size) const;
+    Op decodeInstructionWord(uint16_t inst, uInt32 pc, uInt32& param);
 
     void do_cvflag(uInt32 a, uInt32 b, uInt32 c);
 
@@ -245,12 +344,15 @@ class Thumbulator
     void dump_counters() const;
     void dump_regs();
   #endif
+    // Profiling is selected once per run, not checked for each instruction
+    template<bool Profiling>
     int execute();
     int reset();
 
   #ifdef THUMB_CYCLE_COUNT
     bool isMamBuffered(uInt32 addr, AccessType = AccessType::data);
     void incCycles(AccessType accessType, uInt32 cycles);
+    void incFetchCycles(uInt32 addr);
     void incSCycles(uInt32 addr, AccessType = AccessType::data);
     void incNCycles(uInt32 addr, AccessType = AccessType::data);
     void incICycles(uInt32 m = 1);
@@ -263,9 +365,13 @@ class Thumbulator
     uInt32 cBase{0};
     uInt32 cStart{0};
     uInt32 cStack{0};
-    const unique_ptr<Op[]> decodedRom;  // NOLINT
-    const unique_ptr<uInt32[]> decodedParam;  // NOLINT
+    const unique_ptr<DecodedOp[]> decodedRom;  // NOLINT
     uInt16* ram{nullptr};
+    uInt32 ramSize{0};
+    unique_ptr<DecodedOp[]> decodedRam;  // NOLINT
+#ifndef UNSAFE_OPTIMIZATIONS
+    DecodedOp fatalFetchOp;  // executed for invalid fetches, if not trapped
+#endif
     std::array<uInt32, 16> reg_norm; // normal execution mode, do not have a thread mode
     uInt32 znFlags{0};
     uInt32 cFlag{0};
@@ -303,6 +409,35 @@ class Thumbulator
   #endif
     bool _countCycles{false};
     bool _lockMamcr{false};
+    bool _hleEnabled{false};
+    std::vector<HleRoutine> _hleRoutines;
+
+  #ifdef THUMB_PROFILE
+    struct ProfileCounter {
+      uInt64 instructions{0};
+      uInt64 cycles{0};
+    };
+    // A node of the call tree, i.e. a function called via a unique call stack
+    struct ProfileNode {
+      uInt32 function{0};    // entry address
+      uInt32 parent{0};      // index of the calling node (root: itself)
+      ProfileCounter counter;
+      std::vector<uInt32> children;
+    };
+    struct ProfileFrame {
+      uInt32 returnAddr{0};
+      uInt32 node{0};        // node of the caller
+    };
+    bool _profiling{false};
+    uInt32 _profileRuns{0};
+    std::vector<ProfileCounter> _profileAddrs;  // ROM halfwords, then RAM ones
+    std::vector<ProfileNode> _profileNodes;     // the root is the first node
+    std::vector<ProfileFrame> _profileStack;
+    uInt32 _profileNode{0};          // node currently executing
+    uInt32 _profileAddr{0};          // last instruction profiled
+    Op _profileOp{Op::invalid};      // its op
+    uInt32 _profileCycles{0};        // _totalCycles when it was fetched
+  #endif
 
   #ifdef THUMB_CYCLE_COUNT
     double _armCyclesFactor{1.05};
@@ -327,6 +462,7 @@ class Thumbulator
     ConfigureFor configuration;
 
     Cartridge* myCartridge{nullptr};
+    ThumbRecorder* myRecorder{nullptr};
 
     static constexpr uInt32
       ROMADDMASK = 0x7FFFF,
@@ -335,11 +471,24 @@ class Thumbulator
       ROMSIZE = ROMADDMASK + 1,  // 512KB
       RAMSIZE = RAMADDMASK + 1,  // 32KB
 
+      // Memory map, which maps the lower part of each 256 MB region in
+      // pages; accesses to unmapped pages use the slow path
+      PAGE_SIZE = 4_KB,
+      REGION_SIZE = ROMSIZE,
+      REGION_PAGES = REGION_SIZE / PAGE_SIZE,
+      UNMAPPED_PAGE = 16 * REGION_PAGES,  // sentinel, never mapped
+
       CPSR_N = 1u << 31,
       CPSR_Z = 1u << 30,
       CPSR_C = 1u << 29,
       CPSR_V = 1u << 28;
 
+    // Host pointers for each mapped page, nullptr for unmapped pages
+    std::array<const uInt8*, UNMAPPED_PAGE + 1> myReadPages;
+    std::array<uInt8*, UNMAPPED_PAGE + 1> myWritePages;
+
+    friend class ThumbRecorder;
+
   private:
     // Following constructors and assignment operators not supported
     Thumbulator() = delete;
@@ -87,6 +87,7 @@ MODULE_OBJS := \
 	src/emucore/ProfilingRunner.o \
 	src/emucore/Props.o \
 	src/emucore/PropsSet.o \
+	src/emucore/AutodetectCache.o \
 	src/emucore/QuadTari.o \
 	src/emucore/SaveKey.o \
 	src/emucore/Serializer.o \
@@ -94,7 +95,8 @@ MODULE_OBJS := \
 	src/emucore/Switches.o \
 	src/emucore/System.o \
 	src/emucore/TIASurface.o \
-	src/emucore/Thumbulator.o
+	src/emucore/Thumbulator.o \
+	src/emucore/ThumbRecorder.o
 
 MODULE_DIRS += \
 	src/emucore
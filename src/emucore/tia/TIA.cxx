@@ -200,12 +200,11 @@ void TIA::initialize()
   applyDeveloperSettings();
 
   // Must be done last, after all other items have reset
-  const bool devSettings = mySettings.getBool("dev.settings");
-  setFixedColorPalette(mySettings.getString("tia.dbgcolors"));
-  enableFixedColors(
-    mySettings.getBool(devSettings ? "dev.debugcolors" : "plr.debugcolors"));
+  const auto settings = mySettings.emulation();
+  setFixedColorPalette(settings->tiaDbgColors);
+  enableFixedColors(settings->debugColors);
   // Auto-phosphor settings:
-  const string mode = mySettings.getString(PhosphorHandler::SETTING_MODE);
+  const string& mode = settings->phosphorMode;
   myAutoPhosphorAutoOn = mode == PhosphorHandler::VALUE_AUTO_ON;
   myAutoPhosphorEnabled = myAutoPhosphorAutoOn || mode == PhosphorHandler::VALUE_AUTO;
   myAutoPhosphorActive = false;
@@ -957,35 +956,18 @@ bool TIA::loadDisplay(const Serializer& in)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::applyDeveloperSettings()
 {
-  const bool devSettings = mySettings.getBool("dev.settings");
-  if(devSettings)
+  const auto settings = mySettings.emulation();
+  if(settings->devSettings)
   {
-    const bool custom =
-      BSPF::equalsIgnoreCase("custom", mySettings.getString("dev.tia.type"));
-
-    setPlInvertedPhaseClock(custom
-                            ? mySettings.getBool("dev.tia.plinvphase")
-                            : BSPF::equalsIgnoreCase("koolaidman", mySettings.getString("dev.tia.type")));
-    setMsInvertedPhaseClock(custom
-                            ? mySettings.getBool("dev.tia.msinvphase")
-                            : BSPF::equalsIgnoreCase("cosmicark", mySettings.getString("dev.tia.type")));
-    setBlInvertedPhaseClock(custom ? mySettings.getBool("dev.tia.blinvphase") : false);
-    setPFBitsDelay(custom
-                   ? mySettings.getBool("dev.tia.delaypfbits")
-                   : BSPF::equalsIgnoreCase("pesco", mySettings.getString("dev.tia.type")));
-    setPFColorDelay(custom
-                    ? mySettings.getBool("dev.tia.delaypfcolor")
-                    : BSPF::equalsIgnoreCase("quickstep", mySettings.getString("dev.tia.type")));
-    setPFScoreGlitch(custom
-                     ? mySettings.getBool("dev.tia.pfscoreglitch")
-                     : BSPF::equalsIgnoreCase("matchie", mySettings.getString("dev.tia.type")));
-    setBKColorDelay(custom
-                    ? mySettings.getBool("dev.tia.delaybkcolor")
-                    : BSPF::equalsIgnoreCase("indy500", mySettings.getString("dev.tia.type")));
-    setPlSwapDelay(custom
-                   ? mySettings.getBool("dev.tia.delayplswap")
-                   : BSPF::equalsIgnoreCase("heman", mySettings.getString("dev.tia.type")));
-    setBlSwapDelay(custom ? mySettings.getBool("dev.tia.delayblswap") : false);
+    setPlInvertedPhaseClock(settings->plInvPhase);
+    setMsInvertedPhaseClock(settings->msInvPhase);
+    setBlInvertedPhaseClock(settings->blInvPhase);
+    setPFBitsDelay(settings->delayPFBits);
+    setPFColorDelay(settings->delayPFColor);
+    setPFScoreGlitch(settings->pfScoreGlitch);
+    setBKColorDelay(settings->delayBKColor);
+    setPlSwapDelay(settings->delayPlSwap);
+    setBlSwapDelay(settings->delayBlSwap);
   }
   else
   {
@@ -1000,15 +982,15 @@ void TIA::applyDeveloperSettings()
     setBlSwapDelay(false);
   }
 
-  myRandomize = mySettings.getBool(devSettings ? "dev.tiarandom" : "plr.tiarandom");
-  myTIAPinsDriven = devSettings ? mySettings.getBool("dev.tiadriven") : false;
+  myRandomize = settings->tiaRandom;
+  myTIAPinsDriven = settings->tiaDriven;
 
-  myEnableJitter = mySettings.getBool(devSettings ? "dev.tv.jitter" : "plr.tv.jitter");
-  myJitterSensitivity = mySettings.getInt(devSettings ? "dev.tv.jitter_sense" : "plr.tv.jitter_sense");
-  myJitterRecovery = mySettings.getInt(devSettings ? "dev.tv.jitter_recovery" : "plr.tv.jitter_recovery");
+  myEnableJitter = settings->tvJitter;
+  myJitterSensitivity = settings->jitterSense;
+  myJitterRecovery = settings->jitterRecovery;
 
   if(myFrameManager)
-    enableColorLoss(mySettings.getBool(devSettings ? "dev.colorloss" : "plr.colorloss"));
+    enableColorLoss(settings->colorLoss);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1413,6 +1395,9 @@ void TIA::onFrameComplete()
 
   myFrontBufferScanlines = scanlinesLastFrame();
 
+  if(myFrameCallback)
+    myFrameCallback(myFrontBuffer.data(), height());
+
   if(myAutoPhosphorEnabled)
   {
     // Calculate difference to previous frames (with some margin).
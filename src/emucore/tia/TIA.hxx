@@ -110,6 +110,7 @@ class TIA : public Device
     friend class RiotDebug;
 
     using onPhosphorCallback = std::function<void(bool)>;
+    using onFrameCallback = std::function<void(const uInt8*, uInt32)>;
 
     /**
       Create a new TIA for the specified console
@@ -139,6 +140,13 @@ class TIA : public Device
     */
     void setAudioRewindMode(bool enable);
 
+    /**
+      Set a callback which receives each completed frame, as the palette
+      indices of 'height()' scanlines.  Note that the callback is called
+      from the emulation thread.
+    */
+    void setFrameCallback(const onFrameCallback& cb) { myFrameCallback = cb; }
+
     /**
       Clear the configured frame manager and deteach the lifecycle callbacks.
      */
@@ -998,6 +1006,9 @@ class TIA : public Device
     uInt32 myFrameEnd{0};
     onPhosphorCallback myPhosphorCallback;
 
+    // Receives the completed frames, if set
+    onFrameCallback myFrameCallback;
+
   #ifdef DEBUGGER_SUPPORT
     /**
      * System cycles at the end of the previous frame / beginning of next frame.
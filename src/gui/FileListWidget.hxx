@@ -100,6 +100,7 @@ class FileListWidget : public StringListWidget
     /** Gets current node(s) */
     const FSNode& selected();
     const FSNode& currentDir() const { return _node; }
+    const FSList& fileList() const { return _fileList; }
 
     static void setQuickSelectDelay(uInt64 time) { _QUICK_SELECT_DELAY = time; }
     uInt64 getQuickSelectDelay() const { return _QUICK_SELECT_DELAY; }
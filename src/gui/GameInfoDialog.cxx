@@ -29,6 +29,7 @@
 #include "Paddles.hxx"
 #include "PopUpWidget.hxx"
 #include "PropsSet.hxx"
+#include "AutodetectCache.hxx"
 #include "BrowserDialog.hxx"
 #include "QuadTariDialog.hxx"
 #include "TabWidget.hxx"
@@ -1051,6 +1052,9 @@ void GameInfoDialog::saveConfig()
   instance().propSet().insert(myGameProperties);
   instance().saveConfig();
 
+  // Changed properties may change the autodetection results too
+  instance().autodetectCache().remove(myGameProperties.get(PropType::Cart_MD5));
+
   // In any event, inform the Console
   if(instance().hasConsole())
   {
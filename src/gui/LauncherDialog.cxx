@@ -46,6 +46,7 @@
 #include "PropsSet.hxx"
 #include "RomImageWidget.hxx"
 #include "RomInfoWidget.hxx"
+#include "RomIndex.hxx"
 #include "TIAConstants.hxx"
 #include "Settings.hxx"
 #include "Font.hxx"
@@ -422,16 +423,10 @@ const string& LauncherDialog::selectedRomMD5()
   if(currentNode().isDirectory() || !Bankswitch::isValidRomName(currentNode()))
     return EmptyString;
 
-  // Attempt to conserve memory
-  if(myMD5List.size() > 500)
-    myMD5List.clear();
+  // Lookup MD5 in the index, which calculates it if it is not present
+  mySelectedMD5 = instance().romIndex().entry(currentNode()).md5;
 
-  // Lookup MD5, and if not present, cache it
-  const auto iter = myMD5List.find(currentNode().getPath());
-  if(iter == myMD5List.end())
-    myMD5List[currentNode().getPath()] = OSystem::getROMMD5(currentNode());
-
-  return myMD5List[currentNode().getPath()];
+  return mySelectedMD5;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -451,7 +446,7 @@ void LauncherDialog::reload()
 {
   const bool extensions = instance().settings().getBool("launcherextensions");
 
-  myMD5List.clear();
+  instance().romIndex().reset();
   myList->setShowFileExtensions(extensions);
   myList->reload();
   myPendingReload = false;
@@ -480,6 +475,9 @@ void LauncherDialog::tick()
   if(myPendingRomInfo && myRomInfoTime < TimerManager::getTicks() / 1000)
     loadPendingRomInfo();
 
+  // Save the ROMs indexed in the background
+  instance().romIndex().update();
+
   Dialog::tick();
 }
 
@@ -674,9 +672,18 @@ void LauncherDialog::setRomInfoFont(const Common::Size& area)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void LauncherDialog::loadRomInfo()
 {
+  // Index the ROMs around the cursor in the background, so that their MD5s
+  // are available when they get selected
+  const size_t selected = std::max(myList->getSelected(), 0);
+  const size_t first = selected - std::min(selected, ROM_INDEX_BEHIND);
+  instance().romIndex().prefetch(myList->fileList(), first,
+                                 selected - first + ROM_INDEX_AHEAD);
+
   if(!myRomImageWidget || !myRomInfoWidget)
     return;
 
+  prefetchSnapshots(selected);
+
   // Update ROM info UI item, delayed
   myRomInfoTime = TimerManager::getTicks() / 1000 + myRomImageWidget->pendingLoadTime();
   myPendingRomInfo = true;
@@ -692,6 +699,7 @@ void LauncherDialog::loadRomInfo()
 
     // And now get the properties for this ROM
     instance().propSet().getMD5(md5, properties);
+    instance().romIndex().setName(currentNode(), properties.get(PropType::Cart_Name));
 
     myRomImageWidget->setProperties(currentNode(), properties, false);
     myRomInfoWidget->setProperties(currentNode(), properties, false);
@@ -727,6 +735,35 @@ void LauncherDialog::loadPendingRomInfo()
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherDialog::prefetchSnapshots(size_t selected)
+{
+  // Decode the snapshots of the ROMs around the cursor in the background,
+  // nearest first, so that they can be shown without delay
+  const FSList& list = myList->fileList();
+  vector<std::pair<FSNode, string>> roms;
+
+  for(size_t dist = 1; dist <= SNAPSHOT_PREFETCH; ++dist)
+    for(const size_t idx: { selected + dist, selected - dist })
+    {
+      // Note: 'selected - dist' wraps around for the first ROMs
+      if(idx >= list.size() || list[idx].isDirectory())
+        continue;
+
+      // The cart name is only available if the ROM has been indexed already
+      string cartName;
+      const string md5 = instance().romIndex().knownMD5(list[idx]);
+      if(!md5.empty())
+      {
+        Properties properties;
+        instance().propSet().getMD5(md5, properties);
+        cartName = properties.get(PropType::Cart_Name);
+      }
+      roms.emplace_back(list[idx], cartName);
+    }
+  myRomImageWidget->prefetch(roms);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void LauncherDialog::handleFavoritesChanged()
 {
@@ -38,7 +38,6 @@ namespace GUI {
   class MessageBox;
 }
 
-#include <unordered_map>
 #include <unordered_set>
 
 #include "bspf.hxx"
@@ -111,6 +110,12 @@ class LauncherDialog : public Dialog, CommandSender
     static constexpr int MIN_ROMINFO_CHARS = 30;
     static constexpr int MIN_ROMINFO_ROWS = 7; // full lines
     static constexpr int MIN_ROMINFO_LINES = 4; // extra lines
+    // The number of ROMs indexed behind and ahead of the cursor
+    static constexpr size_t ROM_INDEX_BEHIND = 16;
+    static constexpr size_t ROM_INDEX_AHEAD = 64;
+    // The number of ROMs behind and ahead of the cursor whose snapshots
+    // are decoded in advance
+    static constexpr size_t SNAPSHOT_PREFETCH = 2;
 
     void setPosition() override { positionAt(0); }
     void handleKeyDown(StellaKey key, StellaMod mod, bool repeated) override;
@@ -149,6 +154,7 @@ class LauncherDialog : public Dialog, CommandSender
     void loadRom();
     void loadRomInfo();
     void loadPendingRomInfo();
+    void prefetchSnapshots(size_t selected);
     void loadRandomRom();
     void openSettings();
     void openGameProperties();
@@ -196,7 +202,8 @@ class LauncherDialog : public Dialog, CommandSender
     RomImageWidget*   myRomImageWidget{nullptr};
     RomInfoWidget*    myRomInfoWidget{nullptr};
 
-    std::unordered_map<string,string> myMD5List;
+    // The MD5 of the selected ROM
+    string mySelectedMD5;
 
     // Show a message about the dangers of using this function
     unique_ptr<GUI::MessageBox> myConfirmMsg;
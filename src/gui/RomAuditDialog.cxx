@@ -15,6 +15,10 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+
 #include "bspf.hxx"
 #include "Launcher.hxx"
 #include "Bankswitch.hxx"
@@ -27,11 +31,21 @@
 #include "MessageBox.hxx"
 #include "OSystem.hxx"
 #include "FrameBuffer.hxx"
+#include "MD5.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "RomIndex.hxx"
 #include "Settings.hxx"
 #include "RomAuditDialog.hxx"
 
+namespace {
+  // The maximum number of threads calculating MD5s
+  constexpr uInt32 MAX_THREADS = 8;
+
+  // The file the planned renames of a dry run are written to
+  constexpr string_view CSV_FILE = "romaudit.csv";
+} // namespace
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 RomAuditDialog::RomAuditDialog(OSystem& osystem, DialogContainer& parent,
                                const GUI::Font& font, int max_w, int max_h)
@@ -53,7 +67,7 @@ RomAuditDialog::RomAuditDialog(OSystem& osystem, DialogContainer& parent,
 
   // Set real dimensions
   _w = 64 * fontWidth + HBORDER * 2;
-  _h = _th + VBORDER * 2 + buttonHeight * 2 + lineHeight * 3 + VGAP * 10;
+  _h = _th + VBORDER * 2 + buttonHeight * 2 + lineHeight * 4 + VGAP * 12;
 
   // Audit path
   auto* romButton = new ButtonWidget(this, font, HBORDER, ypos,
@@ -76,6 +90,11 @@ RomAuditDialog::RomAuditDialog(OSystem& osystem, DialogContainer& parent,
   myResults2->setEditable(false, true);
 
   ypos += buttonHeight + VGAP * 2;
+  myDryRun = new CheckboxWidget(this, font, HBORDER, ypos + 1,
+      "Dry run (only write planned renames to '" + string{CSV_FILE} + "')");
+  wid.push_back(myDryRun);
+
+  ypos += lineHeight + VGAP * 2;
   new StaticTextWidget(this, font, HBORDER, ypos, "(*) WARNING: Operation cannot be undone!");
 
   // Add OK and Cancel buttons
@@ -101,12 +120,14 @@ void RomAuditDialog::loadConfig()
   myRomPath->setText(path);
   myResults1->setText("");
   myResults2->setText("");
+  myDryRun->setState(false);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void RomAuditDialog::auditRoms()
 {
   const string& auditPath = myRomPath->getText();
+  const bool dryRun = myDryRun->getState();
   myResults1->setText("");
   myResults2->setText("");
 
@@ -115,6 +136,22 @@ void RomAuditDialog::auditRoms()
   files.reserve(2048);
   node.getChildren(files, FSNode::ListMode::FilesOnly);
 
+  // Only ROM files are audited
+  struct Rom
+  {
+    const FSNode* file{nullptr};
+    string extension;
+    string md5;
+  };
+  vector<Rom> roms;
+  roms.reserve(files.size());
+  for(const auto& file: files)
+  {
+    string extension;
+    if(file.isFile() && Bankswitch::isValidRomName(file, extension))
+      roms.push_back({&file, extension, ""});
+  }
+
   // Create a progress dialog box to show the progress of processing
   // the ROMs, since this is usually a time-consuming operation
   ostringstream buf;
@@ -122,43 +159,118 @@ void RomAuditDialog::auditRoms()
 
   buf << "Auditing ROM files" << ELLIPSIS;
   progress.setMessage(buf.str());
-  progress.setRange(0, static_cast<int>(files.size()) - 1, 5);
+  progress.setRange(0, static_cast<int>(roms.size()) - 1, 5);
   progress.open();
 
+  // Use the MD5s of indexed ROMs
+  vector<Rom*> pending;
+  int processed = 0;
+  for(auto& rom: roms)
+  {
+    if(progress.isCancelled())
+      break;
+
+    rom.md5 = instance().romIndex().knownMD5(*rom.file);
+    if(rom.md5.empty())
+      pending.push_back(&rom);
+    else
+      progress.setProgress(++processed);
+  }
+
+  // Calculate the remaining MD5s in parallel
+  if(!pending.empty() && !progress.isCancelled())
+  {
+    std::atomic<size_t> next{0}, done{0};
+    std::atomic<bool> cancelled{false};
+    const auto hashRoms = [&] {
+      // Each thread hashes several ROMs at once
+      size_t first = 0;
+      while(!cancelled && (first = next.fetch_add(MD5::LANES)) < pending.size())
+      {
+        const size_t count = std::min(MD5::LANES, pending.size() - first);
+        vector<const FSNode*> files;
+        for(size_t i = first; i < first + count; ++i)
+          files.push_back(pending[i]->file);
+        try
+        {
+          const StringList md5s = OSystem::getROMMD5(files);
+          for(size_t i = 0; i < count; ++i)
+            pending[first + i]->md5 = md5s[i];
+        }
+        catch(const runtime_error&)
+        {
+          // The ROMs are skipped
+        }
+        done += count;
+      }
+    };
+    const uInt32 numThreads = BSPF::clamp(std::thread::hardware_concurrency(),
+                                          1U, MAX_THREADS);
+    vector<std::thread> threads;
+    for(uInt32 i = 0; i < numThreads; ++i)
+      threads.emplace_back(hashRoms);
+
+    while(done < pending.size() && !progress.isCancelled())
+    {
+      progress.setProgress(processed + static_cast<int>(done));
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    cancelled = progress.isCancelled();
+    for(auto& thread: threads)
+      thread.join();
+  }
+
+  // Plan the renames, using the ROM properties (stella.pro)
+  vector<std::pair<string, string>> renames;
+  std::unordered_set<string> newFiles;
   Properties props;
-  uInt32 renamed = 0, notfound = 0;
-  for(uInt32 idx = 0; idx < files.size() && !progress.isCancelled(); ++idx)
+  uInt32 notfound = 0;
+  for(const auto& rom: roms)
   {
-    string extension;
-    if(files[idx].isFile() &&
-       Bankswitch::isValidRomName(files[idx], extension))
+    if(progress.isCancelled())
+      break;
+
+    bool renamePlanned = false;
+    if(!rom.md5.empty() && instance().propSet().getMD5(rom.md5, props))
     {
-      bool renameSucceeded = false;
+      const string& name = props.get(PropType::Cart_Name);
 
-      // Calculate the MD5 so we can get the rest of the info
-      // from the PropertiesSet (stella.pro)
-      const string& md5 = OSystem::getROMMD5(files[idx]);
-      if(instance().propSet().getMD5(md5, props))
+      // Only rename the file if we found a valid properties entry
+      if(!name.empty() && name != rom.file->getName())
       {
-        const string& name = props.get(PropType::Cart_Name);
-
-        // Only rename the file if we found a valid properties entry
-        if(!name.empty() && name != files[idx].getName())
+        string newfile = node.getPath();
+        newfile.append(name).append(".").append(rom.extension);
+        // Never rename two ROMs to the same file
+        if(rom.file->getPath() != newfile && newFiles.insert(newfile).second)
         {
-          string newfile = node.getPath();
-          newfile.append(name).append(".").append(extension);
-          if(files[idx].getPath() != newfile && files[idx].rename(newfile))
-            renameSucceeded = true;
+          renames.emplace_back(rom.file->getPath(), newfile);
+          renamePlanned = true;
         }
       }
-      if(renameSucceeded)
-        ++renamed;
-      else
-        ++notfound;
     }
+    if(!renamePlanned)
+      ++notfound;
+  }
 
-    // Update the progress bar, indicating one more ROM has been processed
-    progress.incProgress();
+  // Finally execute (or only report) the planned renames
+  uInt32 renamed = 0;
+  if(!progress.isCancelled())
+  {
+    if(dryRun)
+    {
+      if(writeCSV(FSNode(node.getPath() + string{CSV_FILE}), renames))
+        renamed = static_cast<uInt32>(renames.size());
+      else
+        notfound += static_cast<uInt32>(renames.size());
+    }
+    else
+      for(const auto& [oldfile, newfile]: renames)
+      {
+        if(FSNode(oldfile).rename(newfile))
+          ++renamed;
+        else
+          ++notfound;
+      }
   }
   progress.close();
 
@@ -166,6 +278,37 @@ void RomAuditDialog::auditRoms()
   myResults2->setText(std::to_string(notfound));
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomAuditDialog::writeCSV(const FSNode& file,
+                              const vector<std::pair<string, string>>& renames)
+{
+  // Quote all fields, since file names may contain commas and quotes
+  const auto quoted = [](string_view text) {
+    string result = "\"";
+    for(const char c: text)
+    {
+      if(c == '"')
+        result += '"';
+      result += c;
+    }
+    return result + "\"";
+  };
+
+  stringstream out;
+  out << "\"Old File\",\"New File\"\n";
+  for(const auto& [oldfile, newfile]: renames)
+    out << quoted(oldfile) << ',' << quoted(newfile) << '\n';
+
+  try
+  {
+    return file.write(out) > 0;
+  }
+  catch(const runtime_error&)
+  {
+    return false;
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void RomAuditDialog::handleCommand(CommandSender* sender, int cmd,
                                    int data, int id)
@@ -173,6 +316,12 @@ void RomAuditDialog::handleCommand(CommandSender* sender, int cmd,
   switch (cmd)
   {
     case GuiObject::kOKCmd:
+      // A dry run doesn't modify any files
+      if(myDryRun->getState())
+      {
+        auditRoms();
+        break;
+      }
       if(!myConfirmMsg)
       {
         StringList msg;
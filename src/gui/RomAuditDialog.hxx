@@ -21,6 +21,7 @@
 class OSystem;
 class GuiObject;
 class DialogContainer;
+class CheckboxWidget;
 class EditTextWidget;
 class StaticTextWidget;
 namespace GUI {
@@ -41,6 +42,16 @@ class RomAuditDialog : public Dialog
   private:
     void loadConfig() override;
     void auditRoms();
+
+    /**
+      Write the planned renames of a dry run into a CSV file.
+
+      @param file     The CSV file
+      @param renames  The planned renames (old and new path)
+      @return  True if the file could be written
+    */
+    static bool writeCSV(const FSNode& file,
+                         const vector<std::pair<string, string>>& renames);
     void handleCommand(CommandSender* sender, int cmd, int data, int id) override;
 
   private:
@@ -56,6 +67,9 @@ class RomAuditDialog : public Dialog
     EditTextWidget* myResults1{nullptr};
     EditTextWidget* myResults2{nullptr};
 
+    // Only report the renames instead of executing them
+    CheckboxWidget* myDryRun{nullptr};
+
     // Show a message about the dangers of using this function
     unique_ptr<GUI::MessageBox> myConfirmMsg;
 
@@ -20,9 +20,7 @@
 #include "Dialog.hxx"
 #include "FBSurface.hxx"
 #include "Font.hxx"
-#include "JPGLibrary.hxx"
 #include "OSystem.hxx"
-#include "PNGLibrary.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
 #include "TimerManager.hxx"
@@ -41,6 +39,9 @@ RomImageWidget::RomImageWidget(GuiObject* boss, const GUI::Font& font,
 
   myZoomRect = Common::Rect(_w * 7 / 16, myImageHeight * 7 / 16,
                             _w * 9 / 16, myImageHeight * 9 / 16);
+#ifdef IMAGE_SUPPORT
+  mySnapshots = make_unique<SnapshotCache>(instance());
+#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -68,6 +69,9 @@ void RomImageWidget::clearProperties()
   myHaveProperties = mySurfaceIsValid = false;
   if(mySurface)
     mySurface->setVisible(false);
+#ifdef IMAGE_SUPPORT
+  myPendingImage.clear();
+#endif
 
   // Decide whether the information should be shown immediately
   if(instance().eventHandler().state() == EventHandlerState::LAUNCHER)
@@ -88,7 +92,12 @@ void RomImageWidget::reloadProperties(const FSNode& node)
   // by saving a different image or through a change in video renderer,
   // so we reload the properties
   if(myHaveProperties)
+  {
+  #ifdef IMAGE_SUPPORT
+    mySnapshots->reset();
+  #endif
     parseProperties(node);
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -147,22 +156,31 @@ void RomImageWidget::parseProperties(const FSNode& node, bool full)
     // Get a valid filename representing a snapshot file for this rom and load the snapshot
     const string& path = instance().snapshotLoadDir().getPath();
 
-    // 1. Try to load first snapshot by property name
+    // 1. Try to find first snapshot by property name
     string fileName = path + myProperties.get(PropType::Cart_Name);
-    tryImageFormats(fileName);
-    if(!mySurfaceIsValid)
+    bool found = tryImageFormats(fileName);
+    if(!found)
     {
-      // 2. If none exists, try to load first snapshot by ROM file name
+      // 2. If none exists, try to find first snapshot by ROM file name
       fileName = path + node.getName();
-      tryImageFormats(fileName);
+      found = tryImageFormats(fileName);
     }
-    if(mySurfaceIsValid)
+    if(found)
       myImageList.emplace_back(fileName);
     else
     {
-      // 3. If no ROM snapshots exist, try to load a default snapshot
+      // 3. If no ROM snapshots exist, try to find a default snapshot
       fileName = path + "default_snapshot";
-      tryImageFormats(fileName);
+      found = tryImageFormats(fileName);
+    }
+    if(found)
+      loadImage(fileName);
+    else
+    {
+      myPendingImage.clear();
+      mySurfaceIsValid = false;
+      mySurfaceErrorMsg = "No image found";
+      setDirty();
     }
   }
   else
@@ -181,6 +199,7 @@ void RomImageWidget::parseProperties(const FSNode& node, bool full)
       loadImage(myImageList[0].getPath());
     else
       setDirty(); // update the counter display
+    prefetchImages();
   }
 #else
   mySurfaceIsValid = false;
@@ -203,12 +222,44 @@ void RomImageWidget::parseProperties(const FSNode& node, bool full)
 bool RomImageWidget::changeImage(int direction)
 {
 #ifdef IMAGE_SUPPORT
+  bool result = false;
+
   if(direction == -1 && myImageIdx)
-    return loadImage(myImageList[--myImageIdx].getPath());
+    result = loadImage(myImageList[--myImageIdx].getPath());
   else if(direction == 1 && myImageIdx + 1 < myImageList.size())
-    return loadImage(myImageList[++myImageIdx].getPath());
-#endif
+    result = loadImage(myImageList[++myImageIdx].getPath());
+  else
+    return false;
+
+  prefetchImages();
+  return result;
+#else
   return false;
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomImageWidget::prefetch(const vector<std::pair<FSNode, string>>& roms)
+{
+#ifdef IMAGE_SUPPORT
+  const string& path = instance().snapshotLoadDir().getPath();
+
+  // Same search order as in parseProperties(), but without the default snapshot
+  myPrefetchImages.clear();
+  for(const auto& [node, cartName]: roms)
+  {
+    string fileName = path + cartName;
+    bool found = !cartName.empty() && tryImageFormats(fileName);
+    if(!found)
+    {
+      fileName = path + node.getName();
+      found = tryImageFormats(fileName);
+    }
+    if(found)
+      myPrefetchImages.push_back(fileName);
+  }
+  mySnapshots->prefetch(myPrefetchImages);
+#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -239,8 +290,9 @@ bool RomImageWidget::getImageList(const string& propName, const string& romName,
   );
 
   // Find all images matching the given names and the extension
-  const FSNode node(instance().snapshotLoadDir().getPath());
-  node.getChildren(myImageList, FSNode::ListMode::FilesOnly, filter, false, false);
+  for(const auto& file: mySnapshots->files())
+    if(filter(file))
+      myImageList.push_back(file);
 
   // Sort again, not considering extensions, else <filename.png|jpg> would be at
   // the end of the list
@@ -265,15 +317,14 @@ bool RomImageWidget::getImageList(const string& propName, const string& romName,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool RomImageWidget::tryImageFormats(string& fileName)
 {
-  if(loadImage(fileName + ".png"))
-  {
-    fileName += ".png";
-    return true;
-  }
-  if(loadImage(fileName + ".jpg"))
+  for(const string_view ext: { ".png", ".jpg" })
   {
-    fileName += ".jpg";
-    return true;
+    string path = fileName + string{ext};
+    if(mySnapshots->findFile(path))
+    {
+      fileName = path;
+      return true;
+    }
   }
   return false;
 }
@@ -283,17 +334,18 @@ bool RomImageWidget::loadImage(const string& fileName)
 {
   mySurfaceErrorMsg.clear();
 
-  const string::size_type idx = fileName.find_last_of('.');
-
-  if(idx != string::npos && fileName.substr(idx + 1) == "png")
-    mySurfaceIsValid = loadPng(fileName);
+  const SnapshotCache::ImagePtr image = mySnapshots->image(fileName);
+  if(image)
+  {
+    myPendingImage.clear();
+    showImage(*image);
+  }
   else
-    mySurfaceIsValid = loadJpg(fileName);
-
-  if(mySurfaceIsValid)
   {
-    mySrcRect = mySurface->srcRect();
-    zoomSurfaces(false, true);
+    // The image is shown by tick() when it has been decoded
+    myPendingImage = fileName;
+    mySurfaceIsValid = false;
+    myLabel.clear();
   }
 
   if(mySurface)
@@ -306,60 +358,73 @@ bool RomImageWidget::loadImage(const string& fileName)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool RomImageWidget::loadPng(const string& fileName)
+void RomImageWidget::showImage(const SnapshotCache::Image& image)
 {
-  try
+  if(!image.error.empty())
   {
-    VariantList metaData;
-    instance().png().loadImage(fileName, *mySurface, metaData);
-
-    // Retrieve label for loaded image
+    mySurfaceErrorMsg = image.error;
+    mySurfaceIsValid = false;
     myLabel.clear();
-    for(const auto& data: metaData)
-    {
-      if(data.first == "Title")
-      {
-        myLabel = data.second.toString();
-        break;
-      }
-      if(data.first == "Software"
-          && data.second.toString().find("Stella") == 0)
-        myLabel = "Snapshot"; // default for Stella snapshots with missing "Title" meta data
-    }
-    return true;
-  }
-  catch(const runtime_error& e)
-  {
-    mySurfaceErrorMsg = e.what();
+    return;
   }
-  return false;
+
+  // First determine if we need to resize the surface
+  if(image.width > mySurface->width() || image.height > mySurface->height())
+    mySurface->resize(image.width, image.height);
+
+  // The source dimensions are set here, the destination dimensions
+  // are set by zoomSurfaces()
+  mySurface->setSrcPos(0, 0);
+  mySurface->setSrcSize(image.width, image.height);
+
+  uInt32 *s_buf{nullptr}, s_pitch{0};
+  mySurface->basePtr(s_buf, s_pitch);
+  const uInt32* i_buf = image.pixels.data();
+  for(uInt32 row = 0; row < image.height; ++row, i_buf += image.width, s_buf += s_pitch)
+    std::copy_n(i_buf, image.width, s_buf);
+
+  // Retrieve label for loaded image
+  myLabel = imageLabel(image.metaData);
+
+  mySurfaceIsValid = true;
+  mySrcRect = mySurface->srcRect();
+  zoomSurfaces(false, true);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool RomImageWidget::loadJpg(const string& fileName)
+void RomImageWidget::prefetchImages()
 {
-  try
-  {
-    VariantList metaData;
-    instance().jpg().loadImage(fileName, *mySurface, metaData);
+  // Decode the adjacent images of the current ROM in the background,
+  // followed by the images of the adjacent ROMs
+  StringList fileNames;
 
-    // Retrieve label for loaded image
-    myLabel.clear();
-    for(const auto& data: metaData)
-    {
-      if(data.first == "ImageDescription")
-      {
-        myLabel = data.second.toString();
-        break;
-      }
-    }
-    return true;
-  }
-  catch(const runtime_error& e)
+  if(myImageIdx + 1 < myImageList.size())
+    fileNames.push_back(myImageList[myImageIdx + 1].getPath());
+  if(myImageIdx > 0)
+    fileNames.push_back(myImageList[myImageIdx - 1].getPath());
+  fileNames.insert(fileNames.end(), myPrefetchImages.begin(), myPrefetchImages.end());
+
+  mySnapshots->prefetch(fileNames);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string RomImageWidget::imageLabel(const VariantList& metaData)
+{
+  string label;
+
+  for(const auto& data: metaData)
   {
-    mySurfaceErrorMsg = e.what();
+    // PNG images
+    if(data.first == "Title")
+      return data.second.toString();
+    if(data.first == "Software"
+        && data.second.toString().find("Stella") == 0)
+      label = "Snapshot"; // default for Stella snapshots with missing "Title" meta data
+    // JPG images
+    if(data.first == "ImageDescription")
+      return data.second.toString();
   }
-  return false;
+  return label;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -521,6 +586,10 @@ void RomImageWidget::handleMouseMoved(int x, int y)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void RomImageWidget::tick()
 {
+  // Show the pending image, once it has been decoded
+  if(!myPendingImage.empty() && mySnapshots->image(myPendingImage))
+    loadImage(myPendingImage);
+
   if(myMouseArea == Area::ZOOM || myZoomMode)
   {
     myZoomTimer += REQUEST_SPEED;
@@ -22,6 +22,7 @@ class FBSurface;
 class Properties;
 
 #include "Widget.hxx"
+#include "SnapshotCache.hxx"
 
 class RomImageWidget : public Widget
 {
@@ -40,6 +41,14 @@ class RomImageWidget : public Widget
     void clearProperties();
     void reloadProperties(const FSNode& node);
     bool changeImage(int direction = 1);
+
+    /**
+      Decode the first snapshots of the given ROMs in the background, so
+      that they can be shown immediately when one of the ROMs is selected.
+
+      @param roms  The ROM files and their cart names (empty if unknown)
+    */
+    void prefetch(const vector<std::pair<FSNode, string>>& roms);
     // Toggle zoom via keyboard
     void toggleImageZoom();
     void disableImageZoom() { myZoomMode = false; }
@@ -62,8 +71,9 @@ class RomImageWidget : public Widget
                       const string& oldFileName);
     bool tryImageFormats(string& fileName);
     bool loadImage(const string& fileName);
-    bool loadPng(const string& fileName);
-    bool loadJpg(const string& fileName);
+    void showImage(const SnapshotCache::Image& image);
+    void prefetchImages();
+    static string imageLabel(const VariantList& metaData);
 
     void zoomSurfaces(bool zoomed, bool force = false);
     void positionSurfaces();
@@ -151,6 +161,17 @@ class RomImageWidget : public Widget
     // Maximum load time, for adapting pending loads delay
     uInt64 myMaxLoadTime{0};
 
+  #ifdef IMAGE_SUPPORT
+    // The decoded images and the snapshot directory contents
+    unique_ptr<SnapshotCache> mySnapshots;
+
+    // The image which is still being decoded
+    string myPendingImage;
+
+    // The first images of the ROMs around the launcher's cursor
+    StringList myPrefetchImages;
+  #endif
+
   private:
     // Following constructors and assignment operators not supported
     RomImageWidget() = delete;
@@ -0,0 +1,318 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include "repository/CompositeKeyValueRepositoryNoop.hxx"
+#include "Bankswitch.hxx"
+#include "Cart.hxx"
+#include "CartDetector.hxx"
+#include "MD5.hxx"
+
+#include "RomIndex.hxx"
+
+namespace {
+  // Must be increased whenever the contents of the entries change (e.g. by
+  // changes to the bankswitch type detection), which invalidates them
+  constexpr Int32 INDEX_VERSION = 1;
+
+  // The maximum number of background threads
+  constexpr uInt32 MAX_THREADS = 4;
+} // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomIndex::~RomIndex()
+{
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+    myStopThreads = true;
+    myJobs.clear();
+  }
+  myCondition.notify_all();
+  for(auto& thread: myThreads)
+    thread.join();
+
+  update();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::setRepository(shared_ptr<CompositeKeyValueRepository> repository)
+{
+  myRepository = std::move(repository);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomIndex::Entry RomIndex::entry(const FSNode& rom)
+{
+  const string& path = rom.getPath();
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+    const auto iter = myRecords.find(path);
+    if(iter != myRecords.end())
+      return iter->second.entry;
+  }
+  Record record = createRecord(rom, storedValues(path));
+
+  const std::lock_guard<std::mutex> lock(myMutex);
+  return addRecord(path, std::move(record)).entry;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string RomIndex::knownMD5(const FSNode& rom)
+{
+  const string& path = rom.getPath();
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+    const auto iter = myRecords.find(path);
+    if(iter != myRecords.end())
+      return iter->second.entry.md5;
+  }
+  Record record;
+  record.size = std::to_string(rom.getSize());
+  record.modified = std::to_string(rom.getModificationTime());
+  if(!restoreEntry(record, storedValues(path)))
+    return EmptyString;
+
+  const std::lock_guard<std::mutex> lock(myMutex);
+  return addRecord(path, std::move(record)).entry.md5;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::setName(const FSNode& rom, string_view name)
+{
+  const std::lock_guard<std::mutex> lock(myMutex);
+  const auto iter = myRecords.find(rom.getPath());
+
+  if(iter != myRecords.end() && iter->second.entry.name != name)
+  {
+    iter->second.entry.name = name;
+    myChangedRecords.insert(rom.getPath());
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::setControllers(const FSNode& rom, string_view leftJack,
+                              string_view rightJack)
+{
+  const std::lock_guard<std::mutex> lock(myMutex);
+  const auto iter = myRecords.find(rom.getPath());
+
+  if(iter != myRecords.end() && (iter->second.entry.leftJack != leftJack ||
+     iter->second.entry.rightJack != rightJack))
+  {
+    iter->second.entry.leftJack = leftJack;
+    iter->second.entry.rightJack = rightJack;
+    myChangedRecords.insert(rom.getPath());
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::prefetch(const FSList& list, size_t first, size_t count)
+{
+  std::deque<Job> jobs;
+  const size_t last = std::min(first + count, list.size());
+
+  for(size_t i = first; i < last; ++i)
+  {
+    const FSNode& node = list[i];
+    if(node.isDirectory() || !Bankswitch::isValidRomName(node))
+      continue;
+    {
+      const std::lock_guard<std::mutex> lock(myMutex);
+      if(myRecords.find(node.getPath()) != myRecords.end())
+        continue;
+    }
+    jobs.push_back({node.getPath(), storedValues(node.getPath())});
+  }
+  if(jobs.empty())
+    return;
+
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+    myJobs = std::move(jobs);
+
+    // Start the threads when they are needed for the first time
+    if(myThreads.empty())
+    {
+      const uInt32 numThreads = BSPF::clamp(std::thread::hardware_concurrency(),
+                                            1U, MAX_THREADS);
+      for(uInt32 i = 0; i < numThreads; ++i)
+        myThreads.emplace_back([this] { indexThread(); });
+    }
+  }
+  myCondition.notify_all();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::update()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  while(!myChangedRecords.empty())
+  {
+    const string path = *myChangedRecords.begin();
+    myChangedRecords.erase(myChangedRecords.begin());
+
+    const auto iter = myRecords.find(path);
+    if(iter == myRecords.end())
+      continue;
+
+    const Record& record = iter->second;
+    const KVRMap values = {
+      { "version", INDEX_VERSION },
+      { "size", record.size },
+      { "modified", record.modified },
+      { "md5", record.entry.md5 },
+      { "type", record.entry.type },
+      { "name", record.entry.name },
+      { "left", record.entry.leftJack },
+      { "right", record.entry.rightJack },
+      { "plusrom", record.entry.plusROM }
+    };
+    // Don't block the background threads while saving
+    lock.unlock();
+    myRepository->get(path)->save(values);
+    lock.lock();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::reset()
+{
+  update();
+
+  const std::lock_guard<std::mutex> lock(myMutex);
+  myJobs.clear();
+  myRecords.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomIndex::Record RomIndex::createRecord(const FSNode& rom, const KVRMap& stored)
+{
+  Record record;
+  record.size = std::to_string(rom.getSize());
+  record.modified = std::to_string(rom.getModificationTime());
+
+  // Reuse the stored entry if the file has not been changed since
+  if(!restoreEntry(record, stored))
+  {
+    record.entry = createEntry(rom);
+    record.changed = true;
+  }
+  return record;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomIndex::restoreEntry(Record& record, const KVRMap& stored)
+{
+  const auto value = [&stored](const string& key) {
+    const auto iter = stored.find(key);
+    return iter != stored.end() ? iter->second : Variant();
+  };
+
+  if(value("version").toInt() != INDEX_VERSION ||
+     value("size").toString() != record.size ||
+     value("modified").toString() != record.modified)
+    return false;
+
+  record.entry.md5 = value("md5").toString();
+  record.entry.type = value("type").toString();
+  record.entry.name = value("name").toString();
+  record.entry.leftJack = value("left").toString();
+  record.entry.rightJack = value("right").toString();
+  record.entry.plusROM = value("plusrom").toBool();
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomIndex::Entry RomIndex::createEntry(const FSNode& rom)
+{
+  Entry entry;
+
+  if(!rom.isFile() || !Bankswitch::isValidRomName(rom))
+    return entry;
+
+  // Streaming ROMs only use a portion of the file (see OSystem::getROMMD5)
+  const size_t sizeToRead = CartDetector::isProbablyMVC(rom);
+  if(sizeToRead == 0 && rom.getSize() > Cartridge::maxSize())
+    return entry;
+
+  try
+  {
+    ByteBuffer image;
+    const size_t size = rom.read(image, sizeToRead);
+
+    if(size > 0)
+    {
+      entry.md5 = MD5::hash(image, size);
+      entry.type = Bankswitch::typeToName(sizeToRead > 0
+        ? Bankswitch::Type::_MVC : CartDetector::autodetectType(image, size));
+      entry.plusROM = CartDetector::isProbablyPlusROM(image, size);
+    }
+  }
+  catch(const runtime_error&)
+  {
+    // The ROM stays unindexed
+  }
+  return entry;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+KVRMap RomIndex::storedValues(const string& path) const
+{
+  KVRMap values;
+  myRepository->load(path, values);
+
+  return values;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const RomIndex::Record& RomIndex::addRecord(const string& path, Record&& record)
+{
+  const auto [iter, added] = myRecords.emplace(path, std::move(record));
+  if(added && iter->second.changed)
+    myChangedRecords.insert(path);
+
+  return iter->second;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::indexThread()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  while(true)
+  {
+    myCondition.wait(lock, [this] { return myStopThreads || !myJobs.empty(); });
+    if(myStopThreads)
+      return;
+
+    const Job job = std::move(myJobs.front());
+    myJobs.pop_front();
+
+    // The ROM may have been requested meanwhile
+    if(myRecords.find(job.path) != myRecords.end())
+      continue;
+
+    // Use a separate node, the launcher's nodes must not be shared
+    lock.unlock();
+    Record record = createRecord(FSNode(job.path), job.stored);
+    lock.lock();
+
+    addRecord(job.path, std::move(record));
+  }
+}
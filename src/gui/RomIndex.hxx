@@ -0,0 +1,192 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef ROM_INDEX_HXX
+#define ROM_INDEX_HXX
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "bspf.hxx"
+#include "FSNode.hxx"
+#include "repository/CompositeKeyValueRepository.hxx"
+
+/**
+  This class indexes the ROMs shown in the launcher.  For each ROM file,
+  identified by its path, size and modification time, it remembers the MD5,
+  the detected bankswitch type, the cart name and the detected controllers.
+  The index is persisted, so ROMs are only read again when they have
+  been changed.
+
+  ROMs ahead of the launcher's cursor are indexed by background threads,
+  all other ROMs when they are requested.
+*/
+class RomIndex
+{
+  public:
+    struct Entry
+    {
+      string md5;         // empty if the file is no valid ROM
+      string type;        // the detected bankswitch type
+      string name;        // the cart name (set by the launcher)
+      string leftJack;    // the controllers detected for each jack
+      string rightJack;   //  (set by the ROM info widget)
+      bool plusROM{false};
+    };
+
+  public:
+    RomIndex() = default;
+    ~RomIndex();
+
+    void setRepository(shared_ptr<CompositeKeyValueRepository> repository);
+
+    /**
+      Get the index entry of the given ROM.  If the ROM has not been indexed
+      yet, this is done immediately.
+
+      @param rom  The ROM file
+      @return  The index entry of the ROM
+    */
+    Entry entry(const FSNode& rom);
+
+    /**
+      Get the MD5 of the given ROM, if it has been indexed before and has
+      not been changed since.  The ROM itself is never read.
+
+      @param rom  The ROM file
+      @return  The MD5 of the ROM, or empty if the ROM is not indexed
+    */
+    string knownMD5(const FSNode& rom);
+
+    /**
+      Remember the cart name of an indexed ROM.
+
+      @param rom   The ROM file
+      @param name  The cart name from the ROM's properties
+    */
+    void setName(const FSNode& rom, string_view name);
+
+    /**
+      Remember the controllers detected for an indexed ROM.
+
+      @param rom        The ROM file
+      @param leftJack   The controller detected for the left jack
+      @param rightJack  The controller detected for the right jack
+    */
+    void setControllers(const FSNode& rom, string_view leftJack,
+                        string_view rightJack);
+
+    /**
+      Index the given range of ROMs in the background.  ROMs which are still
+      pending from previous calls are dropped.
+
+      @param list   The list containing the ROMs
+      @param first  The index of the first ROM in the list
+      @param count  The number of ROMs
+    */
+    void prefetch(const FSList& list, size_t first, size_t count);
+
+    /**
+      Save the entries indexed in the background.  Must be called regularly
+      from the main thread, since the repository is not thread-safe.
+    */
+    void update();
+
+    /**
+      Forget all entries in memory, so that ROMs are checked for changes
+      again when they are requested the next time.
+    */
+    void reset();
+
+  private:
+    struct Record
+    {
+      string size;        // file size and modification time, as stored
+      string modified;
+      Entry entry;
+      bool changed{false};  // the record must be saved
+    };
+
+    /**
+      Create the index record of a ROM, reusing the stored values if the
+      file has not been changed since.
+    */
+    static Record createRecord(const FSNode& rom, const KVRMap& stored);
+
+    /**
+      Fill the entry of a record from the stored values, if these are
+      still valid for the record's file.
+    */
+    static bool restoreEntry(Record& record, const KVRMap& stored);
+
+    /**
+      Read the ROM and calculate its index entry.
+    */
+    static Entry createEntry(const FSNode& rom);
+
+    /**
+      Get the stored values of the given ROM path from the repository.
+    */
+    KVRMap storedValues(const string& path) const;
+
+    /**
+      Add a record to the memory index, unless it has been added meanwhile.
+      Must be called with the mutex locked.
+    */
+    const Record& addRecord(const string& path, Record&& record);
+
+    /**
+      The background thread indexing pending ROMs.
+    */
+    void indexThread();
+
+  private:
+    shared_ptr<CompositeKeyValueRepository> myRepository;
+
+    // The indexed ROMs by path
+    std::unordered_map<string, Record> myRecords;
+
+    // The paths of records which still have to be saved
+    std::unordered_set<string> myChangedRecords;
+
+    // The ROMs waiting to be indexed in the background
+    struct Job
+    {
+      string path;
+      KVRMap stored;
+    };
+    std::deque<Job> myJobs;
+
+    vector<std::thread> myThreads;
+    std::mutex myMutex;
+    std::condition_variable myCondition;
+    bool myStopThreads{false};
+
+  private:
+    // Following constructors and assignment operators not supported
+    RomIndex(const RomIndex&) = delete;
+    RomIndex(RomIndex&&) = delete;
+    RomIndex& operator=(const RomIndex&) = delete;
+    RomIndex& operator=(RomIndex&&) = delete;
+};
+
+#endif
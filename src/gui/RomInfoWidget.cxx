@@ -25,6 +25,7 @@
 #include "CartDetector.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "RomIndex.hxx"
 #include "RomInfoWidget.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -119,32 +120,64 @@ void RomInfoWidget::parseProperties(const FSNode& node, bool full)
     string bsDetected = myProperties.get(PropType::Cart_Type);
     bool isPlusCart = false;
     size_t size = 0;
-    try
+
+    // Use the ROM index for the values detected before, so that the ROM
+    // only has to be read if the controllers have never been detected
+    RomIndex::Entry entry;
+    if(node.exists() && !node.isDirectory())
+      entry = instance().romIndex().entry(node);
+    const string& leftJack = !swappedPorts ? entry.leftJack : entry.rightJack;
+    const string& rightJack = !swappedPorts ? entry.rightJack : entry.leftJack;
+
+    if(!entry.md5.empty() && !entry.type.empty() &&
+       (leftType != Controller::Type::Unknown || !leftJack.empty()) &&
+       (rightType != Controller::Type::Unknown || !rightJack.empty()) &&
+       !instance().settings().getBool("rominfo"))
     {
-      ByteBuffer image;
-      string md5;
+      left = leftType != Controller::Type::Unknown
+        ? Controller::getName(leftType) : leftJack;
+      right = rightType != Controller::Type::Unknown
+        ? Controller::getName(rightType) : rightJack;
+      if(bsDetected == "AUTO")
+        bsDetected = entry.type;
 
-      if(node.exists() && !node.isDirectory() &&
-        (image = instance().openROM(node, md5, size)) != nullptr)
-      {
-        Logger::debug(myProperties.get(PropType::Cart_Name) + ":");
-        left = ControllerDetector::detectName(image, size, leftType,
-          !swappedPorts ? Controller::Jack::Left : Controller::Jack::Right,
-            instance().settings());
-        right = ControllerDetector::detectName(image, size, rightType,
-          !swappedPorts ? Controller::Jack::Right : Controller::Jack::Left,
-            instance().settings());
-        if(bsDetected == "AUTO")
-          bsDetected = Bankswitch::typeToName(CartDetector::autodetectType(image, size));
-
-        isPlusCart = CartDetector::isProbablyPlusROM(image, size);
-      }
+      isPlusCart = entry.plusROM;
+      size = node.getSize();
     }
-    catch(const runtime_error&)
+    else
     {
-      // Do nothing; we simply don't update the controllers if openROM
-      // failed for any reason
-      left = right = "";
+      try
+      {
+        ByteBuffer image;
+        string md5 = entry.md5;
+
+        if(node.exists() && !node.isDirectory() &&
+          (image = instance().openROM(node, md5, size)) != nullptr)
+        {
+          Logger::debug(myProperties.get(PropType::Cart_Name) + ":");
+          left = ControllerDetector::detectName(image, size, leftType,
+            !swappedPorts ? Controller::Jack::Left : Controller::Jack::Right,
+              instance().settings());
+          right = ControllerDetector::detectName(image, size, rightType,
+            !swappedPorts ? Controller::Jack::Right : Controller::Jack::Left,
+              instance().settings());
+          if(bsDetected == "AUTO")
+            bsDetected = Bankswitch::typeToName(CartDetector::autodetectType(image, size));
+
+          isPlusCart = CartDetector::isProbablyPlusROM(image, size);
+
+          // Remember the controllers detected for the jacks
+          if(leftType == Controller::Type::Unknown && rightType == Controller::Type::Unknown)
+            instance().romIndex().setControllers(node,
+              !swappedPorts ? left : right, !swappedPorts ? right : left);
+        }
+      }
+      catch(const runtime_error&)
+      {
+        // Do nothing; we simply don't update the controllers if openROM
+        // failed for any reason
+        left = right = "";
+      }
     }
     if(!left.empty() && !right.empty())
       myRomInfo.push_back("Controllers: " + (left + " (left), " + right + " (right)"));
@@ -0,0 +1,235 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifdef IMAGE_SUPPORT
+
+#include "OSystem.hxx"
+#include "JPGLibrary.hxx"
+#include "PNGLibrary.hxx"
+
+#include "SnapshotCache.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SnapshotCache::SnapshotCache(OSystem& osystem)
+  : myOSystem{osystem}
+{
+  myThread = std::thread([this] { decodeThread(); });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SnapshotCache::~SnapshotCache()
+{
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+    myStopThread = true;
+  }
+  myCondition.notify_all();
+  myThread.join();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SnapshotCache::ImagePtr SnapshotCache::image(const string& path)
+{
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+
+    const auto iter = myImages.find(path);
+    if(iter != myImages.end())
+    {
+      // Make it the most recently used image
+      myLRU.splice(myLRU.begin(), myLRU, iter->second.lru);
+      return iter->second.image;
+    }
+    if(path == myDecoding)
+      return nullptr;
+
+    // Only the latest request matters
+    myRequest = path;
+  }
+  myCondition.notify_one();
+  return nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotCache::prefetch(const StringList& paths)
+{
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+
+    myPrefetches.clear();
+    for(const auto& path: paths)
+      if(myImages.find(path) == myImages.end() && path != myDecoding)
+        myPrefetches.push_back(path);
+  }
+  myCondition.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const FSList& SnapshotCache::files()
+{
+  updateFiles();
+  return myFiles;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SnapshotCache::findFile(string& path)
+{
+  updateFiles();
+
+  const auto it = myFilePaths.find(fileKey(path));
+  if(it == myFilePaths.end())
+    return false;
+
+  path = it->second;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotCache::reset()
+{
+  const std::lock_guard<std::mutex> lock(myMutex);
+
+  myImages.clear();
+  myLRU.clear();
+  mySize = 0;
+  myRequest.clear();
+  myPrefetches.clear();
+  // The image currently decoded may be outdated too
+  myDecoding.clear();
+  ++myGeneration;
+
+  myDirectory.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotCache::updateFiles()
+{
+  const FSNode& dir = myOSystem.snapshotLoadDir();
+  const uInt64 modified = dir.getModificationTime();
+
+  if(dir.getPath() == myDirectory && modified == myModified)
+    return;
+
+  myDirectory = dir.getPath();
+  myModified = modified;
+  myFiles.clear();
+  myFilePaths.clear();
+
+  const FSNode::NameFilter filter = [](const FSNode& node) {
+    return BSPF::endsWithIgnoreCase(node.getName(), ".png") ||
+           BSPF::endsWithIgnoreCase(node.getName(), ".jpg");
+  };
+  dir.getChildren(myFiles, FSNode::ListMode::FilesOnly, filter, false, false);
+
+  for(const auto& file: myFiles)
+    myFilePaths.emplace(fileKey(file.getPath()), file.getPath());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string SnapshotCache::fileKey(string path)
+{
+#if defined(BSPF_WINDOWS) || defined(BSPF_MACOS)
+  // These file systems are usually case-insensitive
+  BSPF::toLowerCase(path);
+#endif
+  return path;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotCache::addImage(const string& path, const ImagePtr& image)
+{
+  if(myImages.find(path) != myImages.end())
+    return;
+
+  myLRU.push_front(path);
+  myImages.emplace(path, Entry{image, myLRU.begin()});
+  mySize += sizeof(Image) + image->pixels.size() * sizeof(uInt32);
+
+  // Drop the least recently used images, but keep the new one
+  while(mySize > CACHE_BUDGET && myLRU.size() > 1)
+  {
+    const auto iter = myImages.find(myLRU.back());
+    mySize -= sizeof(Image) + iter->second.image->pixels.size() * sizeof(uInt32);
+    myImages.erase(iter);
+    myLRU.pop_back();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SnapshotCache::ImagePtr SnapshotCache::decodeImage(const string& path) const
+{
+  auto image = make_shared<Image>();
+
+  try
+  {
+    if(BSPF::endsWithIgnoreCase(path, ".png"))
+      myOSystem.png().decodeImage(path, image->pixels, image->width,
+                                  image->height, image->metaData);
+    else
+      myOSystem.jpg().decodeImage(path, image->pixels, image->width,
+                                  image->height, image->metaData);
+  }
+  catch(const runtime_error& e)
+  {
+    image->pixels.clear();
+    image->error = e.what();
+  }
+  return image;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotCache::decodeThread()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  while(true)
+  {
+    myCondition.wait(lock, [this] {
+      return myStopThread || !myRequest.empty() || !myPrefetches.empty();
+    });
+    if(myStopThread)
+      return;
+
+    string path;
+    if(!myRequest.empty())
+      std::swap(path, myRequest);
+    else
+    {
+      path = std::move(myPrefetches.front());
+      myPrefetches.pop_front();
+    }
+    // The image may have been decoded meanwhile
+    if(myImages.find(path) != myImages.end())
+      continue;
+
+    const uInt32 generation = myGeneration;
+    myDecoding = path;
+
+    // Don't block the main thread while decoding
+    lock.unlock();
+    const ImagePtr image = decodeImage(path);
+    lock.lock();
+
+    if(generation == myGeneration)
+    {
+      myDecoding.clear();
+      addImage(path, image);
+    }
+  }
+}
+
+#endif  // IMAGE_SUPPORT
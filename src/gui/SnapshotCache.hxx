@@ -0,0 +1,179 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifdef IMAGE_SUPPORT
+
+#ifndef SNAPSHOT_CACHE_HXX
+#define SNAPSHOT_CACHE_HXX
+
+class OSystem;
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "bspf.hxx"
+#include "FSNode.hxx"
+#include "Variant.hxx"
+
+/**
+  This class caches the snapshot images shown in the launcher.  Images are
+  decoded by a background thread and kept in memory, up to a given budget,
+  dropping the least recently used images first.  Since the images of the
+  ROMs around the launcher's cursor can be decoded ahead, scrolling through
+  the ROMs does not have to wait for the image files.
+
+  The class also caches the list of image files in the snapshot directory.
+  Except for the decoding, everything is done in the main thread.
+*/
+class SnapshotCache
+{
+  public:
+    struct Image
+    {
+      uInt32 width{0}, height{0};
+      vector<uInt32> pixels;  // mapped to the framebuffer format
+      VariantList metaData;
+      string error;           // not empty if the image could not be loaded
+    };
+    using ImagePtr = shared_ptr<const Image>;
+
+  public:
+    explicit SnapshotCache(OSystem& osystem);
+    ~SnapshotCache();
+
+    /**
+      Get the decoded image of the given file.  If the image has not been
+      decoded yet, it is decoded in the background before all other images.
+
+      @param path  The full path of the image file
+      @return  The image, or nullptr while it is being decoded
+    */
+    ImagePtr image(const string& path);
+
+    /**
+      Decode the given images in the background.  Images which are still
+      pending from previous calls are dropped.
+
+      @param paths  The full paths of the image files, the most important first
+    */
+    void prefetch(const StringList& paths);
+
+    /**
+      Get all image files in the snapshot directory.  The directory is only
+      read again when it has been changed.
+
+      @return  The list of image files
+    */
+    const FSList& files();
+
+    /**
+      Check if the given image file exists in the snapshot directory.  On
+      systems with case-insensitive file systems, the case of the name is
+      ignored.
+
+      @param path  The full path of the image file; replaced by the path
+                   of the existing file if found
+      @return  True if the file exists
+    */
+    bool findFile(string& path);
+
+    /**
+      Forget all images and the directory list, e.g. because new snapshots
+      might have been saved.
+    */
+    void reset();
+
+  private:
+    /**
+      Read the snapshot directory, if it has been changed since the last call.
+    */
+    void updateFiles();
+
+    /**
+      Get the key of the given path in the list of image files.
+    */
+    static string fileKey(string path);
+
+    /**
+      Add a decoded image to the cache, dropping the least recently used
+      images if the cache exceeds its budget.  Must be called with the mutex
+      locked.
+    */
+    void addImage(const string& path, const ImagePtr& image);
+
+    /**
+      Read and decode an image file.
+    */
+    ImagePtr decodeImage(const string& path) const;
+
+    /**
+      The background thread decoding pending images.
+    */
+    void decodeThread();
+
+  private:
+    // The maximum memory used by the cached images (in bytes)
+    static constexpr size_t CACHE_BUDGET = 32 * 1024 * 1024;
+
+    OSystem& myOSystem;
+
+    // The cached images by path, and their paths, most recently used first
+    struct Entry
+    {
+      ImagePtr image;
+      std::list<string>::iterator lru;
+    };
+    std::unordered_map<string, Entry> myImages;
+    std::list<string> myLRU;
+    size_t mySize{0};
+
+    // The images waiting to be decoded; the requested image is decoded
+    // before the prefetched ones
+    string myRequest;
+    std::deque<string> myPrefetches;
+    string myDecoding;
+
+    // Incremented by each reset, so that outdated images get dropped
+    uInt32 myGeneration{0};
+
+    // The image files of the snapshot directory
+    string myDirectory;
+    uInt64 myModified{0};
+    FSList myFiles;
+    std::unordered_map<string, string> myFilePaths;  // key -> path
+
+    std::thread myThread;
+    std::mutex myMutex;
+    std::condition_variable myCondition;
+    bool myStopThread{false};
+
+  private:
+    // Following constructors and assignment operators not supported
+    SnapshotCache() = delete;
+    SnapshotCache(const SnapshotCache&) = delete;
+    SnapshotCache(SnapshotCache&&) = delete;
+    SnapshotCache& operator=(const SnapshotCache&) = delete;
+    SnapshotCache& operator=(SnapshotCache&&) = delete;
+};
+
+#endif
+
+#endif  // IMAGE_SUPPORT
@@ -48,6 +48,8 @@ MODULE_OBJS := \
         src/gui/RadioButtonWidget.o \
         src/gui/RomAuditDialog.o \
         src/gui/RomImageWidget.o \
+        src/gui/RomIndex.o \
+        src/gui/SnapshotCache.o \
         src/gui/RomInfoWidget.o \
         src/gui/ScrollBarWidget.o \
         src/gui/SnapshotDialog.o \
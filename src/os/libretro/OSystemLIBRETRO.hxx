@@ -77,6 +77,16 @@ class OSystemLIBRETRO : public OSystem
       return make_shared<CompositeKeyValueRepositoryNoop>();
     }
 
+    shared_ptr<CompositeKeyValueRepository>
+    getAutodetectRepository() override {
+      return make_shared<CompositeKeyValueRepositoryNoop>();
+    }
+
+    shared_ptr<CompositeKeyValueRepository>
+    getRomIndexRepository() override {
+      return make_shared<CompositeKeyValueRepositoryNoop>();
+    }
+
   protected:
     void initPersistence(FSNode& basedir) override { }
     string describePresistence() override { return "none"; }
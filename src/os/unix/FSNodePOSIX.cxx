@@ -108,6 +108,13 @@ size_t FSNodePOSIX::getSize() const
   return _size;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 FSNodePOSIX::getModificationTime() const
+{
+  struct stat st;
+  return stat(_path.c_str(), &st) == 0 ? static_cast<uInt64>(st.st_mtime) : 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FSNodePOSIX::hasParent() const
 {
@@ -75,6 +75,7 @@ class FSNodePOSIX : public AbstractFSNode
     bool rename(string_view newfile) override;
 
     size_t getSize() const override;
+    uInt64 getModificationTime() const override;
     bool hasParent() const override;
     AbstractFSNodePtr getParent() const override;
     bool getChildren(AbstractFSList& list, ListMode mode) const override;
@@ -80,8 +80,10 @@ print OUTFILE "*/\n";
 print OUTFILE "static constexpr BSPF::array2D<const char*, DEF_PROPS_SIZE, " . $typesize . "> DefProps = {{\n";
 
 # Walk the hash map and print each item in order of md5sum
+# (case-insensitive, since the MD5 index below requires this order)
+my @keys = sort { lc($a) cmp lc($b) } keys %propset;
 my $idx = 0;
-for my $key ( sort keys %propset )
+for my $key ( @keys )
 {
   print OUTFILE PropSet::build_prop_string(@{ $propset{$key} });
 
@@ -92,6 +94,32 @@ for my $key ( sort keys %propset )
   $idx++;
 }
 
+print OUTFILE "}};\n";
+print OUTFILE "\n";
+#######################################################################
+print OUTFILE "/**\n";
+print OUTFILE "  The MD5s of the entries above in binary form (as two 64-bit\n";
+print OUTFILE "  halves), in the same order.  This allows searching the\n";
+print OUTFILE "  properties without any string comparisons.\n";
+print OUTFILE "*/\n";
+print OUTFILE "static constexpr BSPF::array2D<uInt64, DEF_PROPS_SIZE, 2> DefPropsMD5 = {{\n";
+
+$idx = 0;
+for my $key ( @keys )
+{
+  my $md5 = lc($key);
+  if ($md5 !~ /^[0-9a-f]{32}$/) {
+    die "Invalid md5 = '$key'\n";
+  }
+  print OUTFILE "  { 0x" . substr($md5, 0, 16) . ", 0x" . substr($md5, 16, 16) . " }";
+
+  if ($idx+1 < $setsize) {
+    print OUTFILE ",";
+  }
+  print OUTFILE "\n";
+  $idx++;
+}
+
 print OUTFILE "}};\n";
 print OUTFILE "\n";
 print OUTFILE "#endif\n";
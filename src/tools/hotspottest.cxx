@@ -0,0 +1,164 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+/**
+  Test for the hotspot traps of the bankswitching schemes, which must route
+  exactly the hotspots of a scheme to the cart's peek() method, while the
+  rest of the hotspot's page is read directly.  Especially reading the 6502
+  vectors at $1FFA - $1FFF must not trigger a bank switch.
+
+  Build and run with 'make check' (after running configure).
+*/
+
+#include "bspf.hxx"
+#include "Base.hxx"
+#include "ConsoleIO.hxx"
+#include "ConsoleTiming.hxx"
+#include "Event.hxx"
+#include "Joystick.hxx"
+#include "M6502.hxx"
+#include "M6532.hxx"
+#include "Props.hxx"
+#include "Random.hxx"
+#include "Settings.hxx"
+#include "Switches.hxx"
+#include "System.hxx"
+#include "TIA.hxx"
+#include "CartBF.hxx"
+#include "CartDF.hxx"
+#include "CartE0.hxx"
+#include "CartEF.hxx"
+#include "CartF0.hxx"
+#include "CartF4.hxx"
+#include "CartF6.hxx"
+#include "CartF8.hxx"
+#include "CartFA.hxx"
+#include "CartFA2.hxx"
+#include "CartFC.hxx"
+
+namespace {
+  // Idle controllers and switches, as required for resetting the system
+  struct IO : public ConsoleIO
+  {
+    Controller& leftController() const override { return *myLeftControl; }
+    Controller& rightController() const override { return *myRightControl; }
+    Switches& switches() const override { return *mySwitches; }
+
+    unique_ptr<Controller> myLeftControl;
+    unique_ptr<Controller> myRightControl;
+    unique_ptr<Switches> mySwitches;
+  };
+
+  // A cart which counts the peeks not handled directly by the system
+  template<class Cart>
+  class TrapCounter : public Cart
+  {
+    public:
+      using Cart::Cart;
+
+      uInt8 peek(uInt16 address) override {
+        ++traps;
+        return Cart::peek(address);
+      }
+
+      uInt32 traps{0};
+  };
+
+  /**
+    Test a scheme, whose hotspots are the given range of addresses.
+
+    @return  True if only the hotspots are trapped, else false
+  */
+  template<class Cart>
+  bool test(string_view name, size_t size, uInt16 first, uInt16 last)
+  {
+    Random random(0);
+    Settings settings;
+    const Event event;
+    const Properties props;
+    IO io;
+    M6502 m6502(settings);
+    M6532 m6532(io, settings);
+    TIA tia(io, [] { return ConsoleTiming::ntsc; }, settings, [](bool) {});
+
+    const ByteBuffer image = make_unique<uInt8[]>(size);
+    TrapCounter<Cart> cart(image, size, string(32, '0'), settings);
+    System system(random, m6502, m6532, tia, cart);
+    io.myLeftControl = make_unique<Joystick>(Controller::Jack::Left, event, system);
+    io.myRightControl = make_unique<Joystick>(Controller::Jack::Right, event, system);
+    io.mySwitches = make_unique<Switches>(event, props, settings);
+
+    tia.bindToControllers();
+    cart.setStartBankFromPropsFunc([] { return -1; });
+    system.initialize();
+    system.reset();
+
+    bool success = true;
+    const auto fail = [&](uInt16 address, string_view error) {
+      cout << name << ": $" << Common::Base::HEX4 << address << ' ' << error
+           << '\n';
+      success = false;
+    };
+
+    // All addresses in the page of the hotspots must be trapped, if and
+    // only if they are hotspots
+    const System::PageAccess& access = system.getPageAccess(first);
+    for(uInt16 address = first & ~System::PAGE_MASK;
+        address < (first & ~System::PAGE_MASK) + System::PAGE_SIZE; ++address)
+    {
+      const bool trapped = (access.peekTraps >> (address & System::PAGE_MASK)) & 1;
+      if(trapped != (address >= first && address <= last))
+        fail(address, trapped ? "is trapped" : "is not trapped");
+    }
+
+    // Reading the vectors must not invoke the cart
+    const uInt16 bank = cart.getBank();
+    for(uInt16 address = 0x1FFA; address <= 0x1FFF; ++address)
+    {
+      if(address >= first && address <= last)
+        continue;
+
+      cart.traps = 0;
+      system.peek(address);
+      if(cart.traps > 0)
+        fail(address, "trap fired");
+      if(cart.getBank() != bank)
+        fail(address, "switched bank");
+    }
+    return success;
+  }
+} // namespace
+
+int main(int, char*[])
+{
+  bool success = true;
+
+  success &= test<CartridgeF8> ("F8",  8_KB,   0x1FF8, 0x1FF9);
+  success &= test<CartridgeF6> ("F6",  16_KB,  0x1FF6, 0x1FF9);
+  success &= test<CartridgeF4> ("F4",  32_KB,  0x1FF4, 0x1FFB);
+  success &= test<CartridgeEF> ("EF",  64_KB,  0x1FE0, 0x1FEF);
+  success &= test<CartridgeDF> ("DF",  128_KB, 0x1FC0, 0x1FDF);
+  success &= test<CartridgeBF> ("BF",  256_KB, 0x1F80, 0x1FBF);
+  success &= test<CartridgeE0> ("E0",  8_KB,   0x1FE0, 0x1FF7);
+  success &= test<CartridgeFA> ("FA",  12_KB,  0x1FF8, 0x1FFA);
+  success &= test<CartridgeFA2>("FA2", 28_KB,  0x1FF4, 0x1FFB);  // incl. flash
+  success &= test<CartridgeF0> ("F0",  64_KB,  0x1FF0, 0x1FF0);
+  success &= test<CartridgeFC> ("FC",  32_KB,  0x1FFC, 0x1FFC);
+
+  cout << (success ? "All hotspot traps passed\n" : "Hotspot traps FAILED\n");
+  return success ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2024 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+/**
+  Benchmark for the ARM emulation, which replays the ARM runs recorded
+  with 'stella -profile -armrecord ...' without the rest of the emulation.
+
+  The first pass verifies the outcome of each run against the recording,
+  the following passes are timed.
+
+  Build with 'make thumbbench' (after running configure).
+*/
+
+#include <chrono>
+#include <iomanip>
+
+#include "bspf.hxx"
+#include "Thumbulator.hxx"
+#include "ThumbRecorder.hxx"
+
+using namespace std::chrono;
+
+int main(int ac, char* av[])
+{
+  if(ac < 2)
+  {
+    cout << av[0] << " <RECORDING> [passes = 10]\n\n"
+         << "  Replay the ARM runs from RECORDING (created by running\n"
+         << "  'stella -profile -armrecord <ROM>'), and report the speed.\n\n";
+    return 0;
+  }
+  const int passes = ac >= 3 ? std::max(BSPF::stoi(av[2]), 1) : 10;
+
+  ThumbRecorder recording;
+  if(!recording.load(av[1]))
+  {
+    cout << "ERROR: " << recording.error() << '\n';
+    return 1;
+  }
+  const size_t runs = recording.runs();
+  cout << runs << " recorded ARM runs\n";
+
+  // Verify
+  for(size_t i = 0; i < runs; ++i)
+    if(!recording.replay(i))
+    {
+      cout << "ERROR: " << recording.error() << '\n';
+      return 1;
+    }
+  const uInt64 instructions = recording.instructions();
+  cout << "verified, " << instructions << " instructions per pass\n";
+
+  // Benchmark
+  double total = 0, best = 0;
+  for(int pass = 0; pass < passes; ++pass)
+  {
+    recording.rewind();
+    const auto start = steady_clock::now();
+    for(size_t i = 0; i < runs; ++i)
+      if(!recording.replay(i, false))
+      {
+        cout << "ERROR: " << recording.error() << '\n';
+        return 1;
+      }
+    const double time = duration_cast<duration<double>>(steady_clock::now() - start).count();
+
+    total += time;
+    if(pass == 0 || time < best)
+      best = time;
+  }
+
+  cout << std::fixed << std::setprecision(3)
+       << "passes:       " << passes << '\n'
+       << "average time: " << total / passes * 1000 << " ms\n"
+       << "best time:    " << best * 1000 << " ms\n"
+       << std::setprecision(1)
+       << "runs/s:       " << runs / best << '\n'
+       << "MIPS:         " << instructions / best / 1000000 << '\n';
+
+  return 0;
+}